@@ -0,0 +1,117 @@
+#include "catch.hpp"
+
+#include <math/Affine.h>
+#include <math/Angle.h>
+#include <math/Transformations.h>
+
+
+using namespace ad::math;
+
+
+template <class T_derived, int N_rows, int N_cols>
+bool approxEqual(const MatrixBase<T_derived, N_rows, N_cols, double> & a,
+                 const MatrixBase<T_derived, N_rows, N_cols, double> & b,
+                 double aMargin = 1E-12)
+{
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(), [aMargin](auto left, auto right)
+            {
+                return Approx(left).margin(aMargin) == right;
+            });
+}
+
+
+#define APPROX_EQUAL(a, b)          \
+    {                               \
+        CAPTURE(a, b);              \
+        REQUIRE(approxEqual(a, b)); \
+    }
+
+
+SCENARIO("Affine transformations")
+{
+    GIVEN("An affine transformation rotating then translating")
+    {
+        const Matrix<3, 3> linear = trans3d::rotateZ(Degree<double>{90.});
+        const Vec<3> translation{10., 20., 30.};
+        const Affine<3> affine{linear, translation};
+
+        THEN("Positions are rotated then translated")
+        {
+            APPROX_EQUAL((Position<3>{1., 0., 0.} * affine), (Position<3>{10., 21., 30.}));
+        }
+
+        THEN("Displacements are only rotated")
+        {
+            APPROX_EQUAL((Vec<3>{1., 0., 0.} * affine), (Vec<3>{0., 1., 0.}));
+        }
+
+        THEN("It is equivalent to its homogeneous matrix")
+        {
+            const Matrix<4, 4> homogeneous = affine.toMatrix();
+            APPROX_EQUAL(homogeneous, (Matrix<4, 4>{
+                 0.,  1.,  0., 0.,
+                -1.,  0.,  0., 0.,
+                 0.,  0.,  1., 0.,
+                10., 20., 30., 1.,
+            }));
+
+            const Position<3> position{3., -2., 5.};
+            const Vec<4> transformed = Vec<4>{3., -2., 5., 1.} * homogeneous;
+            APPROX_EQUAL(position * affine,
+                         (Position<3>{transformed.x(), transformed.y(), transformed.z()}));
+        }
+
+        GIVEN("A second affine transformation, scaling then translating")
+        {
+            const Affine<3> second{
+                Matrix<3, 3>{
+                    2., 0., 0.,
+                    0., 3., 0.,
+                    0., 0., 4.,
+                },
+                Vec<3>{-1., 0., 1.}
+            };
+
+            THEN("Their composition applies the first, then the second")
+            {
+                const Position<3> position{3., -2., 5.};
+                APPROX_EQUAL(position * (affine * second), (position * affine) * second);
+
+                Affine<3> composed = affine;
+                composed *= second;
+                REQUIRE(composed == affine * second);
+            }
+
+            THEN("The composition is equivalent to the product of homogeneous matrices")
+            {
+                APPROX_EQUAL((affine * second).toMatrix(), affine.toMatrix() * second.toMatrix());
+            }
+        }
+
+        THEN("Its inverse reverts it")
+        {
+            const Affine<3> inverse = affine.inverse();
+            const Position<3> position{3., -2., 5.};
+            APPROX_EQUAL(position * affine * inverse, position);
+            APPROX_EQUAL((affine * inverse).linear(), (Matrix<3, 3>::Identity()));
+            APPROX_EQUAL((affine * inverse).translation(), Vec<3>::Zero());
+        }
+    }
+
+    GIVEN("The identity and a translation")
+    {
+        constexpr Affine<2> identity = Affine<2>::Identity();
+        constexpr Affine<2> translation = Affine<2>::Translation({5., -5.});
+
+        THEN("They compose at compile time")
+        {
+            constexpr Affine<2> composed = identity * translation;
+            constexpr Position<2> position = Position<2>{1., 1.} * composed;
+            constexpr Vec<2> displacement = Vec<2>{1., 1.} * composed;
+
+            REQUIRE(composed == translation);
+            REQUIRE(position == (Position<2>{6., -4.}));
+            REQUIRE(displacement == (Vec<2>{1., 1.}));
+        }
+    }
+}
@@ -157,6 +157,35 @@ SCENARIO("Angles conversions and io")
     }
 }
 
+SCENARIO("Angles conversion factors")
+{
+    THEN("Conversion factors are computed in the representation type")
+    {
+        using degree_to_radian = detail::AngleConversion<Degree<float>, Radian<float>>;
+        REQUIRE(std::is_same<decltype(degree_to_radian::factor<float>), const float>::value);
+        REQUIRE(degree_to_radian::factor<float> == pi<float>/180.f);
+    }
+
+    THEN("Conversions are available at compile time")
+    {
+        constexpr Radian<float> half = Degree<float>{180.f}.as<Radian>();
+        static_assert(half.value() == pi<float>, "Converted at compile time");
+        REQUIRE(half.value() == pi<float>);
+    }
+
+    THEN("Conversions between a unit and itself are the identity")
+    {
+        REQUIRE(Radian<float>{1.5f}.as<Radian>().value() == 1.5f);
+        REQUIRE(Degree<int>{-45}.as<Degree>().value() == -45);
+    }
+
+    THEN("Integral conversions involving pi are narrowed")
+    {
+        REQUIRE(Radian<int>{2}.as<Degree>().value() == 114);
+        REQUIRE(Degree<int>{180}.as<Radian>().value() == 3);
+    }
+}
+
 SCENARIO("Angle literals")
 {
     THEN("Literals are available for Radian")
@@ -2,6 +2,12 @@
 
 #include <math/Barycentric.h>
 
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <cmath>
+
 using namespace ad::math;
 
 
@@ -31,6 +37,278 @@ SCENARIO("Computing barycentric coordinates")
             REQUIRE(barycentric.getCoordinates({2., 2.})
                     == ad::math::Barycentric<double>::Coordinates{-1., 1., 1.});
         }
+
+        THEN("Coordinates can be stepped along X and Y")
+        {
+            using Coordinates = Barycentric<double>::Coordinates;
+
+            REQUIRE(barycentric.getStepX(1.) == Coordinates{-0.5, 0., 0.5});
+            REQUIRE(barycentric.getStepY(0.5) == Coordinates{-0.25, 0.25, 0.});
+
+            Coordinates coordinates = barycentric.getCoordinates({0., 0.});
+            coordinates += barycentric.getStepX(0.5);
+            coordinates += barycentric.getStepY(0.5);
+            REQUIRE(coordinates == barycentric.getCoordinates({.5, .5}));
+            REQUIRE(coordinates + barycentric.getStepX(1.5) + barycentric.getStepY(1.5)
+                    == barycentric.getCoordinates({2., 2.}));
+        }
+    }
+
+    GIVEN("A barycentric based on an arbitrary triangle")
+    {
+        auto barycentric = Barycentric<float>( {-3.2f, 1.1f}, {4.5f, -2.3f}, {0.7f, 6.9f} );
+
+        THEN("Coordinates of a row match the coordinates of each point")
+        {
+            const std::size_t count = 37;
+            const Vec<2, float> start{-5.f, 2.5f};
+            const float step = 0.3f;
+            std::vector<float> alpha(count), beta(count), gamma(count);
+            barycentric.getCoordinatesRow(start, step, count, alpha.data(), beta.data(), gamma.data());
+
+            for (std::size_t index = 0; index != count; ++index)
+            {
+                auto expected = barycentric.getCoordinates(start + Vec<2, float>{index * step, 0.f});
+                REQUIRE(alpha[index] == Approx(expected.alpha).margin(1e-5));
+                REQUIRE(beta[index] == Approx(expected.beta).margin(1e-5));
+                REQUIRE(gamma[index] == Approx(expected.gamma).margin(1e-5));
+            }
+        }
     }
 }
 
+
+
+
+SCENARIO("Computing barycentric coordinates in 3D")
+{
+    GIVEN("A triangle in 3D")
+    {
+        const Vec<3, double> a{1., 2., 3.};
+        const Vec<3, double> b{4., -1., 2.};
+        const Vec<3, double> c{-2., 0., 5.};
+        TriangleBarycentric<double> barycentric{a, b, c};
+
+        THEN("The vertices have unit coordinates")
+        {
+            auto coordinates = barycentric.getCoordinates(b);
+            REQUIRE(coordinates.alpha == Approx(0.).margin(1e-12));
+            REQUIRE(coordinates.beta == Approx(1.));
+            REQUIRE(coordinates.gamma == Approx(0.).margin(1e-12));
+        }
+
+        THEN("Points off the plane have the coordinates of their projection")
+        {
+            const Vec<3, double> normal = (b - a).cross(c - a);
+            const Vec<3, double> point = a * 0.2 + b * 0.5 + c * 0.3;
+            auto coordinates = barycentric.getCoordinates(point + normal * 1.7);
+            REQUIRE(coordinates.alpha == Approx(0.2));
+            REQUIRE(coordinates.beta == Approx(0.5));
+            REQUIRE(coordinates.gamma == Approx(0.3));
+        }
+
+        THEN("Batch coordinates match single queries")
+        {
+            // Several blocks, and a partial one
+            std::vector<double> x, y, z;
+            for (std::size_t index = 0; index != 600; ++index)
+            {
+                x.push_back(std::cos(0.1 * index) * 4.);
+                y.push_back(std::sin(0.3 * index) * 3.);
+                z.push_back(0.01 * index - 2.);
+            }
+            std::vector<double> alpha(x.size()), beta(x.size()), gamma(x.size());
+            barycentric.getCoordinates(x.data(), y.data(), z.data(), x.size(),
+                                       alpha.data(), beta.data(), gamma.data());
+            for (std::size_t index = 0; index != x.size(); ++index)
+            {
+                auto expected = barycentric.getCoordinates({x[index], y[index], z[index]});
+                REQUIRE(alpha[index] == Approx(expected.alpha));
+                REQUIRE(beta[index] == Approx(expected.beta));
+                REQUIRE(gamma[index] == Approx(expected.gamma));
+            }
+        }
+    }
+
+    GIVEN("A tetrahedron")
+    {
+        const Vec<3, float> a{0.f, 0.f, 0.f};
+        const Vec<3, float> b{2.f, 0.f, 0.f};
+        const Vec<3, float> c{0.f, 4.f, 0.f};
+        const Vec<3, float> d{1.f, 1.f, 3.f};
+        TetrahedronBarycentric<float> barycentric{a, b, c, d};
+
+        THEN("Coordinates reconstruct the point")
+        {
+            const Vec<3, float> point{0.7f, 1.1f, 0.9f};
+            auto coordinates = barycentric.getCoordinates(point);
+            const Vec<3, float> reconstructed =
+                a * coordinates.alpha + b * coordinates.beta + c * coordinates.gamma + d * coordinates.delta;
+            REQUIRE(reconstructed.x() == Approx(point.x()));
+            REQUIRE(reconstructed.y() == Approx(point.y()));
+            REQUIRE(reconstructed.z() == Approx(point.z()));
+            REQUIRE(coordinates.alpha + coordinates.beta + coordinates.gamma + coordinates.delta == Approx(1.f));
+        }
+
+        THEN("The vertices have unit coordinates")
+        {
+            auto coordinates = barycentric.getCoordinates(d);
+            REQUIRE(coordinates.alpha == Approx(0.f).margin(1e-6));
+            REQUIRE(coordinates.beta == Approx(0.f).margin(1e-6));
+            REQUIRE(coordinates.gamma == Approx(0.f).margin(1e-6));
+            REQUIRE(coordinates.delta == Approx(1.f));
+        }
+
+        THEN("Batch coordinates match single queries")
+        {
+            // Several blocks, and a partial one
+            std::vector<float> x, y, z;
+            for (std::size_t index = 0; index != 600; ++index)
+            {
+                x.push_back(std::cos(0.1f * index) * 4.f);
+                y.push_back(std::sin(0.3f * index) * 3.f);
+                z.push_back(0.01f * index - 2.f);
+            }
+            std::vector<float> alpha(x.size()), beta(x.size()), gamma(x.size()), delta(x.size());
+            barycentric.getCoordinates(x.data(), y.data(), z.data(), x.size(),
+                                       alpha.data(), beta.data(), gamma.data(), delta.data());
+            for (std::size_t index = 0; index != x.size(); ++index)
+            {
+                auto expected = barycentric.getCoordinates({x[index], y[index], z[index]});
+                REQUIRE(alpha[index] == Approx(expected.alpha));
+                REQUIRE(beta[index] == Approx(expected.beta));
+                REQUIRE(gamma[index] == Approx(expected.gamma));
+                REQUIRE(delta[index] == Approx(expected.delta));
+            }
+        }
+    }
+}
+
+SCENARIO("Computing fixed point barycentric coordinates")
+{
+    using Fixed = FixedBarycentric<4>;
+    using Point = Vec<2, Fixed::fixed_type>;
+
+    GIVEN("A fixed point barycentric based on a 2D triangle")
+    {
+        // (0, 0), (0, 2), (2, 0) in units
+        Fixed barycentric{ {0, 0}, {0, 32}, {32, 0} };
+
+        THEN("Its weights are exact and sum to twice its area")
+        {
+            REQUIRE(barycentric.getDoubleArea() == 32 * 32);
+            REQUIRE(barycentric.getWeights({0, 0}) == Fixed::Weights{1024, 0, 0});
+            REQUIRE(barycentric.getWeights({16, 16}) == Fixed::Weights{0, 512, 512});
+            REQUIRE(barycentric.getWeights({8, 8}) == Fixed::Weights{512, 256, 256});
+
+            auto weights = barycentric.getWeights({-7, 45});
+            REQUIRE(weights.alpha + weights.beta + weights.gamma == barycentric.getDoubleArea());
+            REQUIRE(weights + barycentric.getStepX(3) + barycentric.getStepY(-2) == barycentric.getWeights({-4, 43}));
+        }
+
+        THEN("Its normalized coordinates match the floating point barycentric")
+        {
+            REQUIRE(barycentric.getCoordinates<double>(barycentric.getWeights({8, 8}))
+                    == Barycentric<double>::Coordinates{0.5, 0.25, 0.25});
+        }
+
+        THEN("The winding of the triangle does not change the weights")
+        {
+            Fixed clockwise{ {0, 0}, {32, 0}, {0, 32} };
+            REQUIRE(clockwise.getDoubleArea() == barycentric.getDoubleArea());
+            REQUIRE(clockwise.getWeights({8, 4}) == Fixed::Weights{640, 256, 128});
+        }
+
+        THEN("Points on the edges are covered following the top-left rule")
+        {
+            // Left edge from (0, 0) to (0, 32)
+            REQUIRE(barycentric.isCovered(barycentric.getWeights({0, 10})));
+            // Top edge from (0, 0) to (32, 0)
+            REQUIRE(barycentric.isCovered(barycentric.getWeights({10, 0})));
+            // Diagonal edge, on the bottom right
+            REQUIRE_FALSE(barycentric.isCovered(barycentric.getWeights({16, 16})));
+            REQUIRE(barycentric.isCovered(barycentric.getWeights({15, 16})));
+            REQUIRE_FALSE(barycentric.isCovered(barycentric.getWeights({-1, 10})));
+        }
+
+        THEN("The fixed point conversion rounds to the closest value")
+        {
+            REQUIRE(Fixed::toFixed(1.5) == 24);
+            REQUIRE(Fixed::toFixed(-0.52f) == -8);
+        }
+    }
+
+    GIVEN("A mesh of triangles sharing edges")
+    {
+        // Grid of jittered vertices, each quad split in two triangles
+        const int size = 6;
+        const Fixed::fixed_type spacing = 5 * Fixed::gOne;
+        std::mt19937 engine{17};
+        std::uniform_int_distribution<Fixed::fixed_type> jitter{-spacing / 3, spacing / 3};
+        std::vector<Point> vertices;
+        for (int y = 0; y <= size; ++y)
+        {
+            for (int x = 0; x <= size; ++x)
+            {
+                const bool border = (x == 0 || y == 0 || x == size || y == size);
+                vertices.push_back({x * spacing + (border ? 0 : jitter(engine)),
+                                    y * spacing + (border ? 0 : jitter(engine))});
+            }
+        }
+        std::vector<Fixed> triangles;
+        for (int y = 0; y != size; ++y)
+        {
+            for (int x = 0; x != size; ++x)
+            {
+                const Point & topLeft = vertices[y * (size + 1) + x];
+                const Point & topRight = vertices[y * (size + 1) + x + 1];
+                const Point & bottomLeft = vertices[(y + 1) * (size + 1) + x];
+                const Point & bottomRight = vertices[(y + 1) * (size + 1) + x + 1];
+                // Alternating diagonals and windings
+                if ((x + y) % 2 == 0)
+                {
+                    triangles.emplace_back(topLeft, topRight, bottomRight);
+                    triangles.emplace_back(topLeft, bottomLeft, bottomRight);
+                }
+                else
+                {
+                    triangles.emplace_back(topRight, topLeft, bottomLeft);
+                    triangles.emplace_back(topRight, bottomRight, bottomLeft);
+                }
+            }
+        }
+
+        THEN("Each point inside the mesh is covered exactly once")
+        {
+            // Every fixed point position, so many points lie exactly on the edges and vertices
+            const Fixed::fixed_type extent = size * spacing;
+            for (Fixed::fixed_type y = 0; y != extent; ++y)
+            {
+                std::vector<int> coverage(extent, 0);
+                for (const Fixed & triangle : triangles)
+                {
+                    std::vector<std::uint64_t> row(bitmaskWordCount(extent));
+                    triangle.getCoverageRow({0, y}, 1, extent, row.data());
+                    for (Fixed::fixed_type x = 0; x != extent; ++x)
+                    {
+                        coverage[x] += testBit(row.data(), x);
+                    }
+                }
+                REQUIRE(std::count(coverage.begin(), coverage.end(), 1) == extent);
+            }
+        }
+
+        THEN("Row coverage matches the coverage of each point")
+        {
+            const Fixed & triangle = triangles[7];
+            const std::size_t count = 150;
+            std::vector<std::uint64_t> row(bitmaskWordCount(count));
+            triangle.getCoverageRow({-3, 40}, 2, count, row.data());
+            for (std::size_t index = 0; index != count; ++index)
+            {
+                const Point point{static_cast<Fixed::fixed_type>(-3 + 2 * index), 40};
+                REQUIRE(testBit(row.data(), index) == triangle.isCovered(triangle.getWeights(point)));
+            }
+        }
+    }
+}
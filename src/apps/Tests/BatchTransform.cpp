@@ -0,0 +1,123 @@
+#include "catch.hpp"
+
+#include <math/BatchTransform.h>
+#include <math/Transformations.h>
+
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+
+using namespace ad::math;
+
+
+SCENARIO("Batch transformation of positions")
+{
+    GIVEN("Interleaved positions and an affine transformation")
+    {
+        const Affine<3> transform{trans3d::rotateY(Degree<double>{30.}) * trans3d::scale(2., 1., 0.5),
+                                  Vec<3>{1., -2., 3.}};
+
+        const std::size_t count = 1001;
+        std::vector<double> positions;
+        for (std::size_t index = 0; index != count; ++index)
+        {
+            positions.push_back(1. * index);
+            positions.push_back(-0.5 * index);
+            positions.push_back(3. - index);
+        }
+
+        auto requireTransformed = [&](const std::vector<double> & aResult)
+        {
+            for (std::size_t index = 0; index != count; ++index)
+            {
+                const Position<3> expected =
+                    Position<3>{positions[3*index], positions[3*index + 1], positions[3*index + 2]} * transform;
+                for (std::size_t coordinate = 0; coordinate != 3; ++coordinate)
+                {
+                    REQUIRE(aResult[3*index + coordinate] == Approx(expected[coordinate]));
+                }
+            }
+        };
+
+        THEN("Each position is transformed as by Position * Affine")
+        {
+            std::vector<double> result(positions.size());
+            transformPositions(positions.data(), count, transform, result.data());
+            requireTransformed(result);
+        }
+
+        THEN("The positions can be transformed in place, on several threads")
+        {
+            std::vector<double> result = positions;
+            transformPositions(result.data(), count, transform, result.data(), 3);
+            requireTransformed(result);
+        }
+
+        GIVEN("A file containing the positions")
+        {
+            const std::filesystem::path directory = std::filesystem::temp_directory_path();
+            const std::string input = (directory / "ad_math_batch_transform_input.bin").string();
+            const std::string output = (directory / "ad_math_batch_transform_output.bin").string();
+            {
+                std::ofstream file{input, std::ios::binary};
+                file.write(reinterpret_cast<const char *>(positions.data()), positions.size() * sizeof(double));
+            }
+
+            WHEN("It is transformed to another file")
+            {
+                const TransformStatistics statistics = transformPositionFile(input, output, transform, 2);
+
+                THEN("The output file contains the transformed positions")
+                {
+                    REQUIRE(statistics.pointCount == count);
+                    REQUIRE(statistics.byteCount == positions.size() * sizeof(double));
+
+                    std::vector<double> result(positions.size());
+                    std::ifstream file{output, std::ios::binary};
+                    file.read(reinterpret_cast<char *>(result.data()), result.size() * sizeof(double));
+                    REQUIRE(file.gcount() == static_cast<std::streamsize>(statistics.byteCount));
+                    requireTransformed(result);
+                }
+            }
+
+            WHEN("It is transformed to the same file, named differently")
+            {
+                const std::string sameInput = (directory / "." / "ad_math_batch_transform_input.bin").string();
+                const TransformStatistics statistics = transformPositionFile(input, sameInput, transform, 2);
+
+                THEN("The file is transformed in place")
+                {
+                    REQUIRE(statistics.pointCount == count);
+
+                    std::vector<double> result(positions.size());
+                    std::ifstream file{input, std::ios::binary};
+                    file.read(reinterpret_cast<char *>(result.data()), result.size() * sizeof(double));
+                    REQUIRE(file.gcount() == static_cast<std::streamsize>(statistics.byteCount));
+                    requireTransformed(result);
+                }
+            }
+
+            WHEN("The file is truncated")
+            {
+                std::filesystem::resize_file(input, 5 * sizeof(double));
+
+                THEN("Transforming it is an error")
+                {
+                    REQUIRE_THROWS_AS(transformPositionFile(input, output, transform), std::runtime_error);
+                }
+            }
+
+            std::filesystem::remove(input);
+            std::filesystem::remove(output);
+        }
+
+        THEN("Transforming a missing file is an error")
+        {
+            REQUIRE_THROWS_AS(transformPositionFile(std::string{"/non/existing/file.bin"},
+                                                    std::string{"/non/existing/output.bin"},
+                                                    transform),
+                              std::system_error);
+        }
+    }
+}
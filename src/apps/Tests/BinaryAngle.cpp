@@ -0,0 +1,146 @@
+#include "catch.hpp"
+
+#include <math/BinaryAngle.h>
+#include <math/Constants.h>
+
+#include <sstream>
+#include <vector>
+
+
+using namespace ad::math;
+
+
+SCENARIO("Binary angles arithmetic")
+{
+    GIVEN("16 bits binary angles")
+    {
+        BinaryAngle<std::uint16_t> threeQuarters{0xC000};
+        BinaryAngle<std::uint16_t> half{0x8000};
+
+        THEN("Addition wraps around the full turn")
+        {
+            REQUIRE((threeQuarters + half).value() == 0x4000);
+        }
+
+        THEN("Subtraction wraps around the full turn")
+        {
+            REQUIRE((half - threeQuarters).value() == 0xC000);
+        }
+
+        THEN("Negation is the complement to a full turn")
+        {
+            REQUIRE((-threeQuarters).value() == 0x4000);
+            REQUIRE(-half == half);
+        }
+
+        THEN("They can be output to formatted stream")
+        {
+            std::ostringstream oss;
+            oss << half;
+            REQUIRE(oss.str() == "32768 bam");
+        }
+    }
+}
+
+
+SCENARIO("Binary angles conversions")
+{
+    GIVEN("A 16 bits binary angle")
+    {
+        BinaryAngle<std::uint16_t> quarter{0x4000};
+
+        THEN("It can be converted to floating point radians and degrees")
+        {
+            REQUIRE(quarter.as<Radian, float>().value() == pi<float>/2);
+            REQUIRE(quarter.as<Degree, double>().value() == 90.);
+        }
+
+        THEN("It can be converted to another binary precision exactly")
+        {
+            REQUIRE(quarter.as<BinaryAngle, std::uint32_t>().value() == 0x40000000u);
+            REQUIRE(BinaryAngle<std::uint32_t>{0x40000000u}.as<BinaryAngle, std::uint16_t>() == quarter);
+        }
+    }
+
+    GIVEN("Angles in other units")
+    {
+        THEN("They can be converted to binary angles, wrapping around")
+        {
+            REQUIRE(Degree<double>{90.}.as<BinaryAngle, std::uint16_t>().value() == 0x4000);
+            REQUIRE(Degree<double>{-90.}.as<BinaryAngle, std::uint16_t>().value() == 0xC000);
+            REQUIRE(Degree<double>{450.}.as<BinaryAngle, std::uint16_t>().value() == 0x4000);
+            REQUIRE(Radian<double>{pi<double>}.as<BinaryAngle, std::uint32_t>().value() == 0x80000000u);
+        }
+
+        THEN("Integral degrees are converted exactly")
+        {
+            REQUIRE(Degree<int>{45}.as<BinaryAngle, std::uint16_t>().value() == 0x2000);
+            REQUIRE(Degree<int>{-45}.as<BinaryAngle, std::uint16_t>().value() == 0xE000);
+            REQUIRE(BinaryAngle<std::uint16_t>{0x2000}.as<Degree, int>().value() == 45);
+        }
+    }
+}
+
+
+SCENARIO("Binary angles trigonometry")
+{
+    GIVEN("Binary angles covering a full turn")
+    {
+        std::vector<BinaryAngle<std::uint16_t>> angles;
+        for (std::uint32_t value = 0; value <= 0xFFFF; value += 7)
+        {
+            angles.emplace_back(static_cast<std::uint16_t>(value));
+        }
+
+        auto check = [&](auto aSin, auto aCos, double aMargin)
+        {
+            for (auto angle : angles)
+            {
+                CAPTURE(angle);
+                const double radians = angle.as<Radian, double>().value();
+                REQUIRE(aSin(angle) == Approx(std::sin(radians)).margin(aMargin));
+                REQUIRE(aCos(angle) == Approx(std::cos(radians)).margin(aMargin));
+            }
+        };
+
+        THEN("The default sin and cos interpolate a lookup table")
+        {
+            check([](auto angle){ return sin(angle); },
+                  [](auto angle){ return cos(angle); },
+                  5E-6);
+        }
+
+        THEN("The table can be configured without interpolation")
+        {
+            SineTable<double, 12, false> table;
+            check([&](auto angle){ return table.sin(angle); },
+                  [&](auto angle){ return table.cos(angle); },
+                  pi<double> / 4096);
+        }
+
+        THEN("Batch lookups match the individual ones")
+        {
+            const SineTable<> & table = SineTable<>::Get();
+            std::vector<float> sines(angles.size());
+            std::vector<float> cosines(angles.size());
+            table.sin(angles.data(), angles.size(), sines.data());
+            table.cos(angles.data(), angles.size(), cosines.data());
+
+            for (std::size_t index = 0; index != angles.size(); ++index)
+            {
+                REQUIRE(sines[index] == sin(angles[index]));
+                REQUIRE(cosines[index] == cos(angles[index]));
+            }
+        }
+    }
+
+    GIVEN("32 bits binary angles")
+    {
+        THEN("Their sine and cosine are looked up with the high bits")
+        {
+            REQUIRE(sin(BinaryAngle<std::uint32_t>{0x40000000u}) == 1.f);
+            REQUIRE(cos(BinaryAngle<std::uint32_t>{0x80000000u}) == -1.f);
+            REQUIRE(sin(BinaryAngle<std::uint32_t>{0x15555555u}) == Approx(0.5).margin(5E-6));
+        }
+    }
+}
@@ -0,0 +1,250 @@
+#include "catch.hpp"
+
+#include <math/BoundingVolumeHierarchy.h>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+
+using namespace ad::math;
+
+
+namespace {
+
+    std::vector<Box<3, float>> randomBoxes(std::size_t aCount, std::mt19937 & aEngine)
+    {
+        std::uniform_real_distribution<float> position{-100.f, 100.f};
+        std::uniform_real_distribution<float> extent{0.f, 5.f};
+        std::vector<Box<3, float>> result;
+        for (std::size_t index = 0; index != aCount; ++index)
+        {
+            result.push_back(Box<3, float>::FromOriginSize({position(aEngine), position(aEngine), position(aEngine)},
+                                                           {extent(aEngine), extent(aEngine), extent(aEngine)}));
+        }
+        return result;
+    }
+
+    std::vector<std::uint32_t> queryBox(const BoundingVolumeHierarchy<3, float> & aBvh, const Box<3, float> & aQuery)
+    {
+        std::vector<std::uint32_t> result;
+        aBvh.queryBox(aQuery, [&result](std::uint32_t aPrimitive){ result.push_back(aPrimitive); });
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+} // anonymous namespace
+
+
+SCENARIO("Bounding volume hierarchy construction")
+{
+    GIVEN("A few boxes along the X axis")
+    {
+        std::vector<Box<3>> boxes;
+        for (int index = 0; index != 10; ++index)
+        {
+            boxes.push_back(Box<3>::FromOriginSize({10. * index, 0., 0.}, {1., 1., 1.}));
+        }
+        BoundingVolumeHierarchy<3> bvh{boxes.data(), boxes.size(), 1, 2};
+
+        THEN("The root bounds all boxes, and leaves respect the maximum size")
+        {
+            const auto & nodes = bvh.getNodes();
+            REQUIRE(bvh.size() == 10);
+            REQUIRE(nodes.front().bounds == (Box<3>{{0., 0., 0.}, {91., 1., 1.}}));
+            std::size_t primitiveCount = 0;
+            for (const auto & node : nodes)
+            {
+                if (node.isLeaf())
+                {
+                    REQUIRE(node.count <= 2);
+                    primitiveCount += node.count;
+                }
+                else
+                {
+                    REQUIRE(node.axis == 0);
+                    REQUIRE(node.bounds.contains(nodes[&node - nodes.data() + 1].bounds));
+                    REQUIRE(node.bounds.contains(nodes[node.offset].bounds));
+                }
+            }
+            REQUIRE(primitiveCount == 10);
+        }
+
+        THEN("A ray along X hits the closest box")
+        {
+            const auto hit = bvh.intersectRay({35., 0.5, 0.5}, {1., 0., 0.});
+            REQUIRE(hit);
+            REQUIRE(hit->primitive == 4);
+            REQUIRE(hit->distance == 5.);
+
+            const auto backward = bvh.intersectRay({35., 0.5, 0.5}, {-1., 0., 0.});
+            REQUIRE(backward->primitive == 3);
+            REQUIRE(backward->distance == 4.);
+
+            REQUIRE_FALSE(bvh.intersectRay({35., 0.5, 0.5}, {1., 0., 0.}, 4.));
+            REQUIRE_FALSE(bvh.intersectRay({35., 5., 0.5}, {1., 0., 0.}));
+        }
+
+        THEN("The closest box to a position is found")
+        {
+            const auto nearest = bvh.findClosest({58., 3., 0.5});
+            REQUIRE(nearest);
+            REQUIRE(nearest->primitive == 6);
+            REQUIRE(nearest->squaredDistance == 8.);
+            REQUIRE_FALSE(bvh.findClosest({58., 3., 0.5}, 2.));
+        }
+
+        WHEN("The boxes move and the hierarchy is refit")
+        {
+            for (Box<3> & box : boxes)
+            {
+                box.mMin[1] += 10.;
+                box.mMax[1] += 10.;
+            }
+            bvh.refit(boxes.data());
+
+            THEN("Queries use the new bounds")
+            {
+                REQUIRE(bvh.getNodes().front().bounds == (Box<3>{{0., 10., 0.}, {91., 11., 1.}}));
+                REQUIRE_FALSE(bvh.intersectRay({35., 0.5, 0.5}, {1., 0., 0.}));
+                REQUIRE(bvh.intersectRay({35., 10.5, 0.5}, {1., 0., 0.})->primitive == 4);
+            }
+        }
+    }
+
+    GIVEN("Points only apart by denormal distances")
+    {
+        std::vector<Box<3>> boxes;
+        for (int index = 0; index != 4; ++index)
+        {
+            const double offset = index * std::numeric_limits<double>::denorm_min();
+            boxes.push_back(Box<3>::FromOriginSize({offset, 0., 0.}, {0., 0., 0.}));
+        }
+        BoundingVolumeHierarchy<3> bvh{boxes.data(), boxes.size(), 1, 4};
+
+        THEN("They are gathered in a single leaf")
+        {
+            REQUIRE(bvh.getNodes().size() == 1);
+            REQUIRE(bvh.getNodes().front().isLeaf());
+            REQUIRE(bvh.getNodes().front().count == 4);
+        }
+    }
+
+    GIVEN("An empty hierarchy")
+    {
+        BoundingVolumeHierarchy<2> bvh{nullptr, 0};
+
+        THEN("Queries find nothing")
+        {
+            REQUIRE_FALSE(bvh.intersectRay({0., 0.}, {1., 0.}));
+            REQUIRE_FALSE(bvh.findClosest({0., 0.}));
+        }
+    }
+}
+
+
+SCENARIO("Bounding volume hierarchy queries match exhaustive tests")
+{
+    std::mt19937 engine{11};
+    // More primitives than the threshold for parallel binning of the top nodes
+    const std::vector<Box<3, float>> boxes = randomBoxes(100000, engine);
+
+    GIVEN("A hierarchy built by a single thread, or several")
+    {
+        const std::size_t threadCount = GENERATE(1, 4);
+        BoundingVolumeHierarchy<3, float> bvh{boxes.data(), boxes.size(), threadCount};
+        std::uniform_real_distribution<float> coordinate{-120.f, 120.f};
+
+        THEN("Box queries return the intersecting primitives")
+        {
+            for (int query = 0; query != 20; ++query)
+            {
+                const Position<3, float> corner{coordinate(engine), coordinate(engine), coordinate(engine)};
+                const Box<3, float> region = Box<3, float>::FromOriginSize(corner, {20.f, 20.f, 20.f});
+                std::vector<std::uint32_t> expected;
+                for (std::uint32_t index = 0; index != boxes.size(); ++index)
+                {
+                    if (boxes[index].intersects(region))
+                    {
+                        expected.push_back(index);
+                    }
+                }
+                REQUIRE(queryBox(bvh, region) == expected);
+            }
+        }
+
+        THEN("Rays hit the closest primitive")
+        {
+            for (int query = 0; query != 20; ++query)
+            {
+                const Position<3, float> origin{coordinate(engine), coordinate(engine), coordinate(engine)};
+                const Vec<3, float> direction{coordinate(engine), coordinate(engine), coordinate(engine)};
+                const Vec<3, float> inverseDirection{1.f / direction.x(), 1.f / direction.y(), 1.f / direction.z()};
+                float expected = std::numeric_limits<float>::infinity();
+                for (const Box<3, float> & box : boxes)
+                {
+                    expected = std::min(expected,
+                                        box.intersectRay(origin, inverseDirection)
+                                            .value_or(std::numeric_limits<float>::infinity()));
+                }
+
+                const auto hit = bvh.intersectRay(origin, direction);
+                REQUIRE(hit.has_value() == (expected != std::numeric_limits<float>::infinity()));
+                if (hit)
+                {
+                    REQUIRE(hit->distance == expected);
+                    REQUIRE(boxes[hit->primitive].intersectRay(origin, inverseDirection) == expected);
+                }
+            }
+        }
+
+        THEN("Closest point queries return the closest primitive")
+        {
+            for (int query = 0; query != 20; ++query)
+            {
+                const Position<3, float> position{coordinate(engine), coordinate(engine), coordinate(engine)};
+                float expected = std::numeric_limits<float>::infinity();
+                for (const Box<3, float> & box : boxes)
+                {
+                    expected = std::min(expected, box.squaredDistance(position));
+                }
+
+                const auto nearest = bvh.findClosest(position);
+                REQUIRE(nearest);
+                REQUIRE(nearest->squaredDistance == expected);
+            }
+        }
+
+        THEN("Custom primitive tests are used for rays and distances")
+        {
+            // Spheres inscribed in the boxes, tested through their centers only
+            const Position<3, float> origin{-150.f, 0.f, 0.f};
+            const auto hit = bvh.intersectRay(origin, {1.f, 0.f, 0.f}, std::numeric_limits<float>::infinity(),
+                [&](std::uint32_t aPrimitive, float aMaxDistance) -> std::optional<float>
+                {
+                    const Position<3, float> center = boxes[aPrimitive].center();
+                    const float distance = center.x() - origin.x();
+                    if (center.y() == 0.f && center.z() == 0.f && distance <= aMaxDistance)
+                    {
+                        return distance;
+                    }
+                    return std::nullopt;
+                });
+            REQUIRE_FALSE(hit);
+
+            const Position<3, float> position{1.f, 2.f, 3.f};
+            const auto nearest = bvh.findClosest(position, std::numeric_limits<float>::infinity(),
+                [&](std::uint32_t aPrimitive, const Position<3, float> & aPosition)
+                {
+                    return (boxes[aPrimitive].max() - aPosition).getNormSquared();
+                });
+            float expected = std::numeric_limits<float>::infinity();
+            for (const Box<3, float> & box : boxes)
+            {
+                expected = std::min(expected, (box.max() - position).getNormSquared());
+            }
+            REQUIRE(nearest->squaredDistance == expected);
+        }
+    }
+}
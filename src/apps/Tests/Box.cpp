@@ -0,0 +1,184 @@
+#include "catch.hpp"
+
+#include <math/Box.h>
+
+#include <vector>
+
+
+using namespace ad::math;
+
+
+SCENARIO("Box usage")
+{
+    GIVEN("A 3D box")
+    {
+        const Box<3> box = Box<3>::FromOriginSize({1., 2., 3.}, {4., 5., 6.});
+
+        THEN("Its bounds, size, center and volume are available")
+        {
+            REQUIRE(box.min() == Position<3>{1., 2., 3.});
+            REQUIRE(box.max() == Position<3>{5., 7., 9.});
+            REQUIRE(box.max(1) == 7.);
+            REQUIRE(box.size() == Size<3>{4., 5., 6.});
+            REQUIRE(box.center() == Position<3>{3., 4.5, 6.});
+            REQUIRE(box.volume() == 120.);
+            REQUIRE_FALSE(box.isEmpty());
+        }
+
+        THEN("It contains positions within its bounds, inclusive")
+        {
+            REQUIRE(box.contains(Position<3>{1., 2., 3.}));
+            REQUIRE(box.contains(Position<3>{3., 7., 4.}));
+            REQUIRE_FALSE(box.contains(Position<3>{0., 3., 4.}));
+            REQUIRE_FALSE(box.contains(Position<3>{3., 3., 9.5}));
+        }
+
+        GIVEN("An overlapping box")
+        {
+            const Box<3> other{{4., 0., 0.}, {10., 3., 4.}};
+
+            THEN("They intersect")
+            {
+                REQUIRE(box.intersects(other));
+                REQUIRE(other.intersects(box));
+                REQUIRE(box.intersect(other) == (Box<3>{{4., 2., 3.}, {5., 3., 4.}}));
+            }
+
+            THEN("Their union contains both")
+            {
+                const Box<3> united = box.unite(other);
+                REQUIRE(united == (Box<3>{{1., 0., 0.}, {10., 7., 9.}}));
+                REQUIRE(united.contains(box));
+                REQUIRE(united.contains(other));
+            }
+        }
+
+        GIVEN("A disjoint box")
+        {
+            const Box<3> other{{6., 0., 0.}, {10., 3., 4.}};
+
+            THEN("They do not intersect, and their intersection is empty")
+            {
+                REQUIRE_FALSE(box.intersects(other));
+                REQUIRE(box.intersect(other).isEmpty());
+                REQUIRE(box.intersect(other).volume() == 0.);
+            }
+        }
+
+        THEN("Its distance to outside positions is the distance to the closest point")
+        {
+            REQUIRE(box.distance({3., 4., 6.}) == 0.);
+            REQUIRE(box.closestPoint({8., 4., 13.}) == Position<3>{5., 4., 9.});
+            REQUIRE(box.distance({8., 4., 13.}) == Approx(5.));
+        }
+
+        THEN("Rays can be tested against it")
+        {
+            // Along X, entering through the min X face
+            auto entry = box.intersectRay({-1., 4., 5.}, {1., std::numeric_limits<double>::infinity(),
+                                                          std::numeric_limits<double>::infinity()});
+            REQUIRE(entry);
+            REQUIRE(*entry == Approx(2.));
+
+            // Starting inside
+            REQUIRE(*box.intersectRay({2., 3., 4.}, {1., 1., 1.}) == 0.);
+
+            // Pointing away, or too short
+            REQUIRE_FALSE(box.intersectRay({-1., 4., 5.}, {-1., std::numeric_limits<double>::infinity(),
+                                                            std::numeric_limits<double>::infinity()}));
+            REQUIRE_FALSE(box.intersectRay({-1., 4., 5.}, {1., std::numeric_limits<double>::infinity(),
+                                                           std::numeric_limits<double>::infinity()}, 1.5));
+        }
+    }
+
+    GIVEN("The empty box")
+    {
+        Box<2, int> box = Box<2, int>::Empty();
+
+        THEN("It is empty")
+        {
+            REQUIRE(box.isEmpty());
+            REQUIRE(box.volume() == 0);
+        }
+
+        THEN("Expanding it to positions makes their bounding box")
+        {
+            box.expand({3, 4}).expand({-1, 6}).expand({2, 2});
+            REQUIRE(box == (Box<2, int>{{-1, 2}, {3, 6}}));
+        }
+    }
+
+    GIVEN("A rectangle")
+    {
+        const Rectangle<double> rectangle{ {1., 2.}, {3., 4.} };
+
+        THEN("It converts to and from a 2D box")
+        {
+            const Box<2> box{rectangle};
+            REQUIRE(box == (Box<2>{{1., 2.}, {4., 6.}}));
+            REQUIRE(box.toRectangle() == rectangle);
+        }
+    }
+}
+
+
+SCENARIO("Box batch operations")
+{
+    GIVEN("Boxes stored as a structure of arrays")
+    {
+        const std::size_t count = 90;
+        std::vector<Box<2>> boxes;
+        std::vector<double> minX, minY, maxX, maxY;
+        for (std::size_t index = 0; index != count; ++index)
+        {
+            const double x = (index % 10) * 2.;
+            const double y = (index / 10) * 2.;
+            boxes.push_back({{x, y}, {x + 1. + (index % 3), y + 1.}});
+            minX.push_back(boxes.back().min(0));
+            minY.push_back(boxes.back().min(1));
+            maxX.push_back(boxes.back().max(0));
+            maxY.push_back(boxes.back().max(1));
+        }
+        const BoxArrays<2, double> arrays{{minX.data(), minY.data()}, {maxX.data(), maxY.data()}};
+        std::vector<std::uint64_t> results(bitmaskWordCount(count));
+
+        THEN("Batch intersection matches individual tests")
+        {
+            const Box<2> query{{3.5, 2.5}, {9., 7.}};
+            intersects(query, arrays, count, results.data());
+            for (std::size_t index = 0; index != count; ++index)
+            {
+                CAPTURE(index);
+                REQUIRE(testBit(results.data(), index) == query.intersects(boxes[index]));
+            }
+        }
+
+        THEN("Batch inclusion matches individual tests")
+        {
+            const Position<2> position{4.5, 4.5};
+            contains(arrays, count, position, results.data());
+            for (std::size_t index = 0; index != count; ++index)
+            {
+                CAPTURE(index);
+                REQUIRE(testBit(results.data(), index) == boxes[index].contains(position));
+            }
+        }
+
+        THEN("Batch ray tests match individual tests")
+        {
+            const Position<2> origin{-1., 0.5};
+            const Vec<2> inverseDirection{1. / 1., 1. / 0.7};
+            intersectRay(arrays, count, origin, inverseDirection, 12., results.data());
+
+            std::size_t hits = 0;
+            for (std::size_t index = 0; index != count; ++index)
+            {
+                CAPTURE(index);
+                const bool hit = boxes[index].intersectRay(origin, inverseDirection, 12.).has_value();
+                REQUIRE(testBit(results.data(), index) == hit);
+                hits += hit;
+            }
+            REQUIRE(hits > 0);
+        }
+    }
+}
@@ -0,0 +1,168 @@
+#include "catch.hpp"
+
+#include <math/DualQuaternion.h>
+#include <math/Transformations.h>
+
+#include <vector>
+
+
+using namespace ad::math;
+
+
+template <class T_derived, int N_rows, int N_cols>
+bool approxEqual(const MatrixBase<T_derived, N_rows, N_cols, double> & a,
+                 const MatrixBase<T_derived, N_rows, N_cols, double> & b,
+                 double aMargin = 1E-12)
+{
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(), [aMargin](auto left, auto right)
+            {
+                return Approx(left).margin(aMargin) == right;
+            });
+}
+
+
+#define APPROX_EQUAL(a, b)          \
+    {                               \
+        CAPTURE(a, b);              \
+        REQUIRE(approxEqual(a, b)); \
+    }
+
+
+SCENARIO("Dual quaternion rigid transformations")
+{
+    GIVEN("A dual quaternion built from a rotation and a translation")
+    {
+        const Degree<double> angle{70.};
+        const UnitVec<3> axis{Vec<3>{1., -2., 0.5}};
+        const Vec<3> translation{3., -4., 5.};
+        const DualQuaternion<double> transformation{angle, axis, translation};
+
+        const Affine<3> expected{trans3d::rotate(angle, axis), translation};
+
+        THEN("Its rotation and translation can be retrieved")
+        {
+            APPROX_EQUAL(transformation.getRotation(), (Quaternion<double>{angle, axis}));
+            APPROX_EQUAL(transformation.getTranslation(), translation);
+        }
+
+        THEN("It transforms positions and vectors like the equivalent affine transformation")
+        {
+            const Position<3> position{1., 2., -3.};
+            const Vec<3> vector{1., 2., -3.};
+            APPROX_EQUAL(position * transformation, position * expected);
+            APPROX_EQUAL(vector * transformation, vector * expected);
+
+            APPROX_EQUAL(transformation.toAffine().linear(), expected.linear());
+            APPROX_EQUAL(transformation.toAffine().translation(), expected.translation());
+        }
+
+        GIVEN("A second transformation")
+        {
+            const DualQuaternion<double> second{Radian<double>{-1.2},
+                                                UnitVec<3>{Vec<3>{0., 1., 1.}},
+                                                Vec<3>{-1., 0., 2.}};
+
+            THEN("Their composition applies the first, then the second")
+            {
+                const Position<3> position{1., 2., -3.};
+                APPROX_EQUAL(position * (transformation * second), (position * transformation) * second);
+            }
+
+            THEN("Blending with full weight on one transformation gives this transformation")
+            {
+                const DualQuaternion<double> transformations[] = {transformation, second};
+                const double weights[] = {0., 1.};
+                const DualQuaternion<double> blended = blend(transformations, weights, 2);
+                APPROX_EQUAL(blended.getReal(), second.getReal());
+                APPROX_EQUAL(blended.getDual(), second.getDual());
+            }
+        }
+
+        THEN("Its inverse reverts it")
+        {
+            const Position<3> position{1., 2., -3.};
+            APPROX_EQUAL(position * transformation * transformation.inverse(), position);
+        }
+    }
+
+    GIVEN("Two translations")
+    {
+        const DualQuaternion<double> first{Quaternion<double>::Identity(), Vec<3>{2., 0., 0.}};
+        const DualQuaternion<double> second{Quaternion<double>::Identity(), Vec<3>{0., 4., 0.}};
+
+        THEN("Their even blend is the average translation")
+        {
+            const DualQuaternion<double> transformations[] = {first, second};
+            const double weights[] = {0.5, 0.5};
+            APPROX_EQUAL(blend(transformations, weights, 2).getTranslation(), (Vec<3>{1., 2., 0.}));
+        }
+    }
+
+    GIVEN("A dual quaternion whose real part is negated")
+    {
+        const DualQuaternion<double> transformation{Degree<double>{30.}, UnitVec<3>{Vec<3>{0., 0., 1.}}, Vec<3>{1., 1., 1.}};
+        const DualQuaternion<double> negated{-transformation.getReal(), -transformation.getDual()};
+
+        THEN("It blends as the same transformation")
+        {
+            const DualQuaternion<double> transformations[] = {transformation, negated};
+            const double weights[] = {0.5, 0.5};
+            const DualQuaternion<double> blended = blend(transformations, weights, 2);
+            APPROX_EQUAL(blended.getReal(), transformation.getReal());
+            APPROX_EQUAL(blended.getDual(), transformation.getDual());
+        }
+    }
+}
+
+
+SCENARIO("Batched dual quaternion skinning")
+{
+    GIVEN("A palette of bones and vertices influenced by two bones each")
+    {
+        const std::vector<DualQuaternion<double>> bones{
+            {Degree<double>{30.}, UnitVec<3>{Vec<3>{0., 0., 1.}}, Vec<3>{1., 0., 0.}},
+            {Degree<double>{-100.}, UnitVec<3>{Vec<3>{1., 1., 0.}}, Vec<3>{0., 2., -1.}},
+            {Degree<double>{200.}, UnitVec<3>{Vec<3>{1., -1., 3.}}, Vec<3>{0.5, 0., 3.}},
+        };
+
+        const std::size_t count = 7;
+        std::vector<std::uint32_t> indices;
+        std::vector<double> weights;
+        std::vector<double> x, y, z;
+        for (std::size_t vertex = 0; vertex != count; ++vertex)
+        {
+            indices.push_back(vertex % 3);
+            indices.push_back((vertex + 1) % 3);
+            weights.push_back(vertex / 6.);
+            weights.push_back(1. - vertex / 6.);
+            x.push_back(1. * vertex);
+            y.push_back(2. - vertex);
+            z.push_back(0.5 * vertex);
+        }
+
+        WHEN("The vertices are skinned")
+        {
+            std::vector<double> resultX(count), resultY(count), resultZ(count);
+            skin<2>(bones.data(), indices.data(), weights.data(),
+                    x.data(), y.data(), z.data(),
+                    count,
+                    resultX.data(), resultY.data(), resultZ.data());
+
+            THEN("Each vertex is transformed by the blend of its bones")
+            {
+                for (std::size_t vertex = 0; vertex != count; ++vertex)
+                {
+                    const DualQuaternion<double> vertexBones[] = {
+                        bones[indices[2*vertex]],
+                        bones[indices[2*vertex + 1]],
+                    };
+                    const Position<3> expected =
+                        Position<3>{x[vertex], y[vertex], z[vertex]}
+                        * blend(vertexBones, &weights[2*vertex], 2);
+
+                    APPROX_EQUAL((Position<3>{resultX[vertex], resultY[vertex], resultZ[vertex]}), expected);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,157 @@
+#include "catch.hpp"
+
+#include <math/DynamicPolynomial.h>
+
+#include <random>
+#include <vector>
+
+#include <cmath>
+
+using namespace ad::math;
+
+
+namespace {
+
+
+    std::vector<double> randomCoefficients(std::size_t aCount, std::mt19937 & aEngine)
+    {
+        std::uniform_real_distribution<double> distribution{-1., 1.};
+        std::vector<double> result(aCount);
+        for (double & coefficient : result)
+        {
+            coefficient = distribution(aEngine);
+        }
+        return result;
+    }
+
+
+    std::vector<double> multiplyNaive(const std::vector<double> & aLhs, const std::vector<double> & aRhs)
+    {
+        std::vector<double> result(aLhs.size() + aRhs.size() - 1, 0.);
+        for (std::size_t left = 0; left != aLhs.size(); ++left)
+        {
+            for (std::size_t right = 0; right != aRhs.size(); ++right)
+            {
+                result[left + right] += aLhs[left] * aRhs[right];
+            }
+        }
+        return result;
+    }
+
+
+} // anonymous namespace
+
+
+SCENARIO("Dynamic polynomials usage")
+{
+    GIVEN("The null polynomial")
+    {
+        DynamicPolynomial<> zero;
+
+        THEN("It has degree 0")
+        {
+            REQUIRE(zero.degree() == 0);
+            REQUIRE(zero.evaluate(3.) == 0.);
+            REQUIRE(zero == DynamicPolynomial<>{0., 0., 0.});
+        }
+    }
+
+    GIVEN("A polynomial converted from a fixed degree polynomial")
+    {
+        constexpr Polynomial<3> fixed(0.5, 0., 1., -1.);
+        DynamicPolynomial<> polynomial = fixed;
+
+        THEN("It has the same coefficients and values")
+        {
+            REQUIRE(polynomial.degree() == 3);
+            REQUIRE(polynomial == DynamicPolynomial<>{0.5, 0., 1., -1.});
+
+            double value = GENERATE(-2., -0.5, 0., 1.25, 3.);
+            REQUIRE(polynomial.evaluate(value) == Approx(fixed.evaluate(value)));
+        }
+
+        THEN("A batch of values can be evaluated, in place")
+        {
+            std::vector<double> values{-2., -0.5, 0., 1.25, 3.};
+            std::vector<double> results(values.size());
+            polynomial.evaluate(values.data(), values.size(), results.data());
+            for (std::size_t index = 0; index != values.size(); ++index)
+            {
+                REQUIRE(results[index] == polynomial.evaluate(values[index]));
+            }
+
+            polynomial.evaluate(values.data(), values.size(), values.data());
+            REQUIRE(values == results);
+        }
+
+        THEN("The algebra matches the fixed degree polynomials")
+        {
+            constexpr Polynomial<2> other(1., -2., 3.);
+            DynamicPolynomial<> dynamicOther = other;
+            REQUIRE(polynomial + dynamicOther == DynamicPolynomial<>{fixed + other});
+            REQUIRE(polynomial - dynamicOther == DynamicPolynomial<>{fixed - other});
+            REQUIRE(polynomial * dynamicOther == DynamicPolynomial<>{fixed * other});
+            REQUIRE(2. * polynomial == DynamicPolynomial<>{2. * fixed});
+            REQUIRE(polynomial.derivative() == DynamicPolynomial<>{fixed.derivative()});
+            REQUIRE(polynomial.integral(1.) == DynamicPolynomial<>{fixed.integral(1.)});
+            REQUIRE(polynomial.compose(dynamicOther) == DynamicPolynomial<>{fixed.compose(other)});
+        }
+
+        THEN("Leading coefficients cancelling out lower the degree")
+        {
+            REQUIRE((polynomial - DynamicPolynomial<>{0., 0., 0., -1.}).degree() == 2);
+            REQUIRE((polynomial - polynomial).degree() == 0);
+            REQUIRE((polynomial * 0.) == DynamicPolynomial<>{});
+            REQUIRE(DynamicPolynomial<>{4.}.derivative() == DynamicPolynomial<>{});
+        }
+    }
+
+    GIVEN("Integer polynomials")
+    {
+        DynamicPolynomial<int> lhs{1, 1};
+        THEN("Products are exact")
+        {
+            DynamicPolynomial<int> power{1};
+            for (int exponent = 0; exponent != 10; ++exponent)
+            {
+                power *= lhs;
+            }
+            REQUIRE(power.degree() == 10);
+            REQUIRE(power.coefficient(5) == 252);
+        }
+    }
+
+    GIVEN("Polynomials long enough to be multiplied via FFT")
+    {
+        std::mt19937 engine{7};
+        std::size_t lhsCount = DynamicPolynomial<>::gFftThreshold + GENERATE(0, 53, 384);
+        std::vector<double> lhs = randomCoefficients(lhsCount, engine);
+        std::vector<double> rhs = randomCoefficients(DynamicPolynomial<>::gFftThreshold + 17, engine);
+
+        THEN("The product matches the direct convolution, up to round-off errors")
+        {
+            DynamicPolynomial<> product = DynamicPolynomial<>{lhs} * DynamicPolynomial<>{rhs};
+            std::vector<double> expected = multiplyNaive(lhs, rhs);
+
+            REQUIRE(product.degree() == expected.size() - 1);
+            for (std::size_t degree = 0; degree != expected.size(); ++degree)
+            {
+                REQUIRE(product.coefficient(degree) == Approx(expected[degree]).margin(1e-12));
+            }
+        }
+
+        THEN("Single precision products are promoted")
+        {
+            std::vector<float> lhsFloat(lhs.begin(), lhs.end());
+            std::vector<float> rhsFloat(rhs.begin(), rhs.end());
+            DynamicPolynomial<float> product = DynamicPolynomial<float>{lhsFloat} * DynamicPolynomial<float>{rhsFloat};
+            std::vector<double> expected = multiplyNaive(std::vector<double>(lhsFloat.begin(), lhsFloat.end()),
+                                                         std::vector<double>(rhsFloat.begin(), rhsFloat.end()));
+
+            for (std::size_t degree = 0; degree != expected.size(); ++degree)
+            {
+                REQUIRE(product.coefficient(degree) == Approx(expected[degree]).margin(1e-5));
+            }
+        }
+    }
+}
@@ -0,0 +1,88 @@
+#include "catch.hpp"
+
+#include <math/Frustum.h>
+#include <math/Transformations.h>
+
+#include <vector>
+
+
+using namespace ad::math;
+
+
+SCENARIO("Frustum culling")
+{
+    GIVEN("The frustum of a camera at (0, 0, 10) looking at the origin")
+    {
+        const Matrix<4, 4> viewProjection =
+            trans3d::lookAt(Position<3>{0., 0., 10.}, Position<3>{0., 0., 0.}, Vec<3>{0., 1., 0.})
+            * trans3d::perspective(Degree<double>{90.}, 1., 1., 100.);
+        const Frustum<double> frustum{viewProjection};
+
+        THEN("Its planes are normalized and point inward")
+        {
+            REQUIRE(frustum.getPlane(Frustum<double>::Near).z() == Approx(-1.));
+            REQUIRE(frustum.getPlane(Frustum<double>::Near).w() == Approx(9.));
+            REQUIRE(frustum.getPlane(Frustum<double>::Far).z() == Approx(1.));
+            REQUIRE(frustum.getPlane(Frustum<double>::Far).w() == Approx(90.));
+        }
+
+        THEN("It contains positions between the near and far planes, within the field of view")
+        {
+            REQUIRE(frustum.contains({0., 0., 0.}));
+            REQUIRE(frustum.contains({9.9, 0., 0.}));
+            REQUIRE_FALSE(frustum.contains({10.1, 0., 0.}));
+            REQUIRE_FALSE(frustum.contains({0., 0., 9.5}));
+            REQUIRE_FALSE(frustum.contains({0., 0., -91.}));
+        }
+
+        THEN("Spheres and boxes partially inside intersect it")
+        {
+            REQUIRE(frustum.intersectsSphere({11., 0., 0.}, 1.));
+            REQUIRE_FALSE(frustum.intersectsSphere({12., 0., 0.}, 1.));
+            REQUIRE(frustum.intersectsBox({11., 0., 0.}, {1.5, 1., 1.}));
+            REQUIRE_FALSE(frustum.intersectsBox({12., 0., 0.}, {1., 1., 1.}));
+        }
+
+        GIVEN("Many spheres and boxes stored as structures of arrays")
+        {
+            // Not a multiple of 64, to exercise the last partial word
+            const std::size_t count = 150;
+            std::vector<double> x, y, z, sizes;
+            for (std::size_t index = 0; index != count; ++index)
+            {
+                x.push_back(-30. + 0.4 * index);
+                y.push_back((index % 7) - 3.);
+                z.push_back(-(index % 13) * 1.);
+                sizes.push_back(0.1 * (index % 5));
+            }
+
+            THEN("The batch tests set the bits of the individually intersecting volumes")
+            {
+                std::vector<std::uint64_t> spheres((count + 63) / 64);
+                std::vector<std::uint64_t> boxes((count + 63) / 64);
+                frustum.intersectSpheres(x.data(), y.data(), z.data(), sizes.data(), count, spheres.data());
+                frustum.intersectBoxes(x.data(), y.data(), z.data(),
+                                       sizes.data(), sizes.data(), sizes.data(),
+                                       count, boxes.data());
+
+                std::size_t visibleCount = 0;
+                for (std::size_t index = 0; index != count; ++index)
+                {
+                    CAPTURE(index);
+                    const bool sphere = frustum.intersectsSphere({x[index], y[index], z[index]}, sizes[index]);
+                    const bool box = frustum.intersectsBox({x[index], y[index], z[index]},
+                                                           {sizes[index], sizes[index], sizes[index]});
+                    REQUIRE(((spheres[index / 64] >> (index % 64)) & 1) == sphere);
+                    REQUIRE(((boxes[index / 64] >> (index % 64)) & 1) == box);
+                    visibleCount += sphere;
+                }
+
+                // Ensures the test data covers both outcomes
+                REQUIRE(visibleCount > 0);
+                REQUIRE(visibleCount < count);
+                // The padding bits of the last word are cleared
+                REQUIRE((spheres.back() >> (count % 64)) == 0);
+            }
+        }
+    }
+}
@@ -0,0 +1,220 @@
+#include "catch.hpp"
+
+#include <math/KdTree.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+
+using namespace ad::math;
+
+
+namespace {
+
+    template <int N_dimension>
+    std::vector<Position<N_dimension, float>> randomPositions(std::size_t aCount, std::mt19937 & aEngine)
+    {
+        std::uniform_real_distribution<float> coordinate{-20.f, 20.f};
+        std::vector<Position<N_dimension, float>> result;
+        for (std::size_t index = 0; index != aCount; ++index)
+        {
+            Position<N_dimension, float> position = Position<N_dimension, float>::Zero();
+            for (std::size_t axis = 0; axis != N_dimension; ++axis)
+            {
+                position[axis] = coordinate(aEngine);
+            }
+            result.push_back(position);
+        }
+        return result;
+    }
+
+    // Squared distances from aCenter to all positions, sorted.
+    template <int N_dimension>
+    std::vector<float> sortedSquaredDistances(const std::vector<Position<N_dimension, float>> & aPositions,
+                                              const Position<N_dimension, float> & aCenter)
+    {
+        std::vector<float> result;
+        for (const Position<N_dimension, float> & position : aPositions)
+        {
+            result.push_back((position - aCenter).getNormSquared());
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    template <int N_dimension>
+    void checkQueries(const KdTree<N_dimension, float> & aTree,
+                      const std::vector<Position<N_dimension, float>> & aPositions,
+                      std::mt19937 & aEngine)
+    {
+        using Neighbour = typename KdTree<N_dimension, float>::Neighbour;
+
+        for (const Position<N_dimension, float> & center : randomPositions<N_dimension>(30, aEngine))
+        {
+            const std::vector<float> expected = sortedSquaredDistances(aPositions, center);
+
+            auto nearest = aTree.findNearest(center);
+            REQUIRE(nearest);
+            REQUIRE(nearest->squaredDistance == expected.front());
+            REQUIRE(nearest->squaredDistance == (aPositions[nearest->index] - center).getNormSquared());
+
+            std::vector<Neighbour> neighbours(10, Neighbour{0, 0.f});
+            REQUIRE(aTree.findKNearest(center, 10, neighbours.data()) == 10);
+            for (std::size_t rank = 0; rank != 10; ++rank)
+            {
+                REQUIRE(neighbours[rank].squaredDistance == expected[rank]);
+                REQUIRE(neighbours[rank].squaredDistance
+                        == (aPositions[neighbours[rank].index] - center).getNormSquared());
+            }
+
+            const float radius = 4.f;
+            std::vector<typename KdTree<N_dimension, float>::PointIndex> found;
+            aTree.forEachInRadius(center, radius, [&](auto aIndex, float aSquaredDistance)
+            {
+                REQUIRE(aSquaredDistance == (aPositions[aIndex] - center).getNormSquared());
+                found.push_back(aIndex);
+            });
+            std::sort(found.begin(), found.end());
+            REQUIRE(std::adjacent_find(found.begin(), found.end()) == found.end());
+            REQUIRE(found.size() == static_cast<std::size_t>(
+                std::upper_bound(expected.begin(), expected.end(), radius * radius) - expected.begin()));
+        }
+    }
+
+} // anonymous namespace
+
+
+SCENARIO("k-d tree queries")
+{
+    std::mt19937 engine{5};
+    const std::size_t threadCount = GENERATE(1, 4);
+
+    GIVEN("Points in 2D")
+    {
+        std::vector<Position<2, float>> positions = randomPositions<2>(3000, engine);
+        KdTree<2, float> tree{positions.data(), positions.size(), threadCount};
+        REQUIRE(tree.size() == 3000);
+
+        THEN("Nearest, k-nearest and radius queries match a linear scan")
+        {
+            checkQueries(tree, positions, engine);
+        }
+    }
+
+    GIVEN("Points in 3D")
+    {
+        std::vector<Position<3, float>> positions = randomPositions<3>(3000, engine);
+        KdTree<3, float> tree{positions.data(), positions.size(), threadCount};
+
+        THEN("Nearest, k-nearest and radius queries match a linear scan")
+        {
+            checkQueries(tree, positions, engine);
+        }
+    }
+
+    GIVEN("Points with many duplicated coordinates")
+    {
+        std::vector<Position<2, float>> positions;
+        for (int index = 0; index != 500; ++index)
+        {
+            positions.push_back({static_cast<float>(index % 7), static_cast<float>(index % 3)});
+        }
+        KdTree<2, float> tree{positions.data(), positions.size(), threadCount};
+
+        THEN("Queries match a linear scan")
+        {
+            checkQueries(tree, positions, engine);
+        }
+    }
+}
+
+
+SCENARIO("k-d tree query limits")
+{
+    using Neighbour = KdTree<2, float>::Neighbour;
+
+    GIVEN("A tree of three points")
+    {
+        std::vector<Position<2, float>> positions{{0.f, 0.f}, {1.f, 0.f}, {5.f, 0.f}};
+        KdTree<2, float> tree{positions.data(), positions.size()};
+
+        THEN("The maximum distance bounds the nearest search")
+        {
+            REQUIRE_FALSE(tree.findNearest({3.f, 3.f}, 2.f));
+            REQUIRE(tree.findNearest({4.f, 0.f}, 2.f)->index == 2);
+        }
+
+        THEN("k-nearest returns less neighbours when the tree or the distance is too small")
+        {
+            std::vector<Neighbour> neighbours(5, Neighbour{0, 0.f});
+            REQUIRE(tree.findKNearest({0.f, 0.f}, 5, neighbours.data()) == 3);
+            REQUIRE(neighbours[0].index == 0);
+            REQUIRE(neighbours[1].index == 1);
+            REQUIRE(neighbours[2].index == 2);
+
+            REQUIRE(tree.findKNearest({0.f, 0.f}, 5, neighbours.data(), 2.f) == 2);
+            REQUIRE(tree.findKNearest({0.f, 0.f}, 0, neighbours.data()) == 0);
+        }
+    }
+
+    GIVEN("An empty tree")
+    {
+        KdTree<3, float> tree{nullptr, 0};
+
+        THEN("Queries find nothing")
+        {
+            REQUIRE(tree.size() == 0);
+            REQUIRE_FALSE(tree.findNearest(Position<3, float>::Zero()));
+        }
+    }
+}
+
+
+SCENARIO("k-d tree batch queries")
+{
+    using Neighbour = KdTree<3, float>::Neighbour;
+
+    std::mt19937 engine{7};
+    std::vector<Position<3, float>> positions = randomPositions<3>(2000, engine);
+    KdTree<3, float> tree{positions.data(), positions.size(), 2};
+
+    std::vector<Position<3, float>> queries = randomPositions<3>(200, engine);
+
+    GIVEN("A batch nearest query over several threads")
+    {
+        std::vector<Neighbour> results(queries.size(), Neighbour{0, 0.f});
+        tree.findNearest(queries.data(), queries.size(), results.data(), 3);
+
+        THEN("Each result matches the single query")
+        {
+            for (std::size_t query = 0; query != queries.size(); ++query)
+            {
+                REQUIRE(results[query].squaredDistance == tree.findNearest(queries[query])->squaredDistance);
+            }
+        }
+    }
+
+    GIVEN("A batch k-nearest query asking for more neighbours than a small tree holds")
+    {
+        std::vector<Position<3, float>> few(positions.begin(), positions.begin() + 4);
+        KdTree<3, float> small{few.data(), few.size()};
+        const std::size_t k = 6;
+        std::vector<Neighbour> results(queries.size() * k, Neighbour{0, 0.f});
+        small.findKNearest(queries.data(), queries.size(), k, results.data(), 3);
+
+        THEN("Each query gets the four points closest first, then padding")
+        {
+            for (std::size_t query = 0; query != queries.size(); ++query)
+            {
+                const std::vector<float> expected = sortedSquaredDistances(few, queries[query]);
+                for (std::size_t rank = 0; rank != 4; ++rank)
+                {
+                    REQUIRE(results[query * k + rank].squaredDistance == expected[rank]);
+                }
+                REQUIRE(results[query * k + 4].index == KdTree<3, float>::gNoPoint);
+                REQUIRE(results[query * k + 5].index == KdTree<3, float>::gNoPoint);
+            }
+        }
+    }
+}
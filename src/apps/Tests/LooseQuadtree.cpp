@@ -0,0 +1,169 @@
+#include "catch.hpp"
+
+#include <math/LooseQuadtree.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+
+using namespace ad::math;
+
+
+namespace {
+
+    template <class T_number>
+    std::vector<std::size_t> queryRegion(const LooseQuadtree<T_number> & aTree, const Rectangle<T_number> & aRegion)
+    {
+        std::vector<std::size_t> result;
+        aTree.queryRegion(aRegion, [&result](std::size_t aId){ result.push_back(aId); });
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    template <class T_number>
+    std::vector<std::size_t> queryPoint(const LooseQuadtree<T_number> & aTree, const Position<2, T_number> & aPosition)
+    {
+        std::vector<std::size_t> result;
+        aTree.queryPoint(aPosition, [&result](std::size_t aId){ result.push_back(aId); });
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+} // anonymous namespace
+
+
+SCENARIO("Loose quadtree usage")
+{
+    GIVEN("A quadtree over a 100x100 world")
+    {
+        LooseQuadtree<double> tree{Rectangle<double>{{0., 0.}, {100., 100.}}, 4};
+
+        const auto small = tree.insert({{10., 10.}, {2., 2.}});
+        const auto large = tree.insert({{20., 20.}, {60., 60.}});
+        const auto outside = tree.insert({{-50., 150.}, {10., 10.}});
+
+        THEN("Region queries return the intersecting rectangles")
+        {
+            REQUIRE(tree.size() == 3);
+            REQUIRE(queryRegion(tree, {{0., 0.}, {15., 15.}}) == std::vector<std::size_t>{small});
+            REQUIRE(queryRegion(tree, {{11., 11.}, {10., 10.}}) == (std::vector<std::size_t>{small, large}));
+            REQUIRE(queryRegion(tree, {{-45., 155.}, {1., 1.}}) == std::vector<std::size_t>{outside});
+            REQUIRE(queryRegion(tree, {{90., 5.}, {5., 5.}}).empty());
+        }
+
+        THEN("Point queries return the containing rectangles, bounds inclusive")
+        {
+            REQUIRE(queryPoint(tree, Position<2, double>{12., 12.}) == std::vector<std::size_t>{small});
+            REQUIRE(queryPoint(tree, Position<2, double>{50., 50.}) == std::vector<std::size_t>{large});
+            REQUIRE(queryPoint(tree, Position<2, double>{5., 5.}).empty());
+        }
+
+        WHEN("An object is moved")
+        {
+            tree.move(small, {{70., 5.}, {2., 2.}});
+
+            THEN("It is found at its new position only")
+            {
+                REQUIRE(tree.getBounds(small) == (Rectangle<double>{{70., 5.}, {2., 2.}}));
+                REQUIRE(queryRegion(tree, {{0., 0.}, {15., 15.}}).empty());
+                REQUIRE(queryPoint(tree, Position<2, double>{71., 6.}) == std::vector<std::size_t>{small});
+            }
+        }
+
+        WHEN("An object is removed")
+        {
+            tree.remove(large);
+
+            THEN("It is not found anymore, and its identifier is reused")
+            {
+                REQUIRE(tree.size() == 2);
+                REQUIRE(queryPoint(tree, Position<2, double>{50., 50.}).empty());
+                REQUIRE(tree.insert({{1., 1.}, {1., 1.}}) == large);
+            }
+        }
+    }
+
+    GIVEN("Many random moving rectangles")
+    {
+        std::mt19937 engine{7};
+        std::uniform_real_distribution<float> position{-10.f, 110.f};
+        std::uniform_real_distribution<float> extent{0.f, 20.f};
+        auto randomRectangle = [&]()
+        {
+            return Rectangle<float>{{position(engine), position(engine)}, {extent(engine), extent(engine)}};
+        };
+
+        LooseQuadtree<float> tree{Rectangle<float>{{0.f, 0.f}, {100.f, 100.f}}};
+        std::vector<Rectangle<float>> rectangles;
+        for (int index = 0; index != 500; ++index)
+        {
+            rectangles.push_back(randomRectangle());
+            REQUIRE(tree.insert(rectangles.back()) == rectangles.size() - 1);
+        }
+        for (int step = 0; step != 500; ++step)
+        {
+            const std::size_t id = engine() % rectangles.size();
+            rectangles[id] = randomRectangle();
+            tree.move(id, rectangles[id]);
+        }
+
+        THEN("Region queries match a linear scan")
+        {
+            for (int query = 0; query != 100; ++query)
+            {
+                const Rectangle<float> region = randomRectangle();
+                std::vector<std::size_t> expected;
+                for (std::size_t id = 0; id != rectangles.size(); ++id)
+                {
+                    const Rectangle<float> & r = rectangles[id];
+                    if (r.xMin() <= region.xMax() && region.xMin() <= r.xMax()
+                        && r.yMin() <= region.yMax() && region.yMin() <= r.yMax())
+                    {
+                        expected.push_back(id);
+                    }
+                }
+                REQUIRE(queryRegion(tree, region) == expected);
+            }
+        }
+    }
+
+    GIVEN("Integer rectangles, in a world not evenly divided by the cells")
+    {
+        std::mt19937 engine{11};
+        std::uniform_int_distribution<int> position{-10, 110};
+        std::uniform_int_distribution<int> extent{0, 20};
+        auto randomRectangle = [&]()
+        {
+            return Rectangle<int>{{position(engine), position(engine)}, {extent(engine), extent(engine)}};
+        };
+
+        LooseQuadtree<int> tree{Rectangle<int>{{0, 0}, {100, 100}}};
+        std::vector<Rectangle<int>> rectangles;
+        for (int index = 0; index != 300; ++index)
+        {
+            rectangles.push_back(randomRectangle());
+            REQUIRE(tree.insert(rectangles.back()) == rectangles.size() - 1);
+        }
+
+        THEN("Point queries match a linear scan")
+        {
+            for (int x = -10; x <= 110; x += 7)
+            {
+                for (int y = -10; y <= 110; y += 7)
+                {
+                    std::vector<std::size_t> expected;
+                    for (std::size_t id = 0; id != rectangles.size(); ++id)
+                    {
+                        const Rectangle<int> & r = rectangles[id];
+                        if (r.xMin() <= x && x <= r.xMax() && r.yMin() <= y && y <= r.yMax())
+                        {
+                            expected.push_back(id);
+                        }
+                    }
+                    REQUIRE(queryPoint(tree, Position<2, int>{x, y}) == expected);
+                }
+            }
+        }
+    }
+}
@@ -339,3 +339,49 @@ SCENARIO("Matrix transposition")
         }
     }
 }
+
+
+SCENARIO("Matrix inversion")
+{
+    GIVEN("An invertible 3x3 Matrix, requiring row exchanges")
+    {
+        Matrix<3, 3> source{
+            0., 2., 1.,
+            1., 1., 0.,
+            3., 0., 2.,
+        };
+
+        WHEN("It is inverted")
+        {
+            auto inverse = source.inverse();
+
+            THEN("Its products with the source are the identity")
+            {
+                auto left = inverse * source;
+                auto right = source * inverse;
+                for (std::size_t row = 0; row != 3; ++row)
+                {
+                    for (std::size_t col = 0; col != 3; ++col)
+                    {
+                        REQUIRE(left[row][col] == Approx(row == col ? 1. : 0.).margin(1E-12));
+                        REQUIRE(right[row][col] == Approx(row == col ? 1. : 0.).margin(1E-12));
+                    }
+                }
+            }
+        }
+    }
+
+    GIVEN("A diagonal 2x2 Matrix")
+    {
+        constexpr Matrix<2, 2> source{
+            2., 0.,
+            0., 4.,
+        };
+
+        THEN("It can be inverted at compile time")
+        {
+            constexpr Matrix<2, 2> inverse = source.inverse();
+            REQUIRE(inverse == (Matrix<2, 2>{0.5, 0., 0., 0.25}));
+        }
+    }
+}
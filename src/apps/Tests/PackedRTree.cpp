@@ -0,0 +1,137 @@
+#include "catch.hpp"
+
+#include <math/PackedRTree.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <random>
+#include <vector>
+
+
+using namespace ad::math;
+
+
+namespace {
+
+    template <class T_tree>
+    std::vector<std::uint32_t> query(const T_tree & aTree, const Rectangle<float> & aRegion)
+    {
+        std::vector<std::uint32_t> result;
+        aTree.query(aRegion, [&result](std::uint32_t aIndex){ result.push_back(aIndex); });
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    std::vector<std::uint32_t> bruteForce(const std::vector<Rectangle<float>> & aRectangles,
+                                          const Rectangle<float> & aRegion)
+    {
+        std::vector<std::uint32_t> result;
+        for (std::uint32_t index = 0; index != aRectangles.size(); ++index)
+        {
+            const Rectangle<float> & rectangle = aRectangles[index];
+            if (rectangle.xMin() <= aRegion.xMax() && aRegion.xMin() <= rectangle.xMax()
+                && rectangle.yMin() <= aRegion.yMax() && aRegion.yMin() <= rectangle.yMax())
+            {
+                result.push_back(index);
+            }
+        }
+        return result;
+    }
+
+} // anonymous namespace
+
+
+SCENARIO("Packed R-tree")
+{
+    std::mt19937 engine{5};
+    std::uniform_real_distribution<float> coordinate{0.f, 1000.f};
+    std::uniform_real_distribution<float> extent{0.f, 10.f};
+    auto randomRectangle = [&]()
+    {
+        return Rectangle<float>{{coordinate(engine), coordinate(engine)}, {extent(engine), extent(engine)}};
+    };
+
+    GIVEN("Trees bulk loaded over random rectangles")
+    {
+        // Node sizes and counts leaving partial nodes on each level
+        const std::size_t nodeSize = GENERATE(2, 5, 16);
+        std::vector<Rectangle<float>> rectangles;
+        for (int index = 0; index != 3001; ++index)
+        {
+            rectangles.push_back(randomRectangle());
+        }
+        const PackedRTree<float> tree = PackedRTree<float>::Build(rectangles.data(), rectangles.size(), nodeSize);
+
+        THEN("Queries match a linear scan")
+        {
+            REQUIRE(tree.size() == 3001);
+            REQUIRE(tree.getNodeSize() == nodeSize);
+            for (int query = 0; query != 30; ++query)
+            {
+                const Rectangle<float> region{{coordinate(engine), coordinate(engine)}, {50.f, 80.f}};
+                REQUIRE(::query(tree, region) == bruteForce(rectangles, region));
+            }
+
+            const Position<2, float> corner = rectangles[42].origin();
+            std::vector<std::uint32_t> containing;
+            tree.query(corner, [&containing](std::uint32_t aIndex){ containing.push_back(aIndex); });
+            REQUIRE(std::count(containing.begin(), containing.end(), 42) == 1);
+        }
+
+        GIVEN("A file the tree is saved to")
+        {
+            const std::string path =
+                (std::filesystem::temp_directory_path() / "ad_math_packed_rtree.bin").string();
+            tree.save(path);
+
+            THEN("The mapped tree answers the same queries")
+            {
+                const PackedRTree<float> mapped = PackedRTree<float>::Open(path);
+                REQUIRE(mapped.size() == tree.size());
+                for (int query = 0; query != 30; ++query)
+                {
+                    const Rectangle<float> region{{coordinate(engine), coordinate(engine)}, {50.f, 80.f}};
+                    REQUIRE(::query(mapped, region) == ::query(tree, region));
+                }
+            }
+
+            THEN("Opening it as a tree of doubles fails")
+            {
+                REQUIRE_THROWS_AS(PackedRTree<double>::Open(path), std::runtime_error);
+            }
+
+            THEN("Opening a truncated file fails")
+            {
+                std::filesystem::resize_file(path, std::filesystem::file_size(path) - 4);
+                REQUIRE_THROWS_AS(PackedRTree<float>::Open(path), std::runtime_error);
+            }
+
+            std::filesystem::remove(path);
+        }
+    }
+
+    GIVEN("Trees of zero and one rectangle")
+    {
+        const Rectangle<float> rectangle{{1.f, 1.f}, {2.f, 2.f}};
+        const PackedRTree<float> empty = PackedRTree<float>::Build(nullptr, 0);
+        const PackedRTree<float> single = PackedRTree<float>::Build(&rectangle, 1);
+
+        THEN("Queries find the only rectangle, if any")
+        {
+            REQUIRE(query(empty, rectangle).empty());
+            REQUIRE(query(single, {{0.f, 0.f}, {1.f, 1.f}}) == std::vector<std::uint32_t>{0});
+            REQUIRE(query(single, {{4.f, 0.f}, {1.f, 1.f}}).empty());
+        }
+
+        THEN("They can be saved and mapped back")
+        {
+            const std::string path =
+                (std::filesystem::temp_directory_path() / "ad_math_packed_rtree_small.bin").string();
+            empty.save(path);
+            REQUIRE(PackedRTree<float>::Open(path).size() == 0);
+            single.save(path);
+            REQUIRE(query(PackedRTree<float>::Open(path), rectangle) == std::vector<std::uint32_t>{0});
+            std::filesystem::remove(path);
+        }
+    }
+}
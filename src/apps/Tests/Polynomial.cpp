@@ -2,9 +2,48 @@
 
 #include <math/Polynomial.h>
 
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <cmath>
+
 using namespace ad::math;
 
 
+namespace {
+
+
+    /// \brief The monic polynomial with the given roots.
+    template <class... VT_roots>
+    constexpr auto fromRoots(double aRoot, VT_roots... aRoots)
+    {
+        if constexpr (sizeof...(VT_roots) == 0)
+        {
+            return Polynomial<1>(-aRoot, 1.);
+        }
+        else
+        {
+            return Polynomial<1>(-aRoot, 1.) * fromRoots(aRoots...);
+        }
+    }
+
+
+    template <int N_capacity>
+    void requireRoots(const Roots<N_capacity> & aRoots, std::vector<double> aExpected)
+    {
+        REQUIRE(aRoots.size() == aExpected.size());
+        for (std::size_t index = 0; index != aExpected.size(); ++index)
+        {
+            REQUIRE(aRoots[index] == Approx(aExpected[index]).margin(1e-9));
+        }
+    }
+
+
+} // anonymous namespace
+
+
 SCENARIO("Polynomials usage")
 {
     GIVEN("A polynomial of degree 2 with one real root")
@@ -56,4 +95,440 @@ SCENARIO("Polynomials usage")
             REQUIRE(polynomial.evaluate(6.3) == Approx(9009.3385));
         }
     }
+
+    GIVEN("A polynomial of degree 7")
+    {
+        auto polynomial = Polynomial<7>(0.5, -1., 2., 0.25, -3., 1.5, 0.75, -0.125);
+
+        auto naive = [&polynomial](double aValue)
+        {
+            double result = 0.;
+            for (std::size_t degree = 0; degree != 8; ++degree)
+            {
+                result += polynomial.coefficient(degree) * std::pow(aValue, degree);
+            }
+            return result;
+        };
+
+        double value = GENERATE(-2.5, -1., -0.3, 0., 0.7, 1., 3.2);
+
+        THEN("Horner and Estrin schemes agree with the sum of powers")
+        {
+            REQUIRE(polynomial.evaluateHorner(value) == Approx(naive(value)));
+            REQUIRE(polynomial.evaluateEstrin(value) == Approx(naive(value)));
+            REQUIRE(polynomial.evaluate(value) == Approx(naive(value)));
+        }
+
+        THEN("A batch of values can be evaluated, in place")
+        {
+            std::vector<double> values{value, value + 0.5, -value, 2 * value, value - 1.};
+            std::vector<double> results(values.size());
+            polynomial.evaluate(values.data(), values.size(), results.data());
+            for (std::size_t index = 0; index != values.size(); ++index)
+            {
+                REQUIRE(results[index] == polynomial.evaluate(values[index]));
+            }
+
+            polynomial.evaluate(values.data(), values.size(), values.data());
+            REQUIRE(values == results);
+        }
+    }
+
+    GIVEN("Polynomials of even and odd coefficient counts")
+    {
+        THEN("They can be evaluated at compile time")
+        {
+            constexpr Polynomial<2> square(1., 2., 1.);
+            static_assert(square.evaluate(3.) == 16.);
+
+            constexpr Polynomial<4, int> quartic(1, 1, 1, 1, 1);
+            static_assert(quartic.evaluateHorner(2) == 31);
+            static_assert(quartic.evaluateEstrin(2) == 31);
+
+            constexpr Polynomial<5, int> quintic(1, 0, -2, 0, 0, 1);
+            static_assert(quintic.evaluate(2) == 25);
+            static_assert(quintic.evaluate(-1) == -2);
+        }
+    }
+
+    GIVEN("Two polynomials of different degrees")
+    {
+        constexpr Polynomial<2> quadratic(1., -2., 3.);
+        constexpr Polynomial<3> cubic(0.5, 0., 1., -1.);
+
+        THEN("They can be added and subtracted, the result having the highest degree")
+        {
+            static_assert(quadratic + cubic == Polynomial<3>(1.5, -2., 4., -1.));
+            static_assert(cubic - quadratic == Polynomial<3>(-0.5, 2., -2., -1.));
+            static_assert(-quadratic == Polynomial<2>(-1., 2., -3.));
+        }
+
+        THEN("They can be multiplied, the degrees adding up")
+        {
+            constexpr Polynomial<5> product = quadratic * cubic;
+            static_assert(product == Polynomial<5>(0.5, -1., 2.5, -3., 5., -3.));
+
+            double value = GENERATE(-1.5, 0., 0.25, 2.);
+            REQUIRE(product.evaluate(value)
+                    == Approx(quadratic.evaluate(value) * cubic.evaluate(value)));
+        }
+
+        THEN("They can be scaled")
+        {
+            static_assert(2. * quadratic == Polynomial<2>(2., -4., 6.));
+            static_assert(quadratic * -1. == -quadratic);
+        }
+
+        THEN("They can be differentiated and integrated")
+        {
+            static_assert(cubic.derivative() == Polynomial<2>(0., 2., -3.));
+            static_assert(quadratic.integral(4.) == Polynomial<3>(4., 1., -1., 1.));
+            static_assert(quadratic.integral().derivative() == quadratic);
+            static_assert(Polynomial<0>(5.).derivative() == Polynomial<0>(0.));
+        }
+
+        THEN("They can be composed, the degrees multiplying")
+        {
+            constexpr Polynomial<6> composed = cubic.compose(quadratic);
+            double value = GENERATE(-1.5, 0., 0.25, 2.);
+            REQUIRE(composed.evaluate(value) == Approx(cubic.evaluate(quadratic.evaluate(value))));
+
+            // Composing with the identity
+            static_assert(quadratic.compose(Polynomial<1>(0., 1.)) == quadratic);
+            static_assert(quadratic.compose(Polynomial<0>(2.)) == Polynomial<0>(9.));
+        }
+    }
+
+    GIVEN("Cubic polynomials")
+    {
+        THEN("Three distinct real roots are found in ascending order")
+        {
+            requireRoots(solve(fromRoots(3., -2., 0.5)), {-2., 0.5, 3.});
+            requireRoots(solve(2. * fromRoots(1e-3, 1., 1e3)), {1e-3, 1., 1e3});
+        }
+
+        THEN("A single real root is found")
+        {
+            // (x - 2)(x^2 + 1)
+            requireRoots(solve(fromRoots(2.) * Polynomial<2>(1., 0., 1.)), {2.});
+        }
+
+        THEN("Multiple roots are returned once")
+        {
+            requireRoots(solve(fromRoots(1., 1., -3.)), {-3., 1.});
+            requireRoots(solve(fromRoots(-1.5, -1.5, -1.5)), {-1.5});
+        }
+
+        THEN("A null leading coefficient degrades to the quadratic")
+        {
+            requireRoots(solve(Polynomial<3>(-2., 1., 1., 0.)), {-2., 1.});
+        }
+    }
+
+    GIVEN("Quartic polynomials")
+    {
+        THEN("Four distinct real roots are found in ascending order")
+        {
+            requireRoots(solve(fromRoots(4., -1., 0.25, 2.)), {-1., 0.25, 2., 4.});
+            requireRoots(solve(-3. * fromRoots(-7., -5., 1., 10.)), {-7., -5., 1., 10.});
+        }
+
+        THEN("Two real roots are found")
+        {
+            requireRoots(solve(fromRoots(-1., 3.) * Polynomial<2>(2., 2., 1.)), {-1., 3.});
+        }
+
+        THEN("Biquadratic polynomials are solved")
+        {
+            requireRoots(solve(fromRoots(-2., -1., 1., 2.)), {-2., -1., 1., 2.});
+            requireRoots(solve(Polynomial<4>(1., 0., 2., 0., 1.)), {});
+        }
+
+        THEN("Polynomials without real roots have none")
+        {
+            requireRoots(solve(Polynomial<2>(1., 0., 1.) * Polynomial<2>(5., -2., 1.)), {});
+        }
+
+        THEN("Multiple roots are returned once")
+        {
+            requireRoots(solve(fromRoots(2., 2., -1., -1.)), {-1., 2.});
+        }
+
+        THEN("A null leading coefficient degrades to the cubic")
+        {
+            requireRoots(solve(Polynomial<4>(fromRoots(3., -2., 0.5).coefficients()[0],
+                                             fromRoots(3., -2., 0.5).coefficients()[1],
+                                             fromRoots(3., -2., 0.5).coefficients()[2],
+                                             1., 0.)),
+                         {-2., 0.5, 3.});
+        }
+    }
+
+    GIVEN("Batches of polynomials")
+    {
+        const std::vector<Polynomial<4>> polynomials{
+            fromRoots(4., -1., 0.25, 2.),
+            fromRoots(-1., 3.) * Polynomial<2>(2., 2., 1.),
+            Polynomial<2>(1., 0., 1.) * Polynomial<2>(5., -2., 1.),
+            2. * fromRoots(0.5, 0.5, 0.5, -4.),
+            fromRoots(-3., 1.) * fromRoots(1e-2, 1e2),
+        };
+        const std::size_t count = polynomials.size();
+
+        std::vector<double> coefficients[5];
+        for (const Polynomial<4> & polynomial : polynomials)
+        {
+            for (std::size_t degree = 0; degree != 5; ++degree)
+            {
+                coefficients[degree].push_back(polynomial.coefficient(degree));
+            }
+        }
+
+        std::vector<double> roots[4];
+        for (std::vector<double> & rootArray : roots)
+        {
+            rootArray.resize(count);
+        }
+        std::vector<int> rootCounts(count);
+
+        auto requireBatchRoots = [&](std::size_t aIndex, auto aExpected)
+        {
+            REQUIRE(rootCounts[aIndex] == static_cast<int>(aExpected.size()));
+            for (std::size_t root = 0; root != aExpected.capacity(); ++root)
+            {
+                if (root < aExpected.size())
+                {
+                    REQUIRE(roots[root][aIndex] == aExpected[root]);
+                }
+                else
+                {
+                    REQUIRE(std::isnan(roots[root][aIndex]));
+                }
+            }
+        };
+
+        THEN("Quartics are solved as one by one")
+        {
+            solveQuartics(coefficients[0].data(), coefficients[1].data(), coefficients[2].data(),
+                          coefficients[3].data(), coefficients[4].data(),
+                          count,
+                          roots[0].data(), roots[1].data(), roots[2].data(), roots[3].data(),
+                          rootCounts.data());
+            for (std::size_t index = 0; index != count; ++index)
+            {
+                requireBatchRoots(index, solve(polynomials[index]));
+            }
+        }
+
+        THEN("Cubics are solved as one by one")
+        {
+            solveCubics(coefficients[1].data(), coefficients[2].data(), coefficients[3].data(),
+                        coefficients[4].data(),
+                        count,
+                        roots[0].data(), roots[1].data(), roots[2].data(),
+                        rootCounts.data());
+            for (std::size_t index = 0; index != count; ++index)
+            {
+                requireBatchRoots(index, solve(Polynomial<3>(coefficients[1][index], coefficients[2][index],
+                                                             coefficients[3][index], coefficients[4][index])));
+            }
+        }
+
+        THEN("Polynomials with non-finite coefficients have no roots")
+        {
+            const double nan = std::numeric_limits<double>::quiet_NaN();
+            const double infinity = std::numeric_limits<double>::infinity();
+            requireRoots(solve(Polynomial<2>(1., nan, 0.)), {});
+            requireRoots(solve(Polynomial<3>(nan, 1., 1., 1.)), {});
+            requireRoots(solve(Polynomial<3>(1., -infinity, 0., 1.)), {});
+            requireRoots(solve(Polynomial<4>(-4., 0., 1., 0., nan)), {});
+            requireRoots(solve(Polynomial<4>(infinity, 1., 1., 1., 1.)), {});
+
+            const double one[] = {1.};
+            const double notANumber[] = {nan};
+            solveCubics(notANumber, one, one, one, 1,
+                        roots[0].data(), roots[1].data(), roots[2].data(),
+                        rootCounts.data());
+            requireBatchRoots(0, Roots<3>{});
+            solveQuartics(notANumber, one, one, one, one, 1,
+                          roots[0].data(), roots[1].data(), roots[2].data(), roots[3].data(),
+                          rootCounts.data());
+            requireBatchRoots(0, Roots<4>{});
+        }
+
+        THEN("Quadratics are solved as one by one")
+        {
+            solveQuadratics(coefficients[0].data(), coefficients[1].data(), coefficients[2].data(),
+                            count,
+                            roots[0].data(), roots[1].data(),
+                            rootCounts.data());
+            for (std::size_t index = 0; index != count; ++index)
+            {
+                const Roots<2> expected = solve(Polynomial<2>(coefficients[0][index], coefficients[1][index],
+                                                              coefficients[2][index]));
+                REQUIRE(rootCounts[index] == static_cast<int>(expected.size()));
+                for (std::size_t root = 0; root != expected.size(); ++root)
+                {
+                    REQUIRE(roots[root][index] == Approx(expected[root]));
+                }
+            }
+
+            // Double roots, including at 0
+            const double a[] = {1., 2.};
+            const double b[] = {-2., 0.};
+            const double c[] = {1., 0.};
+            solveQuadratics(c, b, a, 2, roots[0].data(), roots[1].data(), rootCounts.data());
+            REQUIRE(rootCounts[0] == 1);
+            REQUIRE(roots[0][0] == 1.);
+            REQUIRE(std::isnan(roots[1][0]));
+            REQUIRE(rootCounts[1] == 1);
+            REQUIRE(roots[0][1] == 0.);
+        }
+    }
+
+    GIVEN("Polynomials of degree above 4")
+    {
+        THEN("Their distinct real roots are found in ascending order")
+        {
+            requireRoots(solve(fromRoots(-3., -1., 0.5, 2., 7.)), {-3., -1., 0.5, 2., 7.});
+            requireRoots(solve(-0.5 * fromRoots(1e-2, 1., 5., 1e2, -4., -2e2)),
+                         {-2e2, -4., 1e-2, 1., 5., 1e2});
+            requireRoots(solve(fromRoots(1., 2., 3.) * Polynomial<2>(1., 0., 1.) * Polynomial<2>(3., 1., 1.)),
+                         {1., 2., 3.});
+        }
+
+        THEN("Multiple roots are returned once")
+        {
+            // Even multiplicity, where the polynomial does not change sign
+            requireRoots(solve(fromRoots(2., 2., -1., 4., 4., 4.)), {-1., 2., 4.});
+            requireRoots(solve(fromRoots(0., 0., 0., 0., 0.)), {0.});
+        }
+
+        THEN("Their roots are found whatever their scale")
+        {
+            double scale = GENERATE(1e-6, 1e-4, 1e4, 1e6, 1e8);
+            const std::vector<double> expected{-3., -1., 0.5, 1., 2., 3.};
+            const Roots<6> roots = solve(fromRoots(-1. * scale, 0.5 * scale, 1. * scale,
+                                                   2. * scale, 3. * scale, -3. * scale));
+            REQUIRE(roots.size() == expected.size());
+            for (std::size_t index = 0; index != expected.size(); ++index)
+            {
+                REQUIRE(roots[index] == Approx(expected[index] * scale));
+            }
+
+            requireRoots(solve(fromRoots(5e7, 1e8, 2e8, 3e8, -1e8)), {-1e8, 5e7, 1e8, 2e8, 3e8});
+
+            const Roots<6> multiple = solve(fromRoots(2. * scale, 2. * scale, -1. * scale,
+                                                      4. * scale, 4. * scale, 4. * scale));
+            REQUIRE(multiple.size() == 3);
+            REQUIRE(multiple[0] == Approx(-1. * scale));
+            REQUIRE(multiple[1] == Approx(2. * scale));
+            REQUIRE(multiple[2] == Approx(4. * scale));
+        }
+
+        THEN("Polynomials without real roots have none")
+        {
+            requireRoots(solve(Polynomial<2>(1., 0., 1.) * Polynomial<2>(5., -2., 1.) * Polynomial<2>(2., 2., 1.)),
+                         {});
+        }
+
+        THEN("Null leading coefficients lower the degree")
+        {
+            const Polynomial<3> cubic = fromRoots(3., -2., 0.5);
+            requireRoots(solve(Polynomial<6>(cubic.coefficients()[0], cubic.coefficients()[1],
+                                             cubic.coefficients()[2], cubic.coefficients()[3], 0., 0., 0.)),
+                         {-2., 0.5, 3.});
+            requireRoots(solve(Polynomial<5>(2., 0., 0., 0., 0., 0.)), {});
+        }
+
+        THEN("The Sturm solver agrees with the closed forms")
+        {
+            const Polynomial<4> quartic = fromRoots(4., -1., 0.25, 2.);
+            requireRoots(solveSturm(quartic), std::vector<double>(solve(quartic)));
+            const Polynomial<3> cubic = fromRoots(2.) * Polynomial<2>(1., 0., 1.);
+            requireRoots(solveSturm(cubic), std::vector<double>(solve(cubic)));
+        }
+
+        THEN("Close distinct roots are not merged")
+        {
+            // Degree 10, with two pairs of roots 2e-3 and 5e-3 apart among random roots.
+            // Polynomials whose values between two roots are within the round-off errors of their evaluation
+            // cannot separate them, and are skipped.
+            std::mt19937 engine{17};
+            std::uniform_real_distribution<double> distribution{-1., 1.};
+            int tested = 0;
+            while (tested != 2000)
+            {
+                std::vector<double> roots;
+                for (double gap : {2e-3, 5e-3})
+                {
+                    const double root = distribution(engine) * (1. - gap);
+                    roots.push_back(root);
+                    roots.push_back(root + gap);
+                }
+                while (roots.size() != 10)
+                {
+                    roots.push_back(distribution(engine));
+                }
+                const Polynomial<10> polynomial = fromRoots(roots[0], roots[1], roots[2], roots[3], roots[4],
+                                                            roots[5], roots[6], roots[7], roots[8], roots[9]);
+                std::sort(roots.begin(), roots.end());
+
+                bool separable = true;
+                for (std::size_t index = 1; index != roots.size(); ++index)
+                {
+                    const double middle = (roots[index - 1] + roots[index]) / 2;
+                    double value = 1.;
+                    double magnitude = 0.;
+                    for (double root : roots)
+                    {
+                        value *= middle - root;
+                    }
+                    for (int degree = 10; degree >= 0; --degree)
+                    {
+                        magnitude = magnitude * std::abs(middle) + std::abs(polynomial.coefficient(degree));
+                    }
+                    separable = separable
+                                && std::abs(value) > 20 * std::numeric_limits<double>::epsilon() * magnitude;
+                }
+                if (!separable)
+                {
+                    continue;
+                }
+
+                ++tested;
+                const Roots<10> found = solveSturm(polynomial);
+                REQUIRE(found.size() == roots.size());
+                for (std::size_t index = 0; index != roots.size(); ++index)
+                {
+                    REQUIRE(found[index] == Approx(roots[index]).margin(1e-6));
+                }
+            }
+        }
+
+        THEN("Batches of polynomials are solved as one by one, in parallel")
+        {
+            std::mt19937 engine{11};
+            std::uniform_real_distribution<double> distribution{-5., 5.};
+            std::vector<Polynomial<7>> polynomials;
+            for (std::size_t index = 0; index != 64; ++index)
+            {
+                polynomials.push_back(fromRoots(distribution(engine), distribution(engine), distribution(engine))
+                                      * Polynomial<4>(distribution(engine), distribution(engine),
+                                                      distribution(engine), distribution(engine), 1.));
+            }
+
+            std::size_t threadCount = GENERATE(1, 3);
+            std::vector<Roots<7>> results(polynomials.size());
+            solve(polynomials.data(), polynomials.size(), results.data(), threadCount);
+            for (std::size_t index = 0; index != polynomials.size(); ++index)
+            {
+                requireRoots(results[index], std::vector<double>(solve(polynomials[index])));
+                for (double root : results[index])
+                {
+                    REQUIRE(polynomials[index].evaluate(root) == Approx(0.).margin(1e-6));
+                }
+            }
+        }
+    }
 }
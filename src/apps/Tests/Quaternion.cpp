@@ -0,0 +1,159 @@
+#include "catch.hpp"
+
+#include <math/Constants.h>
+#include <math/Quaternion.h>
+#include <math/Transformations.h>
+
+#include <vector>
+
+
+using namespace ad::math;
+
+
+template <class T_derived, int N_rows, int N_cols>
+bool approxEqual(const MatrixBase<T_derived, N_rows, N_cols, double> & a,
+                 const MatrixBase<T_derived, N_rows, N_cols, double> & b,
+                 double aMargin = 1E-12)
+{
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(), [aMargin](auto left, auto right)
+            {
+                return Approx(left).margin(aMargin) == right;
+            });
+}
+
+
+#define APPROX_EQUAL(a, b)          \
+    {                               \
+        CAPTURE(a, b);              \
+        REQUIRE(approxEqual(a, b)); \
+    }
+
+
+SCENARIO("Quaternion rotations")
+{
+    GIVEN("A quaternion built from an angle and an axis")
+    {
+        const Degree<double> angle{70.};
+        const UnitVec<3> axis{Vec<3>{1., -2., 0.5}};
+        const Quaternion<double> rotation{angle, axis};
+
+        THEN("It is a unit quaternion")
+        {
+            REQUIRE(rotation.getNorm() == Approx(1.));
+        }
+
+        THEN("Its matrix is the matrix built by trans3d::rotate()")
+        {
+            APPROX_EQUAL(rotation.toRotationMatrix(), trans3d::rotate(angle, axis));
+        }
+
+        THEN("It rotates vectors like its matrix")
+        {
+            const Vec<3> vector{3., 0.2, -1.};
+            APPROX_EQUAL(rotation.rotate(vector), vector * trans3d::rotate(angle, axis));
+            APPROX_EQUAL(vector * rotation, vector * trans3d::rotate(angle, axis));
+        }
+
+        THEN("Its angle and axis can be retrieved")
+        {
+            REQUIRE(rotation.getAngle().value() == Approx(Radian<double>{angle}.value()));
+            APPROX_EQUAL(rotation.getAxis(), axis);
+        }
+
+        THEN("It can be retrieved from its matrix")
+        {
+            APPROX_EQUAL(Quaternion<double>{rotation.toRotationMatrix()}, rotation);
+        }
+
+        THEN("Its inverse undoes the rotation")
+        {
+            APPROX_EQUAL(rotation * rotation.inverse(), Quaternion<double>::Identity());
+            APPROX_EQUAL(rotation.conjugate(), rotation.inverse());
+        }
+
+        GIVEN("Another rotation")
+        {
+            const Quaternion<double> other{Radian<double>{-2.5}, UnitVec<3>{Vec<3>{0., 1., 1.}}};
+
+            THEN("Composition applies the left rotation first, like matrices")
+            {
+                APPROX_EQUAL((rotation * other).toRotationMatrix(),
+                             rotation.toRotationMatrix() * other.toRotationMatrix());
+            }
+        }
+    }
+
+    GIVEN("Rotation matrices for half-turns")
+    {
+        // Exercises each branch of the conversion from matrices
+        const std::vector<UnitVec<3>> axes{
+            UnitVec<3>{Vec<3>{1., 0., 0.}},
+            UnitVec<3>{Vec<3>{0., 1., 0.}},
+            UnitVec<3>{Vec<3>{0., 0., 1.}},
+            UnitVec<3>{Vec<3>{1., 1., 0.}},
+        };
+
+        THEN("Quaternions built from them give back the same matrices")
+        {
+            for (const auto & axis : axes)
+            {
+                Matrix<3, 3> matrix = trans3d::rotate(Radian<double>{pi<double>}, axis);
+                APPROX_EQUAL(Quaternion<double>{matrix}.toRotationMatrix(), matrix);
+            }
+        }
+    }
+}
+
+
+SCENARIO("Quaternion interpolations")
+{
+    GIVEN("Two rotations around the same axis")
+    {
+        const UnitVec<3> axis{Vec<3>{0., 0., 1.}};
+        const Quaternion<double> from{Degree<double>{10.}, axis};
+        const Quaternion<double> to{Degree<double>{130.}, axis};
+
+        THEN("Slerp interpolates the angle linearly")
+        {
+            APPROX_EQUAL(slerp(from, to, 0.25), (Quaternion<double>{Degree<double>{40.}, axis}));
+        }
+
+        THEN("Nlerp halfway is the halfway rotation")
+        {
+            APPROX_EQUAL(nlerp(from, to, 0.5), (Quaternion<double>{Degree<double>{70.}, axis}));
+        }
+
+        THEN("Interpolation takes the shortest path")
+        {
+            APPROX_EQUAL(slerp(from, -to, 0.25), (Quaternion<double>{Degree<double>{40.}, axis}));
+        }
+    }
+
+    GIVEN("Arrays of rotations")
+    {
+        std::vector<Quaternion<double>> from;
+        std::vector<Quaternion<double>> to;
+        for (int index = 0; index != 50; ++index)
+        {
+            from.emplace_back(Degree<double>{index * 7.}, UnitVec<3>{Vec<3>{1., index / 10., 0.}});
+            to.emplace_back(Degree<double>{index * -3.1}, UnitVec<3>{Vec<3>{0., 1., index / 20.}});
+        }
+        // Nearly equal quaternions, for the linear fallback
+        from.push_back(Quaternion<double>::Identity());
+        to.emplace_back(Degree<double>{0.1}, UnitVec<3>{Vec<3>{0., 1., 0.}});
+
+        THEN("Batch interpolations match the individual ones")
+        {
+            std::vector<Quaternion<double>> slerped(from.size(), Quaternion<double>::Identity());
+            std::vector<Quaternion<double>> nlerped(from.size(), Quaternion<double>::Identity());
+            slerp(from.data(), to.data(), 0.3, from.size(), slerped.data());
+            nlerp(from.data(), to.data(), 0.3, from.size(), nlerped.data());
+
+            for (std::size_t index = 0; index != from.size(); ++index)
+            {
+                APPROX_EQUAL(slerped[index], slerp(from[index], to[index], 0.3));
+                APPROX_EQUAL(nlerped[index], nlerp(from[index], to[index], 0.3));
+            }
+        }
+    }
+}
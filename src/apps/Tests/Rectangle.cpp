@@ -2,6 +2,8 @@
 
 #include <math/Rectangle.h>
 
+#include <vector>
+
 using namespace ad::math;
 
 
@@ -88,3 +90,76 @@ SCENARIO("Rectangle usage")
         }
     }
 }
+
+
+SCENARIO("Rectangle batch inclusion tests")
+{
+    GIVEN("A rectangle and positions stored as separate X and Y arrays")
+    {
+        Rectangle<double> rect{ {0., 5.}, {20., 30.} };
+
+        // Not a multiple of 64, to exercise the last partial word
+        const std::size_t count = 100;
+        std::vector<double> x, y;
+        for (std::size_t index = 0; index != count; ++index)
+        {
+            x.push_back(-5. + (index % 10) * 3.);
+            y.push_back(index * 0.5);
+        }
+
+        WHEN("The inclusion of all positions is tested at once")
+        {
+            std::vector<std::uint64_t> results(bitmaskWordCount(count));
+            rect.contains(x.data(), y.data(), count, results.data());
+
+            THEN("Each bit is the result of the individual test")
+            {
+                for (std::size_t index = 0; index != count; ++index)
+                {
+                    CAPTURE(index);
+                    REQUIRE(testBit(results.data(), index) == rect.contains(Position<2>{x[index], y[index]}));
+                }
+                REQUIRE((results.back() >> (count % 64)) == 0);
+            }
+
+            THEN("The bitmask can be turned into the list of contained positions")
+            {
+                std::vector<std::size_t> indices(count);
+                indices.resize(bitmaskToIndices(results.data(), count, indices.data()));
+
+                std::vector<std::size_t> expected;
+                for (std::size_t index = 0; index != count; ++index)
+                {
+                    if (rect.contains(Position<2>{x[index], y[index]}))
+                    {
+                        expected.push_back(index);
+                    }
+                }
+                REQUIRE(!expected.empty());
+                REQUIRE(indices == expected);
+            }
+        }
+    }
+
+    GIVEN("Several rectangles and a position")
+    {
+        std::vector<Rectangle<int>> rectangles;
+        for (int index = 0; index != 70; ++index)
+        {
+            rectangles.push_back({ {index - 10, index % 3}, {10, 10} });
+        }
+        const Position<2, int> position{5, 10};
+
+        THEN("The rectangles containing the position are found at once")
+        {
+            std::vector<std::uint64_t> results(bitmaskWordCount(rectangles.size()));
+            contains(rectangles.data(), rectangles.size(), position, results.data());
+
+            for (std::size_t index = 0; index != rectangles.size(); ++index)
+            {
+                CAPTURE(index);
+                REQUIRE(testBit(results.data(), index) == rectangles[index].contains(position));
+            }
+        }
+    }
+}
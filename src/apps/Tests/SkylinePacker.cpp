@@ -0,0 +1,171 @@
+#include "catch.hpp"
+
+#include <math/SkylinePacker.h>
+
+#include <random>
+#include <vector>
+
+
+using namespace ad::math;
+
+
+namespace {
+
+    bool overlap(const Rectangle<int> & aLhs, const Rectangle<int> & aRhs)
+    {
+        return aLhs.xMin() < aRhs.xMax() && aRhs.xMin() < aLhs.xMax()
+            && aLhs.yMin() < aRhs.yMax() && aRhs.yMin() < aLhs.yMax();
+    }
+
+    // Placements are inside their bin, and do not overlap within a bin.
+    void checkPlacements(const std::vector<SkylinePacker<int>::Placement> & aPlacements,
+                         const std::vector<Size<2, int>> & aSizes,
+                         Size<2, int> aBinSize)
+    {
+        for (std::size_t index = 0; index != aPlacements.size(); ++index)
+        {
+            const Rectangle<int> & rectangle = aPlacements[index].rectangle;
+            REQUIRE(rectangle.mDimension == aSizes[index]);
+            REQUIRE(rectangle.xMin() >= 0);
+            REQUIRE(rectangle.yMin() >= 0);
+            REQUIRE(rectangle.xMax() <= aBinSize.width());
+            REQUIRE(rectangle.yMax() <= aBinSize.height());
+            for (std::size_t other = 0; other != index; ++other)
+            {
+                if (aPlacements[other].bin == aPlacements[index].bin)
+                {
+                    REQUIRE_FALSE(overlap(rectangle, aPlacements[other].rectangle));
+                }
+            }
+        }
+    }
+
+} // anonymous namespace
+
+
+SCENARIO("Skyline rectangle packing")
+{
+    std::mt19937 engine{11};
+    std::uniform_int_distribution<int> dimension{4, 40};
+
+    GIVEN("Random sizes, packed as a batch")
+    {
+        const Size<2, int> binSize{256, 256};
+        std::vector<Size<2, int>> sizes;
+        for (int index = 0; index != 600; ++index)
+        {
+            sizes.push_back({dimension(engine), dimension(engine)});
+        }
+
+        SkylinePacker<int> packer{binSize};
+        std::vector<SkylinePacker<int>::Placement> placements = packer.insert(sizes.data(), sizes.size());
+        REQUIRE(placements.size() == sizes.size());
+
+        THEN("All rectangles are placed without overlap, over several well occupied bins")
+        {
+            checkPlacements(placements, sizes, binSize);
+            for (const auto & placement : placements)
+            {
+                REQUIRE(placement.bin < packer.getBinCount());
+            }
+            REQUIRE(packer.getBinCount() > 1);
+            for (std::size_t bin = 0; bin + 1 < packer.getBinCount(); ++bin)
+            {
+                REQUIRE(packer.getOccupancy(bin) > 0.8);
+            }
+        }
+    }
+
+    GIVEN("Random sizes, inserted one at a time")
+    {
+        const Size<2, int> binSize{200, 150};
+        std::vector<Size<2, int>> sizes;
+        std::vector<SkylinePacker<int>::Placement> placements;
+        SkylinePacker<int> packer{binSize};
+        for (int index = 0; index != 300; ++index)
+        {
+            sizes.push_back({dimension(engine), dimension(engine)});
+            auto placement = packer.insert(sizes.back());
+            REQUIRE(placement);
+            placements.push_back(*placement);
+        }
+
+        THEN("All rectangles are placed without overlap")
+        {
+            checkPlacements(placements, sizes, binSize);
+        }
+    }
+
+    GIVEN("A packer limited to a single bin")
+    {
+        SkylinePacker<int> packer{{10, 10}, 1};
+
+        THEN("Rectangles are placed bottom-left, until the bin is full")
+        {
+            REQUIRE(packer.insert({6, 4})->rectangle == Rectangle<int>{{0, 0}, {6, 4}});
+            REQUIRE(packer.insert({4, 2})->rectangle == Rectangle<int>{{6, 0}, {4, 2}});
+            REQUIRE(packer.insert({4, 3})->rectangle == Rectangle<int>{{6, 2}, {4, 3}});
+            REQUIRE(packer.insert({10, 5})->rectangle == Rectangle<int>{{0, 5}, {10, 5}});
+            REQUIRE(packer.getOccupancy(0) == Approx(0.94));
+
+            // The gap left below the last rectangle is not reachable anymore
+            REQUIRE_FALSE(packer.insert({6, 1}));
+            REQUIRE(packer.getBinCount() == 1);
+        }
+
+        THEN("Rectangles larger than the bin are rejected")
+        {
+            REQUIRE_FALSE(packer.insert({11, 1}));
+            REQUIRE_FALSE(packer.insert({1, 11}));
+            REQUIRE(packer.getBinCount() == 0);
+        }
+
+        THEN("Batch insertion marks the rectangles that could not be placed")
+        {
+            std::vector<Size<2, int>> sizes{{10, 10}, {4, 4}};
+            std::vector<SkylinePacker<int>::Placement> placements = packer.insert(sizes.data(), sizes.size());
+            REQUIRE(placements[0].bin == 0);
+            REQUIRE(placements[1].bin == SkylinePacker<int>::gNoBin);
+            REQUIRE(placements[1].rectangle.mDimension == sizes[1]);
+        }
+    }
+
+    GIVEN("Empty sizes")
+    {
+        SkylinePacker<int> packer{{10, 10}};
+
+        THEN("They are rejected while no bin is open")
+        {
+            REQUIRE_FALSE(packer.insert({0, 5}));
+            REQUIRE_FALSE(packer.insert({5, 0}));
+            REQUIRE(packer.getBinCount() == 0);
+        }
+
+        THEN("They are placed at the origin of the last bin, without opening a bin")
+        {
+            packer.insert({10, 10});
+            REQUIRE(packer.insert({0, 5})->rectangle == Rectangle<int>{{0, 0}, {0, 5}});
+            REQUIRE(packer.insert({5, 0})->bin == 0);
+            REQUIRE(packer.getBinCount() == 1);
+            REQUIRE(packer.getOccupancy(0) == 1.);
+        }
+    }
+
+    GIVEN("Rectangles of the exact bin size")
+    {
+        SkylinePacker<int> packer{{8, 8}};
+
+        THEN("Each one opens a new bin")
+        {
+            std::vector<Size<2, int>> sizes(3, Size<2, int>{8, 8});
+            std::vector<SkylinePacker<int>::Placement> placements = packer.insert(sizes.data(), sizes.size());
+            REQUIRE(placements[0].bin == 0);
+            REQUIRE(placements[2].bin == 2);
+            REQUIRE(packer.getBinCount() == 3);
+            REQUIRE(packer.getOccupancy(2) == 1.);
+
+            packer.clear();
+            REQUIRE(packer.getBinCount() == 0);
+        }
+    }
+}
@@ -0,0 +1,126 @@
+#include "catch.hpp"
+
+#include <math/SpatialHashGrid.h>
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+
+using namespace ad::math;
+
+
+namespace {
+
+    template <int N_dimension>
+    std::vector<Position<N_dimension, float>> randomPositions(std::size_t aCount, std::mt19937 & aEngine)
+    {
+        std::uniform_real_distribution<float> coordinate{-20.f, 20.f};
+        std::vector<Position<N_dimension, float>> result;
+        for (std::size_t index = 0; index != aCount; ++index)
+        {
+            Position<N_dimension, float> position = Position<N_dimension, float>::Zero();
+            for (std::size_t axis = 0; axis != N_dimension; ++axis)
+            {
+                position[axis] = coordinate(aEngine);
+            }
+            result.push_back(position);
+        }
+        return result;
+    }
+
+    template <int N_dimension>
+    std::vector<std::uint32_t> bruteForce(const std::vector<Position<N_dimension, float>> & aPositions,
+                                          const Position<N_dimension, float> & aCenter,
+                                          float aRadius)
+    {
+        std::vector<std::uint32_t> result;
+        for (std::uint32_t index = 0; index != aPositions.size(); ++index)
+        {
+            if ((aPositions[index] - aCenter).getNormSquared() <= aRadius * aRadius)
+            {
+                result.push_back(index);
+            }
+        }
+        return result;
+    }
+
+} // anonymous namespace
+
+
+SCENARIO("Spatial hash grid neighbour queries")
+{
+    std::mt19937 engine{3};
+
+    GIVEN("Points in 2D, hashed into few buckets")
+    {
+        // Few buckets, so many cells collide
+        SpatialHashGrid<2, float> grid{2.f, 16};
+        std::vector<Position<2, float>> positions = randomPositions<2>(2000, engine);
+        grid.rebuild(positions.data(), positions.size());
+        REQUIRE(grid.size() == 2000);
+
+        THEN("Radius queries match a linear scan, without duplicates")
+        {
+            for (float radius : {0.5f, 2.f, 5.f})
+            {
+                for (const Position<2, float> & center : randomPositions<2>(20, engine))
+                {
+                    std::vector<std::uint32_t> found;
+                    grid.forEachNeighbour(center, radius, [&](std::uint32_t aIndex, float aSquaredDistance)
+                    {
+                        REQUIRE(aSquaredDistance == (positions[aIndex] - center).getNormSquared());
+                        found.push_back(aIndex);
+                    });
+                    std::sort(found.begin(), found.end());
+                    REQUIRE(found == bruteForce(positions, center, radius));
+                }
+            }
+        }
+
+        WHEN("The points move and the grid is rebuilt")
+        {
+            for (Position<2, float> & position : positions)
+            {
+                position += Vec<2, float>{30.f, -7.f};
+            }
+            grid.rebuild(positions.data(), positions.size());
+
+            THEN("Queries find the points at their new positions")
+            {
+                const Position<2, float> center{30.f, -7.f};
+                std::vector<std::uint32_t> found;
+                grid.forEachNeighbour(center, 3.f, [&](std::uint32_t aIndex, float){ found.push_back(aIndex); });
+                std::sort(found.begin(), found.end());
+                REQUIRE(found == bruteForce(positions, center, 3.f));
+            }
+        }
+    }
+
+    GIVEN("Points in 3D")
+    {
+        SpatialHashGrid<3, float> grid{1.5f, 4096};
+        const std::vector<Position<3, float>> positions = randomPositions<3>(3000, engine);
+        grid.rebuild(positions.data(), positions.size());
+
+        THEN("The parallel pair iteration visits each neighbour of each point, excluding itself")
+        {
+            const float radius = 1.5f;
+            std::vector<std::vector<std::uint32_t>> neighbours(positions.size());
+            // Calls for a given point all come from a single thread
+            grid.forEachNeighbourPair(radius, 4, [&](std::uint32_t aPoint, std::uint32_t aNeighbour, float)
+            {
+                neighbours[aPoint].push_back(aNeighbour);
+            });
+
+            for (std::uint32_t point = 0; point != positions.size(); ++point)
+            {
+                std::vector<std::uint32_t> expected = bruteForce(positions, positions[point], radius);
+                expected.erase(std::find(expected.begin(), expected.end(), point));
+                std::sort(neighbours[point].begin(), neighbours[point].end());
+                REQUIRE(neighbours[point] == expected);
+            }
+        }
+    }
+}
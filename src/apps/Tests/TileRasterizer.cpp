@@ -0,0 +1,188 @@
+#include "catch.hpp"
+
+#include <math/TileRasterizer.h>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+
+using namespace ad::math;
+
+
+namespace {
+
+    using Rasterizer = TileRasterizer<float>;
+
+    struct Scene
+    {
+        std::vector<Position<2, float>> vertices;
+        std::vector<float> depths;
+
+        std::size_t size() const
+        { return depths.size() / 3; }
+
+        Barycentric<float> barycentric(std::size_t aTriangle) const
+        {
+            return {static_cast<Vec<2, float>>(vertices[3 * aTriangle]),
+                    static_cast<Vec<2, float>>(vertices[3 * aTriangle + 1]),
+                    static_cast<Vec<2, float>>(vertices[3 * aTriangle + 2])};
+        }
+
+        float depth(std::size_t aTriangle, const Barycentric<float>::Coordinates & aCoordinates) const
+        {
+            return aCoordinates.alpha * depths[3 * aTriangle]
+                   + aCoordinates.beta * depths[3 * aTriangle + 1]
+                   + aCoordinates.gamma * depths[3 * aTriangle + 2];
+        }
+    };
+
+    // Triangles of various sizes, some partially or entirely outside of the target, and a degenerate one.
+    Scene randomScene(std::size_t aCount, int aWidth, int aHeight, std::mt19937 & aEngine)
+    {
+        std::uniform_real_distribution<float> x{-20.f, aWidth + 20.f};
+        std::uniform_real_distribution<float> y{-20.f, aHeight + 20.f};
+        std::uniform_real_distribution<float> offset{-1.f, 1.f};
+        std::uniform_real_distribution<float> depth{0.f, 1.f};
+        const float sizes[] = {3.f, 15.f, 80.f};
+
+        Scene result;
+        for (std::size_t triangle = 0; triangle != aCount; ++triangle)
+        {
+            const float size = sizes[triangle % 3];
+            const Position<2, float> center{x(aEngine), y(aEngine)};
+            for (int vertex = 0; vertex != 3; ++vertex)
+            {
+                result.vertices.push_back(center + Vec<2, float>{offset(aEngine), offset(aEngine)} * size);
+                result.depths.push_back(depth(aEngine));
+            }
+        }
+        result.vertices.push_back({1.f, 1.f});
+        result.vertices.push_back({5.f, 5.f});
+        result.vertices.push_back({9.f, 9.f});
+        result.depths.insert(result.depths.end(), {0.f, 0.f, 0.f});
+        return result;
+    }
+
+    bool isOnEdge(const Barycentric<float>::Coordinates & aCoordinates)
+    {
+        const float epsilon = 1e-4f;
+        return std::min({aCoordinates.alpha, aCoordinates.beta, aCoordinates.gamma}) > -epsilon
+            && std::min({aCoordinates.alpha, aCoordinates.beta, aCoordinates.gamma}) < epsilon;
+    }
+
+    // Compares to a per pixel evaluation of all triangles.
+    // Results can only differ where rounding makes the outcome ambiguous: samples on an edge, or equal depths.
+    void checkAgainstReference(const Rasterizer & aRasterizer, const Scene & aScene)
+    {
+        std::size_t coveredCount = 0;
+        for (int y = 0; y != aRasterizer.getHeight(); ++y)
+        {
+            for (int x = 0; x != aRasterizer.getWidth(); ++x)
+            {
+                const Vec<2, float> sample{x + 0.5f, y + 0.5f};
+                std::size_t expected = Rasterizer::gNoTriangle;
+                float expectedDepth = std::numeric_limits<float>::infinity();
+                // The degenerate triangle is skipped
+                for (std::size_t triangle = 0; triangle + 1 < aScene.size(); ++triangle)
+                {
+                    auto coordinates = aScene.barycentric(triangle).getCoordinates(sample);
+                    if (coordinates.alpha >= 0 && coordinates.beta >= 0 && coordinates.gamma >= 0
+                        && aScene.depth(triangle, coordinates) < expectedDepth)
+                    {
+                        expected = triangle;
+                        expectedDepth = aScene.depth(triangle, coordinates);
+                    }
+                }
+
+                const Rasterizer::TriangleIndex triangle = aRasterizer.getTriangle(x, y);
+                if (triangle == expected)
+                {
+                    if (triangle != Rasterizer::gNoTriangle)
+                    {
+                        ++coveredCount;
+                        auto coordinates = aScene.barycentric(triangle).getCoordinates(sample);
+                        REQUIRE(aRasterizer.getDepth(x, y) == Approx(expectedDepth).margin(1e-4));
+                        REQUIRE(aRasterizer.getCoordinates(x, y).beta == Approx(coordinates.beta).margin(1e-4));
+                        REQUIRE(aRasterizer.getCoordinates(x, y).gamma == Approx(coordinates.gamma).margin(1e-4));
+                    }
+                    else
+                    {
+                        REQUIRE(aRasterizer.getDepth(x, y) == std::numeric_limits<float>::infinity());
+                    }
+                }
+                else
+                {
+                    bool ambiguous = (expected != Rasterizer::gNoTriangle
+                                      && isOnEdge(aScene.barycentric(expected).getCoordinates(sample)))
+                                  || (triangle != Rasterizer::gNoTriangle
+                                      && isOnEdge(aScene.barycentric(triangle).getCoordinates(sample)));
+                    if (expected != Rasterizer::gNoTriangle && triangle != Rasterizer::gNoTriangle)
+                    {
+                        ambiguous = ambiguous || std::abs(aRasterizer.getDepth(x, y) - expectedDepth) < 1e-4f;
+                    }
+                    REQUIRE(ambiguous);
+                }
+            }
+        }
+        // The scene covers a good share of the target
+        REQUIRE(coveredCount > static_cast<std::size_t>(aRasterizer.getWidth() * aRasterizer.getHeight() / 2));
+    }
+
+} // anonymous namespace
+
+
+SCENARIO("Tiled triangle rasterization")
+{
+    std::mt19937 engine{13};
+
+    GIVEN("A random scene")
+    {
+        const int tileSize = GENERATE(8, 64);
+        const std::size_t threadCount = GENERATE(1, 4);
+
+        Rasterizer rasterizer{150, 100, tileSize};
+        Scene scene = randomScene(150, rasterizer.getWidth(), rasterizer.getHeight(), engine);
+        rasterizer.rasterize(scene.vertices.data(), scene.depths.data(), scene.size(), threadCount);
+
+        THEN("The closest triangle at each pixel matches a per pixel evaluation")
+        {
+            checkAgainstReference(rasterizer, scene);
+        }
+
+        THEN("Rasterizing again clears the previous result")
+        {
+            Scene other = randomScene(60, rasterizer.getWidth(), rasterizer.getHeight(), engine);
+            rasterizer.rasterize(other.vertices.data(), other.depths.data(), other.size(), threadCount);
+            checkAgainstReference(rasterizer, other);
+        }
+    }
+
+    GIVEN("Two triangles sharing an edge, as Vec")
+    {
+        Rasterizer rasterizer{16, 16, 8};
+        std::vector<Vec<2, float>> vertices{
+            {0.f, 0.f}, {16.f, 0.f}, {0.f, 16.f},
+            {16.f, 0.f}, {16.f, 16.f}, {0.f, 16.f},
+        };
+        std::vector<float> depths{1.f, 1.f, 1.f, 0.5f, 0.5f, 0.5f};
+        rasterizer.rasterize(vertices.data(), depths.data(), 2, 1);
+
+        THEN("The pixels are covered by the closest triangle")
+        {
+            REQUIRE(rasterizer.getTriangle(0, 0) == 0);
+            REQUIRE(rasterizer.getTriangle(15, 15) == 1);
+            // Centers on the shared edge are covered by both triangles
+            REQUIRE(rasterizer.getTriangle(7, 8) == 1);
+            REQUIRE(rasterizer.getTriangle(7, 7) == 0);
+            REQUIRE(rasterizer.getDepth(0, 0) == 1.f);
+            REQUIRE(rasterizer.getDepth(15, 15) == 0.5f);
+
+            auto coordinates = rasterizer.getCoordinates(0, 0);
+            REQUIRE(coordinates.beta == Approx(0.5f / 16));
+            REQUIRE(coordinates.gamma == Approx(0.5f / 16));
+            REQUIRE(coordinates.alpha == Approx(1.f - 1.f / 16));
+        }
+    }
+}
@@ -0,0 +1,200 @@
+#include "catch.hpp"
+
+#include <math/Angle.h>
+#include <math/TransformHierarchy.h>
+#include <math/Transformations.h>
+
+
+using namespace ad::math;
+
+
+namespace {
+
+
+Affine<3> makeLocal(std::size_t aSeed)
+{
+    return {
+        trans3d::rotateZ(Degree<double>{10. * aSeed}) * trans3d::rotateX(Degree<double>{3. * aSeed}),
+        Vec<3>{1. * aSeed, -0.5 * aSeed, 2.}
+    };
+}
+
+
+// Computes the world transformation by walking up the hierarchy
+Affine<3> expectedWorld(const TransformHierarchy<> & aHierarchy, std::size_t aNode)
+{
+    Affine<3> world = aHierarchy.getLocal(aNode);
+    for (std::size_t parent = aHierarchy.getParent(aNode);
+         parent != TransformHierarchy<>::gNoParent;
+         parent = aHierarchy.getParent(parent))
+    {
+        world *= aHierarchy.getLocal(parent);
+    }
+    return world;
+}
+
+
+bool approxEqual(const Affine<3> & a, const Affine<3> & b)
+{
+    auto approx = [](double left, double right)
+    {
+        return Approx(left).margin(1E-9) == right;
+    };
+    return std::equal(a.linear().begin(), a.linear().end(), b.linear().begin(), approx)
+        && std::equal(a.translation().begin(), a.translation().end(), b.translation().begin(), approx);
+}
+
+
+void checkWorlds(const TransformHierarchy<> & aHierarchy)
+{
+    for (std::size_t node = 0; node != aHierarchy.size(); ++node)
+    {
+        CAPTURE(node);
+        REQUIRE(approxEqual(aHierarchy.getWorld(node), expectedWorld(aHierarchy, node)));
+    }
+}
+
+
+} // anonymous namespace
+
+
+SCENARIO("Transform hierarchies")
+{
+    GIVEN("A hierarchy made of several trees")
+    {
+        TransformHierarchy<> hierarchy;
+        // Each node has the parent (index - 1) / 3, except every 40th node which is a new root
+        for (std::size_t node = 0; node != 200; ++node)
+        {
+            std::size_t parent = (node % 40 == 0) ? TransformHierarchy<>::gNoParent : (node - 1) / 3;
+            hierarchy.addNode(makeLocal(node), parent);
+        }
+
+        WHEN("It is updated")
+        {
+            hierarchy.update();
+
+            THEN("World transformations compose the local transformations of ancestors")
+            {
+                checkWorlds(hierarchy);
+            }
+
+            WHEN("An inner node is modified")
+            {
+                const Affine<3> unrelatedWorld = hierarchy.getWorld(2);
+
+                hierarchy.setLocal(1, makeLocal(1000));
+                hierarchy.update();
+
+                THEN("Its descendants world transformations are updated")
+                {
+                    checkWorlds(hierarchy);
+                    REQUIRE(hierarchy.getWorld(2) == unrelatedWorld);
+                }
+            }
+
+            WHEN("Nodes are modified and added, then updated on several threads")
+            {
+                hierarchy.setLocal(0, makeLocal(2000));
+                hierarchy.setLocal(95, makeLocal(3000));
+                hierarchy.addNode(makeLocal(4000), 150);
+                hierarchy.addNode(makeLocal(5000));
+
+                hierarchy.update(4);
+
+                THEN("World transformations are all up to date")
+                {
+                    checkWorlds(hierarchy);
+                }
+            }
+        }
+
+        WHEN("It is updated on several threads")
+        {
+            hierarchy.update(3);
+
+            THEN("World transformations compose the local transformations of ancestors")
+            {
+                checkWorlds(hierarchy);
+            }
+        }
+    }
+
+    GIVEN("A hierarchy made of a single large tree")
+    {
+        TransformHierarchy<> serial;
+        TransformHierarchy<> threaded;
+        // Each node has the parent (index - 1) / 4, under a single root
+        for (std::size_t node = 0; node != 2000; ++node)
+        {
+            std::size_t parent = (node == 0) ? TransformHierarchy<>::gNoParent : (node - 1) / 4;
+            serial.addNode(makeLocal(node), parent);
+            threaded.addNode(makeLocal(node), parent);
+        }
+
+        auto requireSameWorlds = [&]()
+        {
+            for (std::size_t node = 0; node != serial.size(); ++node)
+            {
+                CAPTURE(node);
+                REQUIRE(threaded.getWorld(node) == serial.getWorld(node));
+            }
+        };
+
+        std::size_t threadCount = GENERATE(2, 3, 8);
+        serial.update();
+        threaded.update(threadCount);
+
+        THEN("The threaded update matches the serial update")
+        {
+            requireSameWorlds();
+            checkWorlds(threaded);
+        }
+
+        WHEN("Nodes at different depths are modified and added")
+        {
+            for (TransformHierarchy<> * hierarchy : {&serial, &threaded})
+            {
+                hierarchy->setLocal(0, makeLocal(2000));
+                hierarchy->setLocal(7, makeLocal(3000));
+                hierarchy->setLocal(1500, makeLocal(4000));
+                hierarchy->addNode(makeLocal(5000), 30);
+            }
+            serial.update();
+            threaded.update(threadCount);
+
+            THEN("The threaded update still matches the serial update")
+            {
+                requireSameWorlds();
+            }
+
+            WHEN("Only a leaf is modified")
+            {
+                for (TransformHierarchy<> * hierarchy : {&serial, &threaded})
+                {
+                    hierarchy->setLocal(1999, makeLocal(6000));
+                }
+                serial.update();
+                threaded.update(threadCount);
+
+                THEN("The threaded update still matches the serial update")
+                {
+                    requireSameWorlds();
+                }
+            }
+        }
+    }
+
+    GIVEN("A hierarchy of homogeneous matrices")
+    {
+        TransformHierarchy<Matrix<4, 4>> hierarchy;
+        auto root = hierarchy.addNode(Affine<3>::Translation({1., 2., 3.}).toMatrix());
+        auto child = hierarchy.addNode(Affine<3>{trans3d::scale(2., 2., 2.)}.toMatrix(), root);
+        hierarchy.update();
+
+        THEN("The child world transformation is computed")
+        {
+            REQUIRE(hierarchy.getWorld(child) == (Affine<3>{trans3d::scale(2., 2., 2.), {1., 2., 3.}}.toMatrix()));
+        }
+    }
+}
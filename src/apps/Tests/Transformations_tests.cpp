@@ -664,3 +664,66 @@ SCENARIO("3D shearing")
         }
     }
 }
+
+
+SCENARIO("3D camera transformations")
+{
+    // Normalized device coordinates of a position transformed by a homogeneous matrix
+    auto toNdc = [](Position<3> aPosition, const Matrix<4, 4> & aMatrix)
+    {
+        Vec<4> clip = Vec<4>{aPosition.x(), aPosition.y(), aPosition.z(), 1.} * aMatrix;
+        return Vec<3>{clip.x(), clip.y(), clip.z()} / clip.w();
+    };
+
+    GIVEN("A perspective projection")
+    {
+        const double near = 0.5;
+        const double far = 100.;
+        const double aspectRatio = 2.;
+        Matrix<4, 4> projection = trans3d::perspective(Degree<double>{90.}, aspectRatio, near, far);
+
+        THEN("The near and far planes are mapped to -1 and 1 depths")
+        {
+            REQUIRE(toNdc({0., 0., -near}, projection).z() == Approx(-1.));
+            REQUIRE(toNdc({0., 0., -far}, projection).z() == Approx(1.));
+        }
+
+        THEN("The field of view is mapped to the [-1, 1] range")
+        {
+            // 90° vertical field of view: the top edge is at y == distance
+            Vec<3> topRight = toNdc({10. * aspectRatio, 10., -10.}, projection);
+            REQUIRE(topRight.x() == Approx(1.));
+            REQUIRE(topRight.y() == Approx(1.));
+        }
+    }
+
+    GIVEN("An orthographic projection")
+    {
+        Matrix<4, 4> projection = trans3d::orthographic(-2., 4., -1., 3., 1., 11.);
+
+        THEN("The box corners are mapped to the NDC cube corners")
+        {
+            APPROX_EQUAL(toNdc({-2., -1., -1.}, projection), (Vec<3>{-1., -1., -1.}));
+            APPROX_EQUAL(toNdc({4., 3., -11.}, projection), (Vec<3>{1., 1., 1.}));
+            APPROX_EQUAL(toNdc({1., 1., -6.}, projection), (Vec<3>{0., 0., 0.}));
+        }
+    }
+
+    GIVEN("A view matrix looking from (0, 0, 5) at (5, 0, 5), up being +Y")
+    {
+        Matrix<4, 4> view = trans3d::lookAt(Position<3>{0., 0., 5.}, Position<3>{5., 0., 5.}, Vec<3>{0., 1., 0.});
+
+        THEN("The eye is at the origin of view space")
+        {
+            APPROX_EQUAL(toNdc({0., 0., 5.}, view), (Vec<3>{0., 0., 0.}));
+        }
+
+        THEN("The target is down -Z and up is +Y")
+        {
+            APPROX_EQUAL(toNdc({5., 0., 5.}, view), (Vec<3>{0., 0., -5.}));
+            APPROX_EQUAL(toNdc({0., 2., 5.}, view), (Vec<3>{0., 2., 0.}));
+            // Right of the camera is +X
+            APPROX_EQUAL(toNdc({0., 0., 6.}, view), (Vec<3>{1., 0., 0.}));
+        }
+    }
+}
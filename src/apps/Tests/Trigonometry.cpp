@@ -0,0 +1,154 @@
+#include "catch.hpp"
+
+#include <math/Constants.h>
+#include <math/Trigonometry.h>
+
+#include <limits>
+#include <vector>
+
+#include <cmath>
+
+
+using namespace ad::math;
+
+
+namespace {
+
+
+    template <template <class> class TT_angle, class T_number>
+    std::vector<TT_angle<T_number>> sampleAngles(T_number aLimit, std::size_t aCount)
+    {
+        std::vector<TT_angle<T_number>> result;
+        for (std::size_t index = 0; index != aCount; ++index)
+        {
+            result.emplace_back(-aLimit + 2 * aLimit * static_cast<T_number>(index)
+                                                     / static_cast<T_number>(aCount - 1));
+        }
+        return result;
+    }
+
+
+    template <TrigonometryAccuracy N_accuracy, class T_number, class T_unitTag>
+    void checkBatch(const std::vector<Angle<T_number, T_unitTag>> & aAngles, double aMargin)
+    {
+        std::vector<T_number> sines(aAngles.size());
+        std::vector<T_number> cosines(aAngles.size());
+
+        sin<N_accuracy>(aAngles.data(), aAngles.size(), sines.data());
+        cos<N_accuracy>(aAngles.data(), aAngles.size(), cosines.data());
+
+        for (std::size_t index = 0; index != aAngles.size(); ++index)
+        {
+            CAPTURE(aAngles[index]);
+            REQUIRE(sines[index] == Approx(sin(aAngles[index])).margin(aMargin));
+            REQUIRE(cosines[index] == Approx(cos(aAngles[index])).margin(aMargin));
+        }
+    }
+
+
+    template <TrigonometryAccuracy N_accuracy, class T_number, class T_unitTag>
+    void checkOutOfDomain(const std::vector<Angle<T_number, T_unitTag>> & aAngles)
+    {
+        std::vector<T_number> sines(aAngles.size());
+        std::vector<T_number> cosines(aAngles.size());
+
+        sin<N_accuracy>(aAngles.data(), aAngles.size(), sines.data());
+        cos<N_accuracy>(aAngles.data(), aAngles.size(), cosines.data());
+
+        for (std::size_t index = 0; index != aAngles.size(); ++index)
+        {
+            CAPTURE(aAngles[index]);
+            REQUIRE(std::isnan(sines[index]));
+            REQUIRE(std::isnan(cosines[index]));
+        }
+    }
+
+
+} // anonymous namespace
+
+
+SCENARIO("Batch trigonometry")
+{
+    GIVEN("Radian<float> angles over several turns")
+    {
+        auto angles = sampleAngles<Radian>(10 * pi<float>, 1001);
+
+        THEN("Each accuracy tier matches the standard functions within its bound")
+        {
+            checkBatch<TrigonometryAccuracy::Precise>(angles, 1E-7);
+            checkBatch<TrigonometryAccuracy::Balanced>(angles, 2E-7);
+            checkBatch<TrigonometryAccuracy::Fast>(angles, 5E-6);
+        }
+    }
+
+    GIVEN("Radian<double> angles over several turns")
+    {
+        auto angles = sampleAngles<Radian>(10 * pi<double>, 1001);
+
+        THEN("Each accuracy tier matches the standard functions within its bound")
+        {
+            checkBatch<TrigonometryAccuracy::Precise>(angles, 1E-15);
+            checkBatch<TrigonometryAccuracy::Balanced>(angles, 1E-15);
+            checkBatch<TrigonometryAccuracy::Fast>(angles, 5E-6);
+        }
+    }
+
+    GIVEN("Degree<double> angles")
+    {
+        auto angles = sampleAngles<Degree>(720., 145);
+
+        THEN("They are converted to radians before evaluation")
+        {
+            checkBatch<TrigonometryAccuracy::Precise>(angles, 1E-15);
+        }
+    }
+
+    GIVEN("Angles outside of the domain of range reduction")
+    {
+        const std::vector<Radian<double>> angles{
+            Radian<double>{std::numeric_limits<double>::infinity()},
+            Radian<double>{-std::numeric_limits<double>::infinity()},
+            Radian<double>{std::numeric_limits<double>::quiet_NaN()},
+            Radian<double>{1E10},
+            Radian<double>{-3E9},
+        };
+        std::vector<Radian<float>> floatAngles;
+        for (Radian<double> angle : angles)
+        {
+            floatAngles.emplace_back(static_cast<float>(angle.value()));
+        }
+
+        THEN("Each accuracy tier returns NaN")
+        {
+            checkOutOfDomain<TrigonometryAccuracy::Precise>(angles);
+            checkOutOfDomain<TrigonometryAccuracy::Balanced>(angles);
+            checkOutOfDomain<TrigonometryAccuracy::Fast>(angles);
+            checkOutOfDomain<TrigonometryAccuracy::Precise>(floatAngles);
+            checkOutOfDomain<TrigonometryAccuracy::Balanced>(floatAngles);
+            checkOutOfDomain<TrigonometryAccuracy::Fast>(floatAngles);
+        }
+    }
+
+    GIVEN("Values covering the three reductions of atan")
+    {
+        std::vector<Radian<float>> values = sampleAngles<Radian>(20.f, 801);
+        values.emplace_back(0.f);
+        values.emplace_back(std::numeric_limits<float>::infinity());
+        values.emplace_back(-std::numeric_limits<float>::infinity());
+
+        THEN("The batch atan matches the standard function")
+        {
+            std::vector<float> precise(values.size());
+            std::vector<float> fast(values.size());
+            atan(values.data(), values.size(), precise.data());
+            atan<TrigonometryAccuracy::Fast>(values.data(), values.size(), fast.data());
+
+            for (std::size_t index = 0; index != values.size(); ++index)
+            {
+                CAPTURE(values[index]);
+                REQUIRE(precise[index] == Approx(atan(values[index])).epsilon(2.5E-7));
+                REQUIRE(fast[index] == Approx(atan(values[index])).epsilon(3E-5));
+            }
+        }
+    }
+}
@@ -0,0 +1,187 @@
+#include <math/Angle.h>
+#include <math/BatchTransform.h>
+#include <math/Transformations.h>
+
+#include <exception>
+#include <stdexcept>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <cstdlib>
+
+
+using namespace ad::math;
+
+
+namespace {
+
+
+// More threads than this is certainly a mistake on the command line
+constexpr std::size_t gMaxThreadCount = 1024;
+
+
+void printUsage(const char * aProgram)
+{
+    std::cerr << "Usage: " << aProgram << " input output [--double] [--threads N] [transformations...]\n"
+              << "\n"
+              << "Transforms a raw binary file of (x, y, z) positions, stored as native floats\n"
+              << "(or doubles with --double). Transformations are applied in the order they are given:\n"
+              << "  --translate X Y Z\n"
+              << "  --scale FACTOR\n"
+              << "  --rotate-x DEGREES | --rotate-y DEGREES | --rotate-z DEGREES\n"
+              << "  --affine L00 L01 L02 L10 L11 L12 L20 L21 L22 TX TY TZ\n"
+              << "      (row vector convention: p' = p * L + T)\n";
+}
+
+
+struct Arguments
+{
+    std::string input;
+    std::string output;
+    bool useDouble{false};
+    std::size_t threadCount{defaultThreadCount()};
+    Affine<3, double> transform{Affine<3, double>::Identity()};
+};
+
+
+Arguments parseArguments(int argc, char ** argv)
+{
+    std::vector<std::string> arguments{argv + 1, argv + argc};
+    if (arguments.size() < 2)
+    {
+        throw std::invalid_argument{"Input and output files are required."};
+    }
+
+    Arguments result;
+    result.input = arguments[0];
+    result.output = arguments[1];
+
+    std::size_t index = 2;
+    auto next = [&]() -> const std::string &
+    {
+        if (index == arguments.size())
+        {
+            throw std::invalid_argument{"Missing value after '" + arguments[index - 1] + "'."};
+        }
+        return arguments[index++];
+    };
+    auto nextNumber = [&]()
+    {
+        return std::stod(next());
+    };
+    // std::stoul accepts a sign, wrapping negative values around
+    auto nextThreadCount = [&]()
+    {
+        const std::string & value = next();
+        if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos
+            || value.size() > 4 || std::stoul(value) == 0 || std::stoul(value) > gMaxThreadCount)
+        {
+            throw std::invalid_argument{"The thread count must be between 1 and "
+                                        + std::to_string(gMaxThreadCount) + ", not '" + value + "'."};
+        }
+        return static_cast<std::size_t>(std::stoul(value));
+    };
+
+    while (index != arguments.size())
+    {
+        const std::string option = next();
+        if (option == "--double")
+        {
+            result.useDouble = true;
+        }
+        else if (option == "--threads")
+        {
+            result.threadCount = nextThreadCount();
+        }
+        else if (option == "--translate")
+        {
+            const double x = nextNumber(), y = nextNumber(), z = nextNumber();
+            result.transform *= Affine<3, double>::Translation({x, y, z});
+        }
+        else if (option == "--scale")
+        {
+            const double factor = nextNumber();
+            result.transform *= Affine<3, double>{trans3d::scale(factor, factor, factor)};
+        }
+        else if (option == "--rotate-x")
+        {
+            result.transform *= Affine<3, double>{trans3d::rotateX(Degree<double>{nextNumber()})};
+        }
+        else if (option == "--rotate-y")
+        {
+            result.transform *= Affine<3, double>{trans3d::rotateY(Degree<double>{nextNumber()})};
+        }
+        else if (option == "--rotate-z")
+        {
+            result.transform *= Affine<3, double>{trans3d::rotateZ(Degree<double>{nextNumber()})};
+        }
+        else if (option == "--affine")
+        {
+            Affine<3, double> affine = Affine<3, double>::Identity();
+            for (std::size_t row = 0; row != 3; ++row)
+            {
+                for (std::size_t col = 0; col != 3; ++col)
+                {
+                    affine.linear().at(row, col) = nextNumber();
+                }
+            }
+            for (std::size_t col = 0; col != 3; ++col)
+            {
+                affine.translation().at(col) = nextNumber();
+            }
+            result.transform *= affine;
+        }
+        else
+        {
+            throw std::invalid_argument{"Unknown option '" + option + "'."};
+        }
+    }
+    return result;
+}
+
+
+Affine<3, float> toFloat(const Affine<3, double> & aTransform)
+{
+    return {static_cast<Matrix<3, 3, float>>(aTransform.linear()),
+            static_cast<Vec<3, float>>(aTransform.translation())};
+}
+
+
+} // anonymous namespace
+
+
+int main(int argc, char ** argv)
+{
+    Arguments arguments;
+    try
+    {
+        arguments = parseArguments(argc, argv);
+    }
+    catch (std::exception & aException)
+    {
+        std::cerr << aException.what() << "\n\n";
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        const TransformStatistics statistics = arguments.useDouble ?
+            transformPositionFile(arguments.input, arguments.output,
+                                  arguments.transform, arguments.threadCount)
+            : transformPositionFile(arguments.input, arguments.output,
+                                    toFloat(arguments.transform), arguments.threadCount);
+
+        std::cout << "Transformed " << statistics.pointCount << " points ("
+                  << statistics.byteCount << " bytes) in " << statistics.seconds << " s: "
+                  << statistics.pointsPerSecond() << " points/s, "
+                  << statistics.bytesPerSecond() / (1024 * 1024) << " MiB/s.\n";
+    }
+    catch (std::exception & aException)
+    {
+        std::cerr << aException.what() << "\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
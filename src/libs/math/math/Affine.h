@@ -0,0 +1,167 @@
+#pragma once
+
+
+#include "Matrix.h"
+#include "Vector.h"
+
+
+namespace ad {
+namespace math {
+
+
+/// \brief Affine transformation, stored as its linear part and its translation.
+///
+/// It follows the row vector convention of the library: a position `p` is transformed to
+/// `p * linear + translation`, and `a * b` applies `a`, then `b`.
+///
+/// \note Compared to the equivalent homogeneous Matrix<N+1, N+1>, the constant last column
+/// is neither stored nor multiplied (e.g. 12 values instead of 16 in 3D).
+template <int N_dimension, class T_number=real_number>
+class Affine
+{
+public:
+    using linear_type = Matrix<N_dimension, N_dimension, T_number>;
+    using translation_type = Vec<N_dimension, T_number>;
+
+    constexpr Affine(linear_type aLinear, translation_type aTranslation);
+
+    /// \brief Affine transformation with a null translation.
+    explicit constexpr Affine(linear_type aLinear);
+
+    static constexpr Affine Identity();
+    static constexpr Affine Translation(translation_type aTranslation);
+
+    constexpr linear_type & linear()
+    { return mLinear; }
+    constexpr const linear_type & linear() const
+    { return mLinear; }
+
+    constexpr translation_type & translation()
+    { return mTranslation; }
+    constexpr const translation_type & translation() const
+    { return mTranslation; }
+
+    /// \brief Applies aRhs after this transformation.
+    constexpr Affine & operator*=(const Affine & aRhs);
+
+    /// \attention Undefined behaviour if the linear part is singular.
+    constexpr Affine inverse() const;
+
+    /// \brief The homogeneous matrix, with the translation as last row.
+    constexpr Matrix<N_dimension+1, N_dimension+1, T_number> toMatrix() const;
+
+private:
+    linear_type mLinear;
+    translation_type mTranslation;
+};
+
+
+//
+// Operations
+//
+template <int N_dimension, class T_number>
+constexpr Affine<N_dimension, T_number> operator*(Affine<N_dimension, T_number> aLhs,
+                                                  const Affine<N_dimension, T_number> & aRhs)
+{
+    return aLhs *= aRhs;
+}
+
+/// \brief Positions are affected by the translation.
+template <int N_dimension, class T_number>
+constexpr Position<N_dimension, T_number> operator*(const Position<N_dimension, T_number> aLhs,
+                                                    const Affine<N_dimension, T_number> & aRhs)
+{
+    return aLhs * aRhs.linear() + aRhs.translation();
+}
+
+/// \brief Displacements are not affected by the translation.
+template <int N_dimension, class T_number>
+constexpr Vec<N_dimension, T_number> operator*(const Vec<N_dimension, T_number> aLhs,
+                                               const Affine<N_dimension, T_number> & aRhs)
+{
+    return aLhs * aRhs.linear();
+}
+
+template <int N_dimension, class T_number>
+constexpr bool operator==(const Affine<N_dimension, T_number> & aLhs,
+                          const Affine<N_dimension, T_number> & aRhs)
+{
+    return aLhs.linear() == aRhs.linear() && aLhs.translation() == aRhs.translation();
+}
+
+template <int N_dimension, class T_number>
+constexpr bool operator!=(const Affine<N_dimension, T_number> & aLhs,
+                          const Affine<N_dimension, T_number> & aRhs)
+{
+    return !(aLhs == aRhs);
+}
+
+
+//
+// Implementation
+//
+template <int N_dimension, class T_number>
+constexpr Affine<N_dimension, T_number>::Affine(linear_type aLinear, translation_type aTranslation) :
+    mLinear{aLinear},
+    mTranslation{aTranslation}
+{}
+
+
+template <int N_dimension, class T_number>
+constexpr Affine<N_dimension, T_number>::Affine(linear_type aLinear) :
+    Affine{aLinear, translation_type::Zero()}
+{}
+
+
+template <int N_dimension, class T_number>
+constexpr Affine<N_dimension, T_number> Affine<N_dimension, T_number>::Identity()
+{
+    return Affine{linear_type::Identity()};
+}
+
+
+template <int N_dimension, class T_number>
+constexpr Affine<N_dimension, T_number>
+Affine<N_dimension, T_number>::Translation(translation_type aTranslation)
+{
+    return Affine{linear_type::Identity(), aTranslation};
+}
+
+
+template <int N_dimension, class T_number>
+constexpr Affine<N_dimension, T_number> &
+Affine<N_dimension, T_number>::operator*=(const Affine & aRhs)
+{
+    // (p * L1 + t1) * L2 + t2 == p * (L1 * L2) + (t1 * L2 + t2)
+    mTranslation = mTranslation * aRhs.mLinear + aRhs.mTranslation;
+    mLinear *= aRhs.mLinear;
+    return *this;
+}
+
+
+template <int N_dimension, class T_number>
+constexpr Affine<N_dimension, T_number> Affine<N_dimension, T_number>::inverse() const
+{
+    linear_type inverseLinear = mLinear.inverse();
+    return {inverseLinear, -mTranslation * inverseLinear};
+}
+
+
+template <int N_dimension, class T_number>
+constexpr Matrix<N_dimension+1, N_dimension+1, T_number> Affine<N_dimension, T_number>::toMatrix() const
+{
+    Matrix<N_dimension+1, N_dimension+1, T_number> result =
+        Matrix<N_dimension+1, N_dimension+1, T_number>::Identity();
+    for (std::size_t row = 0; row != N_dimension; ++row)
+    {
+        for (std::size_t col = 0; col != N_dimension; ++col)
+        {
+            result.at(row, col) = mLinear.at(row, col);
+        }
+        result.at(N_dimension, row) = mTranslation.at(row);
+    }
+    return result;
+}
+
+
+}} // namespace ad::math
@@ -2,9 +2,12 @@
 
 #include "Constants.h"
 
+#include <ratio>
 #include <string>
+#include <type_traits>
 
 #include <cmath>
+#include <cstdint>
 
 
 namespace ad {
@@ -47,8 +50,9 @@ public:
 
     /*implicit*/ constexpr operator Angle<T_representation, Radian_tag>() const;
 
-    template <template <class> class TT_angle>
-    constexpr TT_angle<T_representation> as() const;
+    /// \brief Converts to another unit, optionally to another representation.
+    template <template <class> class TT_angle, class T_targetRepresentation=T_representation>
+    constexpr TT_angle<T_targetRepresentation> as() const;
 
     constexpr T_representation value() const
     {
@@ -147,7 +151,8 @@ constexpr bool operator>=(const ANGLE aLhs, const ANGLE aRhs)
 template <class T_representation, class T_unitTag>
 constexpr ANGLE operator-(const ANGLE aAngle)
 {
-    return ANGLE{-aAngle.value()};
+    // The cast allows unsigned representations, which negate modulo their range
+    return ANGLE{static_cast<T_representation>(-aAngle.value())};
 }
 
 template <class T_representation, class T_unitTag>
@@ -262,12 +267,16 @@ namespace angle_literals
 template <class T_angle>
 class Angle_trait;
 
+// Each unit describes the measure of a full turn, as turn_ratio * pi^turn_pi_power.
+// Keeping pi apart allows conversions between units not involving radians to be exact
+// rationals, notably for integral representations.
 template <class T_representation>
 class Angle_trait<Radian<T_representation>>
 {
 public:
     static constexpr const char * const suffix = "rad";
-    static constexpr double radian_factor = 1.0;
+    using turn_ratio = std::ratio<2>;
+    static constexpr int turn_pi_power = 1;
 };
 
 template <class T_representation>
@@ -275,12 +284,80 @@ class Angle_trait<Degree<T_representation>>
 {
 public:
     static constexpr const char * const suffix = "deg";
-    // Would be nice to use T_representation here to match the floating point
-    // yet that would break for integral types
-    static constexpr double radian_factor = 2*pi<double>/360.0;
+    using turn_ratio = std::ratio<360>;
+    static constexpr int turn_pi_power = 0;
 };
 
 
+namespace detail {
+
+
+    template <int N_power>
+    constexpr long double pi_power()
+    {
+        static_assert(N_power >= -1 && N_power <= 1, "Unit turns only involve pi to the power -1, 0 or 1.");
+        return (N_power == 1) ? pi<long double>
+               : (N_power == -1) ? 1.0L / pi<long double>
+               : 1.0L;
+    }
+
+
+    /// \brief Conversion of a value from T_sourceAngle unit to T_targetAngle unit.
+    template <class T_sourceAngle, class T_targetAngle>
+    struct AngleConversion
+    {
+        using source_trait = Angle_trait<T_sourceAngle>;
+        using target_trait = Angle_trait<T_targetAngle>;
+
+        using ratio = std::ratio_divide<typename target_trait::turn_ratio,
+                                        typename source_trait::turn_ratio>;
+        static constexpr int pi_exponent = target_trait::turn_pi_power - source_trait::turn_pi_power;
+
+        /// \brief The factor, computed at compile time in extended precision,
+        /// then rounded once to T_number.
+        template <class T_number>
+        static constexpr T_number factor = static_cast<T_number>(
+            static_cast<long double>(ratio::num) / ratio::den * pi_power<pi_exponent>());
+
+        template <class T_target, class T_source>
+        static constexpr T_target apply(T_source aValue)
+        {
+            if constexpr (std::is_floating_point<T_target>::value)
+            {
+                // A single multiplication, in the target type
+                return static_cast<T_target>(aValue) * factor<T_target>;
+            }
+            else if constexpr (std::is_floating_point<T_source>::value)
+            {
+                return narrow<T_target>(aValue * factor<T_source>);
+            }
+            else if constexpr (pi_exponent == 0)
+            {
+                // Exact rational conversion, truncated toward zero
+                return static_cast<T_target>(static_cast<std::intmax_t>(aValue) * ratio::num
+                                             / ratio::den);
+            }
+            else
+            {
+                return narrow<T_target>(aValue * factor<double>);
+            }
+        }
+
+    private:
+        // Note: allows narrowing, truncating toward zero.
+        // Going through intmax_t makes the conversion to unsigned types wrap around
+        // instead of being undefined when out of range.
+        template <class T_target, class T_floating>
+        static constexpr T_target narrow(T_floating aValue)
+        {
+            return static_cast<T_target>(static_cast<std::intmax_t>(aValue));
+        }
+    };
+
+
+} // namespace detail
+
+
 //
 // IO
 //
@@ -303,15 +380,12 @@ constexpr Angle<T_representation, T_unitTag>::operator Angle<T_representation, R
 }
 
 template <class T_representation, class T_unitTag>
-template <template <class> class TT_angle>
-constexpr TT_angle<T_representation> Angle<T_representation, T_unitTag>::as() const
+template <template <class> class TT_angle, class T_targetRepresentation>
+constexpr TT_angle<T_targetRepresentation> Angle<T_representation, T_unitTag>::as() const
 {
-    // Note: allows narrowing
-    return TT_angle<T_representation>(static_cast<T_representation>(
-        value()
-        * Angle_trait<Angle>::radian_factor
-        / Angle_trait<TT_angle<T_representation>>::radian_factor
-    ));
+    using conversion = detail::AngleConversion<Angle, TT_angle<T_targetRepresentation>>;
+    return TT_angle<T_targetRepresentation>{
+        conversion::template apply<T_targetRepresentation>(value())};
 }
 
 } // namespace math
@@ -1,14 +1,28 @@
 #pragma once
 
 
+#include "Bitmask.h"
+#include "Matrix.h"
 #include "Vector.h"
 
+#include <algorithm>
+#include <limits>
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
 
 namespace ad {
 namespace math {
 
 
 /// \brief Barycentric coordinate system for 2D triangles
+///
+/// Beta and gamma are affine functions of the point, stored with their factors already divided
+/// by their value at the opposite vertex: evaluating a coordinate takes no division,
+/// and moving the point by a constant step changes each coordinate by a constant.
 template <class T_number>
 class Barycentric
 {
@@ -31,24 +45,224 @@ public:
         // On a free function, T_number could not be deduced from a type nested in a 
         // dependent template class
         bool operator==(const Coordinates &aRhs) const;
+
+        Coordinates & operator+=(const Coordinates &aRhs);
+        Coordinates operator+(const Coordinates &aRhs) const;
     };
 
     /// \attention Undefined behaviour if the three points form a degenerate triangle.
     Barycentric(Vec<2, T_number> aPointA, Vec<2, T_number> aPointB, Vec<2, T_number> aPointC);
 
     /// \brief Compute the barycentric coordinates of aPoint in the basis formed by this Barycentric
-    Coordinates getCoordinates(Vec<2, T_number> aPoint);
-    
+    Coordinates getCoordinates(Vec<2, T_number> aPoint) const;
+
+    /// \brief Change of the coordinates when the point moves by aStep along X.
+    ///
+    /// Adding it to the coordinates of a point gives the coordinates of the next point,
+    /// which allows walking a grid incrementally (rounding errors accumulate with each addition).
+    Coordinates getStepX(T_number aStep) const;
+
+    /// \brief Change of the coordinates when the point moves by aStep along Y.
+    Coordinates getStepY(T_number aStep) const;
+
+    /// \brief Coordinates of the aCount points `aStart + (i * aStepX, 0)`, written to separate arrays.
+    ///
+    /// Each point is computed from aStart, so errors do not accumulate along the row,
+    /// and the iterations are independent so the loop vectorizes.
+    void getCoordinatesRow(Vec<2, T_number> aStart, T_number aStepX, std::size_t aCount,
+                           T_number * aAlpha, T_number * aBeta, T_number * aGamma) const;
+
 private:
     static T_number signedDistance(const Factors &aFactors, Vec<2, T_number> aPoint);
 
+    static Factors normalize(const Factors &aFactors, T_number aValue);
+
+
+private:
+    // Factors of the edge functions, divided by their value at the opposite vertex
+    Factors mBetaFactors;
+    Factors mGammaFactors;
+};
+
+
+
+/// \brief Barycentric coordinate system for 2D triangles with fixed point vertices, computed exactly.
+///
+/// Vertices and points are integers counting 1 / 2^N_subpixelBits of a unit (a pixel).
+/// The coordinates are returned as integer weights, each proportional to the area of the triangle
+/// formed by the point and the edge opposite to its vertex: they sum to twice the area of the triangle,
+/// and are positive inside the triangle whatever its winding.
+/// Weights are accumulated on 64 bits, which is exact for coordinates within [-2^30, 2^30).
+///
+/// Coverage follows the top-left rule, for Y pointing down: a point on an edge is covered
+/// only if the edge is a top edge (horizontal, the triangle below it) or a left edge.
+/// Triangles sharing an edge thus cover each of its points exactly once.
+template <int N_subpixelBits = 8>
+class FixedBarycentric
+{
+public:
+    using fixed_type = std::int32_t;
+    using weight_type = std::int64_t;
+
+    static constexpr fixed_type gOne = fixed_type{1} << N_subpixelBits;
+
+    struct Weights
+    {
+        weight_type alpha;
+        weight_type beta;
+        weight_type gamma;
+
+        bool operator==(const Weights &aRhs) const
+        { return alpha == aRhs.alpha && beta == aRhs.beta && gamma == aRhs.gamma; }
+
+        Weights & operator+=(const Weights &aRhs)
+        {
+            alpha += aRhs.alpha;
+            beta += aRhs.beta;
+            gamma += aRhs.gamma;
+            return *this;
+        }
+
+        Weights operator+(const Weights &aRhs) const
+        { return Weights{*this} += aRhs; }
+    };
+
+    /// \attention Undefined behaviour if the three points form a degenerate triangle.
+    FixedBarycentric(Vec<2, fixed_type> aPointA, Vec<2, fixed_type> aPointB, Vec<2, fixed_type> aPointC);
+
+    /// \brief Rounds aValue, in units, to the closest fixed point value.
+    template <class T_number>
+    static fixed_type toFixed(T_number aValue)
+    { return static_cast<fixed_type>(std::llround(aValue * gOne)); }
+
+    /// \brief Twice the area of the triangle, in squared fixed point units: the sum of the weights.
+    weight_type getDoubleArea() const
+    { return mDoubleArea; }
+
+    Weights getWeights(Vec<2, fixed_type> aPoint) const;
+
+    /// \brief Change of the weights when the point moves by aStep along X.
+    Weights getStepX(fixed_type aStep) const
+    { return {mAlphaEdge.x * aStep, mBetaEdge.x * aStep, mGammaEdge.x * aStep}; }
+
+    /// \brief Change of the weights when the point moves by aStep along Y.
+    Weights getStepY(fixed_type aStep) const
+    { return {mAlphaEdge.y * aStep, mBetaEdge.y * aStep, mGammaEdge.y * aStep}; }
+
+    /// \brief Whether a point with these weights is covered by the triangle, following the top-left rule.
+    bool isCovered(const Weights & aWeights) const;
+
+    /// \brief Normalized coordinates, summing to 1.
+    template <class T_number>
+    typename Barycentric<T_number>::Coordinates getCoordinates(const Weights & aWeights) const;
+
+    /// \brief Coverage of the aCount points `aStart + (i * aStepX, 0)`.
+    /// \param aResults Receives one bit per point, in bitmaskWordCount(aCount) words (see Bitmask.h).
+    void getCoverageRow(Vec<2, fixed_type> aStart, fixed_type aStepX, std::size_t aCount,
+                        std::uint64_t * aResults) const;
+
+private:
+    // Edge function `x * point.x() + y * point.y() + constant`, positive inside the triangle
+    struct Edge
+    {
+        weight_type x;
+        weight_type y;
+        weight_type constant;
+        // 0 if the points on the edge are covered, -1 otherwise
+        weight_type bias;
+    };
+
+    static Edge makeEdge(Vec<2, fixed_type> aFrom, Vec<2, fixed_type> aTo, weight_type aSign);
+
+    static weight_type evaluate(const Edge &aEdge, Vec<2, fixed_type> aPoint)
+    { return aEdge.x * aPoint.x() + aEdge.y * aPoint.y() + aEdge.constant; }
+
+    weight_type mDoubleArea;
+    Edge mAlphaEdge;
+    Edge mBetaEdge;
+    Edge mGammaEdge;
+};
+
+
+
+/// \brief Barycentric coordinate system for triangles in 3D.
+///
+/// Points are projected orthogonally on the plane of the triangle.
+/// Each coordinate is an affine function of the point, whose factors are precomputed from the inverse
+/// of the basis of the triangle: a query is a dot product per coordinate, without division.
+template <class T_number>
+class TriangleBarycentric
+{
+public:
+    using Coordinates = typename Barycentric<T_number>::Coordinates;
+
+    /// \attention Undefined behaviour if the three points form a degenerate triangle.
+    TriangleBarycentric(Vec<3, T_number> aPointA, Vec<3, T_number> aPointB, Vec<3, T_number> aPointC);
+
+    Coordinates getCoordinates(Vec<3, T_number> aPoint) const;
+
+    /// \brief Batch getCoordinates(), over aCount points stored as separate X, Y and Z arrays.
+    void getCoordinates(const T_number * aX, const T_number * aY, const T_number * aZ,
+                        std::size_t aCount,
+                        T_number * aAlpha, T_number * aBeta, T_number * aGamma) const;
 
 private:
+    // `x * point.x() + y * point.y() + z * point.z() + constant`
+    struct Factors
+    {
+        T_number x;
+        T_number y;
+        T_number z;
+        T_number constant;
+    };
+
     Factors mBetaFactors;
     Factors mGammaFactors;
+};
+
+
+/// \brief Barycentric coordinate system for tetrahedra.
+///
+/// As for TriangleBarycentric, the factors of the coordinates are precomputed by inverting
+/// the basis of the tetrahedron.
+template <class T_number>
+class TetrahedronBarycentric
+{
+public:
+    struct Coordinates
+    {
+        T_number alpha;
+        T_number beta;
+        T_number gamma;
+        T_number delta;
+
+        bool operator==(const Coordinates &aRhs) const
+        { return alpha == aRhs.alpha && beta == aRhs.beta && gamma == aRhs.gamma && delta == aRhs.delta; }
+    };
+
+    /// \attention Undefined behaviour if the four points form a degenerate tetrahedron.
+    TetrahedronBarycentric(Vec<3, T_number> aPointA, Vec<3, T_number> aPointB,
+                           Vec<3, T_number> aPointC, Vec<3, T_number> aPointD);
+
+    Coordinates getCoordinates(Vec<3, T_number> aPoint) const;
+
+    /// \brief Batch getCoordinates(), over aCount points stored as separate X, Y and Z arrays.
+    void getCoordinates(const T_number * aX, const T_number * aY, const T_number * aZ,
+                        std::size_t aCount,
+                        T_number * aAlpha, T_number * aBeta, T_number * aGamma, T_number * aDelta) const;
+
+private:
+    struct Factors
+    {
+        T_number x;
+        T_number y;
+        T_number z;
+        T_number constant;
+    };
 
-    T_number mValueB;
-    T_number mValueC;
+    Factors mBetaFactors;
+    Factors mGammaFactors;
+    Factors mDeltaFactors;
 };
 
 
@@ -63,10 +277,11 @@ Barycentric<T_number>::Barycentric(Vec<2, T_number> aPointA, Vec<2, T_number> aP
             aPointA.y()-aPointB.y(),
             aPointB.x()-aPointA.x(),
             aPointA.x()*aPointB.y() - aPointB.x()*aPointA.y()
-        },
-        mValueB{ signedDistance(mBetaFactors, aPointB) },
-        mValueC{ signedDistance(mGammaFactors, aPointC) }
-{}
+        }
+{
+    mBetaFactors = normalize(mBetaFactors, signedDistance(mBetaFactors, aPointB));
+    mGammaFactors = normalize(mGammaFactors, signedDistance(mGammaFactors, aPointC));
+}
 
 
 template <class T_number>
@@ -77,16 +292,58 @@ Barycentric<T_number> makeBarycentric(Vec<2, T_number> aPointA, Vec<2, T_number>
 
 
 template <class T_number>
-typename Barycentric<T_number>::Coordinates Barycentric<T_number>::getCoordinates(Vec<2, T_number> aPoint)
+typename Barycentric<T_number>::Coordinates Barycentric<T_number>::getCoordinates(Vec<2, T_number> aPoint) const
 {
-    static_assert(std::is_floating_point<T_number>::value, "Not yet implement for non-floating point coordinates");
+    static_assert(std::is_floating_point<T_number>::value, "Use FixedBarycentric for integer coordinates");
 
-    T_number beta = signedDistance(mBetaFactors, aPoint) / mValueB;
-    T_number gamma = signedDistance(mGammaFactors, aPoint) / mValueC;
+    T_number beta = signedDistance(mBetaFactors, aPoint);
+    T_number gamma = signedDistance(mGammaFactors, aPoint);
     return { (1-beta-gamma), beta, gamma };
 }
 
 
+template <class T_number>
+typename Barycentric<T_number>::Coordinates Barycentric<T_number>::getStepX(T_number aStep) const
+{
+    T_number beta = mBetaFactors.x * aStep;
+    T_number gamma = mGammaFactors.x * aStep;
+    return { -(beta+gamma), beta, gamma };
+}
+
+
+template <class T_number>
+typename Barycentric<T_number>::Coordinates Barycentric<T_number>::getStepY(T_number aStep) const
+{
+    T_number beta = mBetaFactors.y * aStep;
+    T_number gamma = mGammaFactors.y * aStep;
+    return { -(beta+gamma), beta, gamma };
+}
+
+
+template <class T_number>
+void Barycentric<T_number>::getCoordinatesRow(Vec<2, T_number> aStart, T_number aStepX, std::size_t aCount,
+                                              T_number * aAlpha, T_number * aBeta, T_number * aGamma) const
+{
+    static_assert(std::is_floating_point<T_number>::value, "Use FixedBarycentric for integer coordinates");
+
+    const Coordinates start = getCoordinates(aStart);
+    const Coordinates step = getStepX(aStepX);
+
+    // A 32 bits counter, whose conversion to floating point vectorizes (unlike std::size_t)
+    assert(aCount <= static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max()));
+    const std::int32_t count = static_cast<std::int32_t>(aCount);
+    for (std::int32_t index = 0; index != count; ++index)
+    {
+        const T_number offset = static_cast<T_number>(index);
+        const T_number beta = start.beta + offset * step.beta;
+        const T_number gamma = start.gamma + offset * step.gamma;
+        aAlpha[index] = 1 - beta - gamma;
+        aBeta[index] = beta;
+        aGamma[index] = gamma;
+    }
+}
+
+
 template <class T_number>
 T_number Barycentric<T_number>::signedDistance(const Factors &aFactors, Vec<2, T_number> aPoint)
 {
@@ -94,6 +351,15 @@ T_number Barycentric<T_number>::signedDistance(const Factors &aFactors, Vec<2, T
 }
 
 
+template <class T_number>
+typename Barycentric<T_number>::Factors Barycentric<T_number>::normalize(const Factors &aFactors, T_number aValue)
+{
+    // A single division, then multiplications by the reciprocal
+    const T_number inverse = 1 / aValue;
+    return { aFactors.x * inverse, aFactors.y * inverse, aFactors.constant * inverse };
+}
+
+
 /***
  * Coordinates
  ***/
@@ -105,4 +371,292 @@ bool Barycentric<T_number>::Coordinates::operator==(const Barycentric::Coordinat
 }
 
 
+template <class T_number>
+typename Barycentric<T_number>::Coordinates &
+Barycentric<T_number>::Coordinates::operator+=(const Barycentric::Coordinates & aRhs)
+{
+    alpha += aRhs.alpha;
+    beta += aRhs.beta;
+    gamma += aRhs.gamma;
+    return *this;
+}
+
+
+template <class T_number>
+typename Barycentric<T_number>::Coordinates
+Barycentric<T_number>::Coordinates::operator+(const Barycentric::Coordinates & aRhs) const
+{
+    Coordinates result{*this};
+    return result += aRhs;
+}
+
+
+
+/***
+ * TriangleBarycentric
+ ***/
+
+template <class T_number>
+TriangleBarycentric<T_number>::TriangleBarycentric(Vec<3, T_number> aPointA,
+                                                   Vec<3, T_number> aPointB,
+                                                   Vec<3, T_number> aPointC)
+{
+    // The projection of (p - a) on the plane is beta * ab + gamma * ac,
+    // solved with the inverse of the Gram matrix of (ab, ac).
+    const Vec<3, T_number> ab = aPointB - aPointA;
+    const Vec<3, T_number> ac = aPointC - aPointA;
+    const T_number abab = ab.dot(ab);
+    const T_number abac = ab.dot(ac);
+    const T_number acac = ac.dot(ac);
+    const T_number inverseDeterminant = 1 / (abab * acac - abac * abac);
+
+    const Vec<3, T_number> beta = (ab * acac - ac * abac) * inverseDeterminant;
+    const Vec<3, T_number> gamma = (ac * abab - ab * abac) * inverseDeterminant;
+    mBetaFactors = {beta.x(), beta.y(), beta.z(), -beta.dot(aPointA)};
+    mGammaFactors = {gamma.x(), gamma.y(), gamma.z(), -gamma.dot(aPointA)};
+}
+
+
+template <class T_number>
+auto TriangleBarycentric<T_number>::getCoordinates(Vec<3, T_number> aPoint) const -> Coordinates
+{
+    const T_number beta = aPoint.x() * mBetaFactors.x + aPoint.y() * mBetaFactors.y + aPoint.z() * mBetaFactors.z
+                          + mBetaFactors.constant;
+    const T_number gamma = aPoint.x() * mGammaFactors.x + aPoint.y() * mGammaFactors.y + aPoint.z() * mGammaFactors.z
+                           + mGammaFactors.constant;
+    return { (1-beta-gamma), beta, gamma };
+}
+
+
+template <class T_number>
+void TriangleBarycentric<T_number>::getCoordinates(const T_number * aX, const T_number * aY, const T_number * aZ,
+                                                   std::size_t aCount,
+                                                   T_number * aAlpha, T_number * aBeta, T_number * aGamma) const
+{
+    // Copies of the members, which the outputs may alias
+    const Factors beta = mBetaFactors;
+    const Factors gamma = mGammaFactors;
+
+    constexpr std::size_t blockSize = 256;
+    std::size_t begin = 0;
+    for (; aCount - begin >= blockSize; begin += blockSize)
+    {
+        // Results are first written to local arrays, which cannot overlap the inputs:
+        // the loop vectorizes without the runtime overlap checks that -O2 does not emit.
+        T_number alpha[blockSize], b[blockSize], g[blockSize];
+        const T_number * x = aX + begin;
+        const T_number * y = aY + begin;
+        const T_number * z = aZ + begin;
+        for (std::size_t index = 0; index != blockSize; ++index)
+        {
+            b[index] = x[index] * beta.x + y[index] * beta.y + z[index] * beta.z + beta.constant;
+            g[index] = x[index] * gamma.x + y[index] * gamma.y + z[index] * gamma.z + gamma.constant;
+            alpha[index] = 1 - b[index] - g[index];
+        }
+        std::copy_n(alpha, blockSize, aAlpha + begin);
+        std::copy_n(b, blockSize, aBeta + begin);
+        std::copy_n(g, blockSize, aGamma + begin);
+    }
+
+    for (; begin != aCount; ++begin)
+    {
+        const Coordinates coordinates = getCoordinates(Vec<3, T_number>{aX[begin], aY[begin], aZ[begin]});
+        aAlpha[begin] = coordinates.alpha;
+        aBeta[begin] = coordinates.beta;
+        aGamma[begin] = coordinates.gamma;
+    }
+}
+
+
+/***
+ * TetrahedronBarycentric
+ ***/
+
+template <class T_number>
+TetrahedronBarycentric<T_number>::TetrahedronBarycentric(Vec<3, T_number> aPointA, Vec<3, T_number> aPointB,
+                                                         Vec<3, T_number> aPointC, Vec<3, T_number> aPointD)
+{
+    // With the edges from A as rows of the basis, (p - a) = (beta, gamma, delta) * basis,
+    // so each column of the inverse basis holds the factors of a coordinate.
+    const Vec<3, T_number> ab = aPointB - aPointA;
+    const Vec<3, T_number> ac = aPointC - aPointA;
+    const Vec<3, T_number> ad = aPointD - aPointA;
+    const Matrix<3, 3, T_number> inverse = Matrix<3, 3, T_number>{
+        ab.x(), ab.y(), ab.z(),
+        ac.x(), ac.y(), ac.z(),
+        ad.x(), ad.y(), ad.z(),
+    }.inverse();
+
+    auto column = [&](std::size_t aColumn) -> Factors
+    {
+        const Vec<3, T_number> factors{inverse.at(0, aColumn), inverse.at(1, aColumn), inverse.at(2, aColumn)};
+        return {factors.x(), factors.y(), factors.z(), -factors.dot(aPointA)};
+    };
+    mBetaFactors = column(0);
+    mGammaFactors = column(1);
+    mDeltaFactors = column(2);
+}
+
+
+template <class T_number>
+auto TetrahedronBarycentric<T_number>::getCoordinates(Vec<3, T_number> aPoint) const -> Coordinates
+{
+    auto evaluate = [&aPoint](const Factors & aFactors)
+    {
+        return aPoint.x() * aFactors.x + aPoint.y() * aFactors.y + aPoint.z() * aFactors.z + aFactors.constant;
+    };
+    const T_number beta = evaluate(mBetaFactors);
+    const T_number gamma = evaluate(mGammaFactors);
+    const T_number delta = evaluate(mDeltaFactors);
+    return { (1-beta-gamma-delta), beta, gamma, delta };
+}
+
+
+template <class T_number>
+void TetrahedronBarycentric<T_number>::getCoordinates(const T_number * aX, const T_number * aY, const T_number * aZ,
+                                                      std::size_t aCount,
+                                                      T_number * aAlpha, T_number * aBeta,
+                                                      T_number * aGamma, T_number * aDelta) const
+{
+    // Copies of the members, and blocks of results in local arrays, as for the triangle
+    const Factors beta = mBetaFactors;
+    const Factors gamma = mGammaFactors;
+    const Factors delta = mDeltaFactors;
+
+    constexpr std::size_t blockSize = 256;
+    std::size_t begin = 0;
+    for (; aCount - begin >= blockSize; begin += blockSize)
+    {
+        T_number alpha[blockSize], b[blockSize], g[blockSize], d[blockSize];
+        const T_number * x = aX + begin;
+        const T_number * y = aY + begin;
+        const T_number * z = aZ + begin;
+        for (std::size_t index = 0; index != blockSize; ++index)
+        {
+            b[index] = x[index] * beta.x + y[index] * beta.y + z[index] * beta.z + beta.constant;
+            g[index] = x[index] * gamma.x + y[index] * gamma.y + z[index] * gamma.z + gamma.constant;
+            d[index] = x[index] * delta.x + y[index] * delta.y + z[index] * delta.z + delta.constant;
+            alpha[index] = 1 - b[index] - g[index] - d[index];
+        }
+        std::copy_n(alpha, blockSize, aAlpha + begin);
+        std::copy_n(b, blockSize, aBeta + begin);
+        std::copy_n(g, blockSize, aGamma + begin);
+        std::copy_n(d, blockSize, aDelta + begin);
+    }
+
+    for (; begin != aCount; ++begin)
+    {
+        const Coordinates coordinates = getCoordinates(Vec<3, T_number>{aX[begin], aY[begin], aZ[begin]});
+        aAlpha[begin] = coordinates.alpha;
+        aBeta[begin] = coordinates.beta;
+        aGamma[begin] = coordinates.gamma;
+        aDelta[begin] = coordinates.delta;
+    }
+}
+
+
+/***
+ * FixedBarycentric
+ ***/
+
+template <int N_subpixelBits>
+FixedBarycentric<N_subpixelBits>::FixedBarycentric(Vec<2, fixed_type> aPointA,
+                                                   Vec<2, fixed_type> aPointB,
+                                                   Vec<2, fixed_type> aPointC) :
+    mDoubleArea{  weight_type{aPointB.x() - aPointA.x()} * (aPointC.y() - aPointA.y())
+                - weight_type{aPointB.y() - aPointA.y()} * (aPointC.x() - aPointA.x())}
+{
+    assert(mDoubleArea != 0);
+
+    // Clockwise triangles have their edge functions negated, so the weights are positive inside
+    const weight_type sign = mDoubleArea > 0 ? 1 : -1;
+    mDoubleArea *= sign;
+    mAlphaEdge = makeEdge(aPointB, aPointC, sign);
+    mBetaEdge = makeEdge(aPointC, aPointA, sign);
+    mGammaEdge = makeEdge(aPointA, aPointB, sign);
+}
+
+
+template <int N_subpixelBits>
+auto FixedBarycentric<N_subpixelBits>::makeEdge(Vec<2, fixed_type> aFrom, Vec<2, fixed_type> aTo, weight_type aSign)
+    -> Edge
+{
+    const weight_type limit = weight_type{1} << 30;
+    assert(aFrom.x() >= -limit && aFrom.x() < limit && aFrom.y() >= -limit && aFrom.y() < limit);
+    (void)limit;
+
+    // Cross product of (aTo - aFrom) and (point - aFrom)
+    Edge edge;
+    edge.x = aSign * (weight_type{aFrom.y()} - aTo.y());
+    edge.y = aSign * (weight_type{aTo.x()} - aFrom.x());
+    edge.constant = -(edge.x * aFrom.x() + edge.y * aFrom.y());
+    // The edge function increases toward the inside of the triangle:
+    // to the right (X) for a left edge, downward (Y) for a top edge.
+    const bool topLeft = edge.x > 0 || (edge.x == 0 && edge.y > 0);
+    edge.bias = topLeft ? 0 : -1;
+    return edge;
+}
+
+
+template <int N_subpixelBits>
+auto FixedBarycentric<N_subpixelBits>::getWeights(Vec<2, fixed_type> aPoint) const -> Weights
+{
+    return {evaluate(mAlphaEdge, aPoint), evaluate(mBetaEdge, aPoint), evaluate(mGammaEdge, aPoint)};
+}
+
+
+template <int N_subpixelBits>
+bool FixedBarycentric<N_subpixelBits>::isCovered(const Weights & aWeights) const
+{
+    // The bias makes a null weight negative for the edges that do not cover their points,
+    // then a single sign test checks the three weights.
+    return ((aWeights.alpha + mAlphaEdge.bias)
+            | (aWeights.beta + mBetaEdge.bias)
+            | (aWeights.gamma + mGammaEdge.bias)) >= 0;
+}
+
+
+template <int N_subpixelBits>
+template <class T_number>
+typename Barycentric<T_number>::Coordinates
+FixedBarycentric<N_subpixelBits>::getCoordinates(const Weights & aWeights) const
+{
+    const T_number inverse = T_number{1} / static_cast<T_number>(mDoubleArea);
+    return {
+        static_cast<T_number>(aWeights.alpha) * inverse,
+        static_cast<T_number>(aWeights.beta) * inverse,
+        static_cast<T_number>(aWeights.gamma) * inverse,
+    };
+}
+
+
+template <int N_subpixelBits>
+void FixedBarycentric<N_subpixelBits>::getCoverageRow(Vec<2, fixed_type> aStart, fixed_type aStepX,
+                                                      std::size_t aCount,
+                                                      std::uint64_t * aResults) const
+{
+    // Locals, see detail::packBits()
+    const Weights start = getWeights(aStart);
+    const Weights step = getStepX(aStepX);
+    const Weights biased{start.alpha + mAlphaEdge.bias, start.beta + mBetaEdge.bias, start.gamma + mGammaEdge.bias};
+
+    detail::packBits(aCount, aResults,
+                     [&](std::size_t aBegin, std::size_t aBlockCount, std::uint8_t * aFlags)
+    {
+        const weight_type begin = static_cast<weight_type>(aBegin);
+        weight_type alpha = biased.alpha + begin * step.alpha;
+        weight_type beta = biased.beta + begin * step.beta;
+        weight_type gamma = biased.gamma + begin * step.gamma;
+        // Integer additions are exact, the weights can be stepped without accumulating errors
+        for (std::size_t index = 0; index != aBlockCount; ++index)
+        {
+            aFlags[index] = (alpha | beta | gamma) >= 0;
+            alpha += step.alpha;
+            beta += step.beta;
+            gamma += step.gamma;
+        }
+    });
+}
+
+
 }} // namespace ad::math
@@ -0,0 +1,166 @@
+#pragma once
+
+
+#include "Affine.h"
+#include "MappedFile.h"
+#include "Parallel.h"
+
+#include <chrono>
+#include <stdexcept>
+#include <string>
+
+#include <cstddef>
+
+
+namespace ad {
+namespace math {
+
+
+struct TransformStatistics
+{
+    double pointsPerSecond() const
+    { return pointCount / seconds; }
+
+    double bytesPerSecond() const
+    { return byteCount / seconds; }
+
+    std::size_t pointCount;
+    /// \brief Bytes read, the same amount being written.
+    std::size_t byteCount;
+    double seconds;
+};
+
+
+/// \brief Transforms aCount positions, stored as interleaved (x, y, z) triples.
+///
+/// \note aInput and aOutput may be the same array, for an in-place transformation.
+template <class T_number>
+void transformPositions(const T_number * aInput,
+                        std::size_t aCount,
+                        const Affine<3, T_number> & aTransform,
+                        T_number * aOutput);
+
+/// \brief Same as the single threaded overload, splitting the positions in contiguous chunks.
+template <class T_number>
+void transformPositions(const T_number * aInput,
+                        std::size_t aCount,
+                        const Affine<3, T_number> & aTransform,
+                        T_number * aOutput,
+                        std::size_t aThreadCount);
+
+
+/// \brief Writes to aOutputPath the transformation of all positions stored in aInputPath.
+///
+/// Both files are raw arrays of (x, y, z) triples of T_number, in native byte order.
+/// They are memory mapped, so files larger than the memory are streamed through by the system.
+/// If both paths name the same file, even through a link, it is transformed in place.
+/// \note Only affine transformations are supported, there is no division by a homogeneous coordinate.
+/// \throw std::system_error if a file cannot be opened or mapped.
+/// \throw std::runtime_error if the input size is not a whole number of positions.
+template <class T_number>
+TransformStatistics transformPositionFile(const std::string & aInputPath,
+                                          const std::string & aOutputPath,
+                                          const Affine<3, T_number> & aTransform,
+                                          std::size_t aThreadCount = defaultThreadCount());
+
+
+//
+// Implementation
+//
+template <class T_number>
+void transformPositions(const T_number * aInput,
+                        std::size_t aCount,
+                        const Affine<3, T_number> & aTransform,
+                        T_number * aOutput)
+{
+    // Coefficients as locals, so they are not reloaded after each store
+    const T_number l00 = aTransform.linear().at(0, 0);
+    const T_number l01 = aTransform.linear().at(0, 1);
+    const T_number l02 = aTransform.linear().at(0, 2);
+    const T_number l10 = aTransform.linear().at(1, 0);
+    const T_number l11 = aTransform.linear().at(1, 1);
+    const T_number l12 = aTransform.linear().at(1, 2);
+    const T_number l20 = aTransform.linear().at(2, 0);
+    const T_number l21 = aTransform.linear().at(2, 1);
+    const T_number l22 = aTransform.linear().at(2, 2);
+    const T_number t0 = aTransform.translation().at(0);
+    const T_number t1 = aTransform.translation().at(1);
+    const T_number t2 = aTransform.translation().at(2);
+
+    for (std::size_t index = 0; index != aCount; ++index)
+    {
+        const T_number x = aInput[3*index];
+        const T_number y = aInput[3*index + 1];
+        const T_number z = aInput[3*index + 2];
+        aOutput[3*index]     = x*l00 + y*l10 + z*l20 + t0;
+        aOutput[3*index + 1] = x*l01 + y*l11 + z*l21 + t1;
+        aOutput[3*index + 2] = x*l02 + y*l12 + z*l22 + t2;
+    }
+}
+
+
+template <class T_number>
+void transformPositions(const T_number * aInput,
+                        std::size_t aCount,
+                        const Affine<3, T_number> & aTransform,
+                        T_number * aOutput,
+                        std::size_t aThreadCount)
+{
+    parallelFor(aCount, aThreadCount, [&](std::size_t aBegin, std::size_t aEnd)
+    {
+        transformPositions(aInput + 3*aBegin, aEnd - aBegin, aTransform, aOutput + 3*aBegin);
+    });
+}
+
+
+template <class T_number>
+TransformStatistics transformPositionFile(const std::string & aInputPath,
+                                          const std::string & aOutputPath,
+                                          const Affine<3, T_number> & aTransform,
+                                          std::size_t aThreadCount)
+{
+    constexpr std::size_t position_size = 3 * sizeof(T_number);
+
+    const auto start = std::chrono::steady_clock::now();
+
+    auto checkSize = [&](const MappedFile & aInput)
+    {
+        if (aInput.size() % position_size != 0)
+        {
+            throw std::runtime_error{"The size of '" + aInputPath + "' is not a whole number of positions."};
+        }
+        return aInput.size() / position_size;
+    };
+
+    // Creating the output would truncate the input
+    if (isSameFile(aInputPath, aOutputPath))
+    {
+        MappedFile file = MappedFile::OpenReadWrite(aInputPath);
+        const std::size_t count = checkSize(file);
+        transformPositions(reinterpret_cast<const T_number *>(file.data()),
+                           count,
+                           aTransform,
+                           reinterpret_cast<T_number *>(file.data()),
+                           aThreadCount);
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return {count, file.size(), elapsed.count()};
+    }
+
+    const MappedFile input = MappedFile::OpenRead(aInputPath);
+    const std::size_t count = checkSize(input);
+    MappedFile output = MappedFile::Create(aOutputPath, input.size());
+
+    // The mappings are page aligned, so suitably aligned for T_number
+    transformPositions(reinterpret_cast<const T_number *>(input.data()),
+                       count,
+                       aTransform,
+                       reinterpret_cast<T_number *>(output.data()),
+                       aThreadCount);
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return {count, input.size(), elapsed.count()};
+}
+
+
+}} // namespace ad::math
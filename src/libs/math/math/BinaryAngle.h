@@ -0,0 +1,207 @@
+#pragma once
+
+
+#include "Angle.h"
+#include "Constants.h"
+
+#include <array>
+#include <limits>
+#include <type_traits>
+
+#include <cmath>
+#include <cstdint>
+
+
+namespace ad {
+namespace math {
+
+
+/// \brief Binary angle measurement: a full turn is the range of the unsigned representation.
+///
+/// Arithmetic wraps around for free, as unsigned arithmetic is modular.
+struct Binary_tag {};
+
+
+template <class T_representation>
+using BinaryAngle = Angle<T_representation, Binary_tag>;
+
+
+template <class T_representation>
+class Angle_trait<BinaryAngle<T_representation>>
+{
+    static_assert(std::is_unsigned<T_representation>::value,
+                  "Binary angles require an unsigned representation, for modular arithmetic.");
+    static_assert(std::numeric_limits<T_representation>::digits <= 32,
+                  "The full turn must be representable by std::ratio.");
+
+public:
+    static constexpr const char * const suffix = "bam";
+    using turn_ratio = std::ratio<(std::intmax_t{1} << std::numeric_limits<T_representation>::digits)>;
+    static constexpr int turn_pi_power = 0;
+};
+
+
+/// \brief Table of the sine over a full turn, indexed by the high bits of binary angles.
+///
+/// \tparam N_indexBits The table holds 2^N_indexBits samples.
+/// \tparam B_interpolate If true, linearly interpolates between the two closest samples
+/// using the low bits of the angle. Otherwise, returns the closest sample.
+///
+/// \note With the default 1024 samples, the interpolated error is below 5E-6,
+/// and below 3.1E-3 without interpolation.
+template <class T_number=float, int N_indexBits=10, bool B_interpolate=true>
+class SineTable
+{
+    static constexpr std::size_t sample_count = std::size_t{1} << N_indexBits;
+
+public:
+    SineTable();
+
+    /// \brief Instance shared by the free sin() and cos() functions on binary angles.
+    static const SineTable & Get();
+
+    template <class T_representation>
+    T_number sin(BinaryAngle<T_representation> aAngle) const;
+
+    template <class T_representation>
+    T_number cos(BinaryAngle<T_representation> aAngle) const;
+
+    /// \brief Batch versions, writing aCount results to aResults.
+    template <class T_representation>
+    void sin(const BinaryAngle<T_representation> * aAngles,
+             std::size_t aCount,
+             T_number * aResults) const;
+
+    template <class T_representation>
+    void cos(const BinaryAngle<T_representation> * aAngles,
+             std::size_t aCount,
+             T_number * aResults) const;
+
+private:
+    template <class T_representation>
+    T_number lookup(T_representation aValue) const;
+
+    // One more sample than the period, so interpolation never has to wrap the index
+    std::array<T_number, sample_count + 1> mSamples;
+};
+
+
+//
+// Operations
+//
+template <class T_representation>
+float sin(const BinaryAngle<T_representation> aAngle)
+{
+    return SineTable<>::Get().sin(aAngle);
+}
+
+template <class T_representation>
+float cos(const BinaryAngle<T_representation> aAngle)
+{
+    return SineTable<>::Get().cos(aAngle);
+}
+
+template <class T_representation>
+float tan(const BinaryAngle<T_representation> aAngle)
+{
+    return sin(aAngle) / cos(aAngle);
+}
+
+
+//
+// Implementation
+//
+template <class T_number, int N_indexBits, bool B_interpolate>
+SineTable<T_number, N_indexBits, B_interpolate>::SineTable()
+{
+    for (std::size_t index = 0; index != mSamples.size(); ++index)
+    {
+        mSamples[index] = static_cast<T_number>(
+            std::sin(2 * pi<long double> * index / sample_count));
+    }
+}
+
+
+template <class T_number, int N_indexBits, bool B_interpolate>
+auto SineTable<T_number, N_indexBits, B_interpolate>::Get() -> const SineTable &
+{
+    static const SineTable instance;
+    return instance;
+}
+
+
+template <class T_number, int N_indexBits, bool B_interpolate>
+template <class T_representation>
+T_number SineTable<T_number, N_indexBits, B_interpolate>::lookup(T_representation aValue) const
+{
+    constexpr int digits = std::numeric_limits<T_representation>::digits;
+    static_assert(N_indexBits <= digits, "The table cannot have more samples than angle values.");
+    constexpr int shift = digits - N_indexBits;
+
+    if constexpr (B_interpolate && shift > 0)
+    {
+        constexpr T_representation fractionMask = (T_representation{1} << shift) - 1;
+        constexpr T_number fractionScale = T_number{1} / (std::uintmax_t{1} << shift);
+
+        const std::size_t index = aValue >> shift;
+        const T_number fraction = static_cast<T_number>(aValue & fractionMask) * fractionScale;
+        return mSamples[index] + (mSamples[index + 1] - mSamples[index]) * fraction;
+    }
+    else if constexpr (shift > 0)
+    {
+        // The cast wraps the rounding back to the first sample
+        constexpr T_representation half = T_representation{1} << (shift - 1);
+        return mSamples[static_cast<T_representation>(aValue + half) >> shift];
+    }
+    else
+    {
+        return mSamples[aValue];
+    }
+}
+
+
+template <class T_number, int N_indexBits, bool B_interpolate>
+template <class T_representation>
+T_number SineTable<T_number, N_indexBits, B_interpolate>::sin(BinaryAngle<T_representation> aAngle) const
+{
+    return lookup(aAngle.value());
+}
+
+
+template <class T_number, int N_indexBits, bool B_interpolate>
+template <class T_representation>
+T_number SineTable<T_number, N_indexBits, B_interpolate>::cos(BinaryAngle<T_representation> aAngle) const
+{
+    constexpr T_representation quarterTurn =
+        T_representation{1} << (std::numeric_limits<T_representation>::digits - 2);
+    return lookup(static_cast<T_representation>(aAngle.value() + quarterTurn));
+}
+
+
+template <class T_number, int N_indexBits, bool B_interpolate>
+template <class T_representation>
+void SineTable<T_number, N_indexBits, B_interpolate>::sin(const BinaryAngle<T_representation> * aAngles,
+                                                          std::size_t aCount,
+                                                          T_number * aResults) const
+{
+    for (std::size_t index = 0; index != aCount; ++index)
+    {
+        aResults[index] = sin(aAngles[index]);
+    }
+}
+
+
+template <class T_number, int N_indexBits, bool B_interpolate>
+template <class T_representation>
+void SineTable<T_number, N_indexBits, B_interpolate>::cos(const BinaryAngle<T_representation> * aAngles,
+                                                          std::size_t aCount,
+                                                          T_number * aResults) const
+{
+    for (std::size_t index = 0; index != aCount; ++index)
+    {
+        aResults[index] = cos(aAngles[index]);
+    }
+}
+
+
+}} // namespace ad::math
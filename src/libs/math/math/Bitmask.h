@@ -0,0 +1,122 @@
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#   include <intrin.h>
+#endif
+
+
+namespace ad {
+namespace math {
+
+
+/*
+ * Batch predicates of the library output packed bitmasks:
+ * element `i` is selected if bit `i % 64` of word `i / 64` is set.
+ * The unused bits of the last word are cleared.
+ */
+
+
+/// \brief Number of words of a bitmask for aCount elements.
+constexpr std::size_t bitmaskWordCount(std::size_t aCount)
+{
+    return (aCount + 63) / 64;
+}
+
+
+constexpr bool testBit(const std::uint64_t * aMask, std::size_t aIndex)
+{
+    return (aMask[aIndex / 64] >> (aIndex % 64)) & 1;
+}
+
+
+/// \brief Writes the indices of the selected elements to aIndices, in increasing order.
+/// \return The number of indices written.
+inline std::size_t bitmaskToIndices(const std::uint64_t * aMask, std::size_t aCount, std::size_t * aIndices);
+
+
+namespace detail {
+
+
+    /// \attention Undefined for a null word.
+    inline std::size_t countTrailingZeros(std::uint64_t aWord)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<std::size_t>(__builtin_ctzll(aWord));
+#elif defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, aWord);
+        return index;
+#else
+        std::size_t count = 0;
+        for (; (aWord & 1) == 0; aWord >>= 1)
+        {
+            ++count;
+        }
+        return count;
+#endif
+    }
+
+
+    /// \brief Packs one bit per element of [0, aCount), 64 per word.
+    ///
+    /// aEvaluate(begin, count, flags) is called for consecutive blocks of at most 64 elements,
+    /// and must set the flag of each element in the block to 0 or 1.
+    /// Working by blocks lets the evaluation and the packing loops vectorize separately.
+    ///
+    /// \note The flags are bytes, and a store through a byte pointer may modify any object.
+    /// The compiler must then reload, after each flag, every value the evaluation reads through
+    /// a reference or `this`, which prevents vectorization. Evaluations copy such values to locals
+    /// before their loop. The same holds for batch functions writing arrays of T_number,
+    /// which may alias the T_number members of the object.
+    template <class T_evaluate>
+    void packBits(std::size_t aCount, std::uint64_t * aWords, T_evaluate && aEvaluate)
+    {
+        auto packBlock = [&aEvaluate](std::size_t aBegin, std::size_t aBlockCount) -> std::uint64_t
+        {
+            std::uint8_t flags[64] = {};
+            aEvaluate(aBegin, aBlockCount, flags);
+
+            std::uint64_t word = 0;
+            for (std::size_t bit = 0; bit != 64; ++bit)
+            {
+                word |= std::uint64_t{flags[bit]} << bit;
+            }
+            return word;
+        };
+
+        // Full blocks are evaluated with a constant count, which compilers vectorize more readily
+        const std::size_t fullWords = aCount / 64;
+        for (std::size_t wordIndex = 0; wordIndex != fullWords; ++wordIndex)
+        {
+            aWords[wordIndex] = packBlock(wordIndex * 64, 64);
+        }
+        if (aCount % 64 != 0)
+        {
+            aWords[fullWords] = packBlock(fullWords * 64, aCount % 64);
+        }
+    }
+
+
+} // namespace detail
+
+
+inline std::size_t bitmaskToIndices(const std::uint64_t * aMask, std::size_t aCount, std::size_t * aIndices)
+{
+    std::size_t written = 0;
+    for (std::size_t wordIndex = 0; wordIndex != bitmaskWordCount(aCount); ++wordIndex)
+    {
+        // Visits the set bits only, clearing the lowest one on each iteration
+        for (std::uint64_t word = aMask[wordIndex]; word != 0; word &= word - 1)
+        {
+            aIndices[written++] = wordIndex * 64 + detail::countTrailingZeros(word);
+        }
+    }
+    return written;
+}
+
+
+}} // namespace ad::math
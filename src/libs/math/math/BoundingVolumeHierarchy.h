@@ -0,0 +1,815 @@
+#pragma once
+
+
+#include "Box.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <vector>
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace ad {
+namespace math {
+
+
+/// \brief Bounding volume hierarchy over primitives given by their bounding boxes,
+/// for ray, box and closest point queries.
+///
+/// The tree is built top-down, splitting nodes according to the surface area heuristic (SAH)
+/// evaluated over bins along the largest extent of the primitive centroids.
+/// With several threads, the top of the tree is built first, then its subtrees are built concurrently.
+/// The tree is stored as a flat array in depth first order: the first child of an inner node immediately follows it.
+///
+/// Queries report primitives by their index in the array of bounds given at construction.
+/// Queries taking a primitive callback let the client test the exact primitive geometry,
+/// the others test the primitive bounds.
+template <int N_dimension, class T_number=real_number>
+class BoundingVolumeHierarchy
+{
+public:
+    using box_type = Box<N_dimension, T_number>;
+    using position_type = Position<N_dimension, T_number>;
+    using PrimitiveIndex = std::uint32_t;
+
+    /// \brief Node of the flattened tree, 32 bytes for a Box<3, float>.
+    struct Node
+    {
+        bool isLeaf() const
+        { return count != 0; }
+
+        box_type bounds;
+        // Leaf: position of its first primitive in the leaf order. Inner node: index of its second child.
+        std::uint32_t offset;
+        // Number of primitives of a leaf, 0 for inner nodes.
+        std::uint16_t count;
+        // Axis along which the children of an inner node were split.
+        std::uint16_t axis;
+    };
+
+    struct RayHit
+    {
+        PrimitiveIndex primitive;
+        T_number distance;
+    };
+
+    struct Nearest
+    {
+        PrimitiveIndex primitive;
+        T_number squaredDistance;
+    };
+
+    /// \param aMaxLeafSize Leaves never hold more primitives, in [1, 255].
+    BoundingVolumeHierarchy(const box_type * aBounds,
+                            std::size_t aCount,
+                            std::size_t aThreadCount = defaultThreadCount(),
+                            std::size_t aMaxLeafSize = 4);
+
+    std::size_t size() const
+    { return mPrimitives.size(); }
+
+    const std::vector<Node> & getNodes() const
+    { return mNodes; }
+
+    /// \brief Updates the bounds of the primitives, keeping the topology of the tree.
+    ///
+    /// \param aBounds The new bounds of all primitives, in the order given at construction.
+    /// \note The tree quality degrades as primitives move away from their original layout,
+    /// at some point it should be rebuilt.
+    void refit(const box_type * aBounds);
+
+    /// \brief Calls aVisitor(PrimitiveIndex) for each primitive whose bounds intersect aQuery.
+    template <class T_visitor>
+    void queryBox(const box_type & aQuery, T_visitor && aVisitor) const;
+
+    /// \brief Closest primitive bounds hit by the ray `aOrigin + t.aDirection`, for t in [0, aMaxDistance].
+    std::optional<RayHit> intersectRay(const position_type & aOrigin,
+                                       const Vec<N_dimension, T_number> & aDirection,
+                                       T_number aMaxDistance = std::numeric_limits<T_number>::infinity()) const;
+
+    /// \brief Closest primitive hit by the ray, as reported by aIntersect.
+    ///
+    /// \param aIntersect Called as `aIntersect(PrimitiveIndex, T_number maxDistance)` for primitives
+    /// whose bounds are hit, it returns a std::optional<T_number> distance along the ray.
+    template <class T_intersector>
+    std::optional<RayHit> intersectRay(const position_type & aOrigin,
+                                       const Vec<N_dimension, T_number> & aDirection,
+                                       T_number aMaxDistance,
+                                       T_intersector && aIntersect) const;
+
+    /// \brief Primitive whose bounds are the closest to aPosition, within aMaxDistance.
+    std::optional<Nearest> findClosest(const position_type & aPosition,
+                                       T_number aMaxDistance = std::numeric_limits<T_number>::infinity()) const;
+
+    /// \brief Closest primitive to aPosition, as measured by aSquaredDistance.
+    ///
+    /// \param aSquaredDistance Called as `aSquaredDistance(PrimitiveIndex, const position_type &)`,
+    /// it must never return less than the squared distance to the primitive bounds.
+    template <class T_distance>
+    std::optional<Nearest> findClosest(const position_type & aPosition,
+                                       T_number aMaxDistance,
+                                       T_distance && aSquaredDistance) const;
+
+private:
+    using NodeIndex = std::uint32_t;
+
+    static constexpr int gBinCount = 16;
+    // Beyond this depth, nodes are split at the median, bounding the depth of the tree (hence of traversal stacks).
+    static constexpr int gMaxSahDepth = 32;
+    // A traversal stack holds at most one node per level, plus the node being visited.
+    // Median splits at least halve the primitive count, and counts are below 2^32.
+    static constexpr std::size_t gStackSize = gMaxSahDepth + 32 + 1;
+    // Marks the nodes standing for a deferred subtree during the parallel build
+    static constexpr std::uint16_t gDeferredAxis = std::numeric_limits<std::uint16_t>::max();
+    // Below this number of primitives, binning a node is not worth spreading over threads
+    static constexpr std::size_t gParallelBinningThreshold = std::size_t{1} << 16;
+
+    struct Bin
+    {
+        box_type bounds{box_type::Empty()};
+        std::size_t count{0};
+    };
+
+    using Bins = std::array<Bin, gBinCount>;
+
+    // Primitives are partitioned as a whole, so each node reads a contiguous range.
+    struct BuildPrimitive
+    {
+        box_type bounds;
+        position_type centroid;
+        PrimitiveIndex index;
+    };
+
+    /// \brief Primitives [begin, end) of a node to build, with the bounds of the primitives and of their centroids.
+    struct BuildRange
+    {
+        std::uint32_t begin;
+        std::uint32_t end;
+        box_type bounds{box_type::Empty()};
+        box_type centroidBounds{box_type::Empty()};
+
+        std::size_t size() const
+        { return end - begin; }
+
+        void expand(const BuildPrimitive & aPrimitive)
+        {
+            bounds.expand(aPrimitive.bounds);
+            centroidBounds.expand(aPrimitive.centroid);
+        }
+    };
+
+    struct DeferredSubtree
+    {
+        BuildRange range;
+        int depth;
+        std::vector<Node> nodes;
+    };
+
+    struct BuildContext
+    {
+        std::vector<BuildPrimitive> primitives;
+        std::size_t threadCount;
+        std::size_t maxLeafSize;
+        // Nodes with fewer primitives are deferred for the parallel phase (only when deferring is enabled).
+        std::size_t deferThreshold;
+    };
+
+    static T_number halfArea(const box_type & aBox);
+
+    static BuildRange measure(const BuildContext & aContext, std::uint32_t aBegin, std::uint32_t aEnd);
+
+    /// \brief Appends the subtree for aRange to aNodes, in depth first order.
+    ///
+    /// \param aDeferred If not null, nodes below the context deferThreshold are not built,
+    /// but recorded as deferred subtrees.
+    void buildNode(BuildContext & aContext, const BuildRange & aRange, int aDepth,
+                   std::vector<Node> & aNodes, std::vector<DeferredSubtree> * aDeferred);
+
+    /// \brief Copies the node aIndex of aTop and its subtree to the end of mNodes,
+    /// replacing deferred nodes by their subtree.
+    void assemble(const std::vector<Node> & aTop, NodeIndex aIndex, const std::vector<DeferredSubtree> & aDeferred);
+
+    static Vec<N_dimension, T_number> inverse(const Vec<N_dimension, T_number> & aDirection);
+
+    template <class T_leafTest>
+    std::optional<RayHit> traverseRay(const position_type & aOrigin,
+                                      const Vec<N_dimension, T_number> & aInverseDirection,
+                                      T_number aMaxDistance,
+                                      T_leafTest && aTest) const;
+
+    template <class T_leafTest>
+    std::optional<Nearest> traverseClosest(const position_type & aPosition,
+                                           T_number aMaxDistance,
+                                           T_leafTest && aTest) const;
+
+    std::vector<Node> mNodes;
+    // Primitive indices, in leaf order
+    std::vector<PrimitiveIndex> mPrimitives;
+    // Primitive bounds, in leaf order
+    std::vector<box_type> mPrimitiveBounds;
+};
+
+
+//
+// Implementation
+//
+template <int N_dimension, class T_number>
+T_number BoundingVolumeHierarchy<N_dimension, T_number>::halfArea(const box_type & aBox)
+{
+    // Sum of the measures of the faces touching the min corner, e.g. xy + yz + zx in 3D.
+    const Size<N_dimension, T_number> size = aBox.size();
+    T_number result{0};
+    for (std::size_t axis = 0; axis != N_dimension; ++axis)
+    {
+        T_number face{1};
+        for (std::size_t other = 0; other != N_dimension; ++other)
+        {
+            if (other != axis)
+            {
+                face *= size[other];
+            }
+        }
+        result += face;
+    }
+    return result;
+}
+
+
+template <int N_dimension, class T_number>
+BoundingVolumeHierarchy<N_dimension, T_number>::BoundingVolumeHierarchy(const box_type * aBounds,
+                                                                        std::size_t aCount,
+                                                                        std::size_t aThreadCount,
+                                                                        std::size_t aMaxLeafSize) :
+    mPrimitives(aCount)
+{
+    assert(aCount < std::numeric_limits<std::uint32_t>::max());
+    assert(aMaxLeafSize >= 1 && aMaxLeafSize <= 255);
+
+    if (aCount == 0)
+    {
+        return;
+    }
+
+    BuildContext context{
+        {},
+        std::max<std::size_t>(1, aThreadCount),
+        aMaxLeafSize,
+        0,
+    };
+    context.primitives.reserve(aCount);
+    for (std::size_t primitive = 0; primitive != aCount; ++primitive)
+    {
+        context.primitives.push_back(
+            BuildPrimitive{aBounds[primitive], aBounds[primitive].center(), static_cast<PrimitiveIndex>(primitive)});
+    }
+
+    const BuildRange root = measure(context, 0, static_cast<std::uint32_t>(aCount));
+    if (context.threadCount == 1)
+    {
+        buildNode(context, root, 0, mNodes, nullptr);
+    }
+    else
+    {
+        // The top of the tree is built by this thread, deferring smaller subtrees.
+        // Several subtrees per thread balance the load, as SAH splits can be uneven.
+        context.deferThreshold = std::max<std::size_t>(aCount / (8 * context.threadCount), 2 * aMaxLeafSize);
+        std::vector<Node> top;
+        std::vector<DeferredSubtree> deferred;
+        buildNode(context, root, 0, top, &deferred);
+
+        // Largest subtrees first, each thread picking the next subtree when done with the previous
+        std::vector<std::size_t> order(deferred.size());
+        std::iota(order.begin(), order.end(), std::size_t{0});
+        std::sort(order.begin(), order.end(), [&deferred](std::size_t aLhs, std::size_t aRhs)
+                  {
+                      return deferred[aLhs].range.size() > deferred[aRhs].range.size();
+                  });
+        std::atomic<std::size_t> next{0};
+        parallelFor(context.threadCount, context.threadCount, [&](std::size_t, std::size_t)
+        {
+            for (std::size_t position = next++; position < order.size(); position = next++)
+            {
+                DeferredSubtree & subtree = deferred[order[position]];
+                buildNode(context, subtree.range, subtree.depth, subtree.nodes, nullptr);
+            }
+        });
+
+        std::size_t nodeCount = top.size();
+        for (const DeferredSubtree & subtree : deferred)
+        {
+            nodeCount += subtree.nodes.size() - 1;
+        }
+        mNodes.reserve(nodeCount);
+        assemble(top, 0, deferred);
+    }
+
+    mPrimitiveBounds.reserve(aCount);
+    for (std::size_t position = 0; position != aCount; ++position)
+    {
+        mPrimitives[position] = context.primitives[position].index;
+        mPrimitiveBounds.push_back(context.primitives[position].bounds);
+    }
+}
+
+
+template <int N_dimension, class T_number>
+auto BoundingVolumeHierarchy<N_dimension, T_number>::measure(const BuildContext & aContext,
+                                                             std::uint32_t aBegin,
+                                                             std::uint32_t aEnd) -> BuildRange
+{
+    BuildRange result{aBegin, aEnd};
+    for (std::uint32_t position = aBegin; position != aEnd; ++position)
+    {
+        result.expand(aContext.primitives[position]);
+    }
+    return result;
+}
+
+
+template <int N_dimension, class T_number>
+void BoundingVolumeHierarchy<N_dimension, T_number>::buildNode(BuildContext & aContext,
+                                                               const BuildRange & aRange,
+                                                               int aDepth,
+                                                               std::vector<Node> & aNodes,
+                                                               std::vector<DeferredSubtree> * aDeferred)
+{
+    const std::size_t count = aRange.size();
+
+    auto makeLeaf = [&]()
+    {
+        aNodes.push_back(Node{aRange.bounds, aRange.begin, static_cast<std::uint16_t>(count), 0});
+    };
+
+    if (count == 1)
+    {
+        makeLeaf();
+        return;
+    }
+
+    if (aDeferred != nullptr && count <= aContext.deferThreshold)
+    {
+        aNodes.push_back(Node{aRange.bounds, static_cast<std::uint32_t>(aDeferred->size()), 0, gDeferredAxis});
+        aDeferred->push_back(DeferredSubtree{aRange, aDepth, {}});
+        return;
+    }
+
+    std::uint16_t axis = 0;
+    const Size<N_dimension, T_number> centroidExtent = aRange.centroidBounds.size();
+    for (std::uint16_t candidate = 1; candidate != N_dimension; ++candidate)
+    {
+        if (centroidExtent[candidate] > centroidExtent[axis])
+        {
+            axis = candidate;
+        }
+    }
+
+    BuildRange left{aRange.begin, aRange.begin};
+    BuildRange right{aRange.end, aRange.end};
+
+    // Centroids only apart by rounding errors are coincident, this also keeps binScale finite.
+    const T_number centroidMagnitude = std::max(std::abs(aRange.centroidBounds.min(axis)),
+                                                std::abs(aRange.centroidBounds.max(axis)));
+    const bool isCoincident =
+        !(centroidExtent[axis] > std::max(centroidMagnitude * 4 * std::numeric_limits<T_number>::epsilon(),
+                                          std::numeric_limits<T_number>::min()));
+
+    if (aDepth < gMaxSahDepth && !isCoincident)
+    {
+        // Only the largest extent of the centroids is binned, trading a little tree quality
+        // for a third of the binning work in 3D.
+        // Small nodes do not benefit from more bins than primitives.
+        const int binCount = static_cast<int>(std::min<std::size_t>(gBinCount, count));
+        const T_number binOrigin = aRange.centroidBounds.min(axis);
+        const T_number binScale = binCount / centroidExtent[axis];
+        auto binOf = [axis, binCount, binOrigin, binScale](const BuildPrimitive & aPrimitive)
+        {
+            return std::min(static_cast<int>((aPrimitive.centroid[axis] - binOrigin) * binScale), binCount - 1);
+        };
+
+        auto binPrimitives = [&](std::size_t aBegin, std::size_t aEnd, Bins & aBins)
+        {
+            for (std::size_t position = aBegin; position != aEnd; ++position)
+            {
+                const BuildPrimitive & primitive = aContext.primitives[position];
+                Bin & bin = aBins[binOf(primitive)];
+                bin.bounds.expand(primitive.bounds);
+                ++bin.count;
+            }
+        };
+
+        Bins bins{};
+        if (aDeferred != nullptr && count >= gParallelBinningThreshold)
+        {
+            // Large top nodes are binned by all threads, before merging their bins
+            std::vector<Bins> partials(aContext.threadCount);
+            std::atomic<std::size_t> nextPartial{0};
+            parallelFor(count, aContext.threadCount, [&](std::size_t aChunkBegin, std::size_t aChunkEnd)
+            {
+                binPrimitives(aRange.begin + aChunkBegin, aRange.begin + aChunkEnd, partials[nextPartial++]);
+            });
+            for (const Bins & partial : partials)
+            {
+                for (int bin = 0; bin != binCount; ++bin)
+                {
+                    bins[bin].bounds.expand(partial[bin].bounds);
+                    bins[bin].count += partial[bin].count;
+                }
+            }
+        }
+        else
+        {
+            binPrimitives(aRange.begin, aRange.end, bins);
+        }
+
+        // Cost of a split, relative to the cost of intersecting a primitive and scaled by the node area:
+        // area * traversal + leftArea * leftCount + rightArea * rightCount, with a unit traversal cost.
+        // Right side costs are swept from the last bin: rightCosts[i] covers bins ]i, binCount[
+        std::array<T_number, gBinCount> rightCosts{};
+        box_type rightBounds = box_type::Empty();
+        std::size_t rightCount = 0;
+        for (int bin = binCount - 1; bin != 0; --bin)
+        {
+            rightBounds.expand(bins[bin].bounds);
+            rightCount += bins[bin].count;
+            rightCosts[bin - 1] = rightCount != 0 ? halfArea(rightBounds) * rightCount : T_number{0};
+        }
+
+        const T_number nodeArea = halfArea(aRange.bounds);
+        T_number bestCost = std::numeric_limits<T_number>::infinity();
+        int bestBin = -1;
+        box_type leftBounds = box_type::Empty();
+        std::size_t leftCount = 0;
+        for (int bin = 0; bin != binCount - 1; ++bin)
+        {
+            leftBounds.expand(bins[bin].bounds);
+            leftCount += bins[bin].count;
+            if (leftCount == 0 || leftCount == count)
+            {
+                continue;
+            }
+            const T_number cost = nodeArea + halfArea(leftBounds) * leftCount + rightCosts[bin];
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                bestBin = bin;
+            }
+        }
+        // The first and last bins are never empty
+        assert(bestBin != -1);
+
+        if (count <= aContext.maxLeafSize && !(bestCost < nodeArea * count))
+        {
+            makeLeaf();
+            return;
+        }
+
+        // Partitions around the best split, accumulating the bounds of both sides on the way
+        auto isLeft = [&binOf, bestBin](const BuildPrimitive & aPrimitive)
+        {
+            return binOf(aPrimitive) <= bestBin;
+        };
+        BuildPrimitive * first = aContext.primitives.data() + aRange.begin;
+        BuildPrimitive * last = aContext.primitives.data() + aRange.end;
+        for (;;)
+        {
+            for (; first != last && isLeft(*first); ++first)
+            {
+                left.expand(*first);
+            }
+            for (; first != last && !isLeft(*(last - 1)); --last)
+            {
+                right.expand(*(last - 1));
+            }
+            if (first == last)
+            {
+                break;
+            }
+            std::iter_swap(first, last - 1);
+        }
+        left.end = right.begin = static_cast<std::uint32_t>(first - aContext.primitives.data());
+    }
+    else
+    {
+        if (count <= aContext.maxLeafSize)
+        {
+            makeLeaf();
+            return;
+        }
+
+        // Median split of the centroids along their largest extent, when SAH does not apply
+        const std::uint32_t middle = aRange.begin + static_cast<std::uint32_t>(count / 2);
+        std::nth_element(aContext.primitives.begin() + aRange.begin,
+                         aContext.primitives.begin() + middle,
+                         aContext.primitives.begin() + aRange.end,
+                         [axis](const BuildPrimitive & aLhs, const BuildPrimitive & aRhs)
+                         {
+                             return aLhs.centroid[axis] < aRhs.centroid[axis];
+                         });
+        left = measure(aContext, aRange.begin, middle);
+        right = measure(aContext, middle, aRange.end);
+    }
+
+    const std::size_t nodeIndex = aNodes.size();
+    aNodes.push_back(Node{aRange.bounds, 0, 0, axis});
+    buildNode(aContext, left, aDepth + 1, aNodes, aDeferred);
+    aNodes[nodeIndex].offset = static_cast<std::uint32_t>(aNodes.size());
+    buildNode(aContext, right, aDepth + 1, aNodes, aDeferred);
+}
+
+
+template <int N_dimension, class T_number>
+void BoundingVolumeHierarchy<N_dimension, T_number>::assemble(const std::vector<Node> & aTop,
+                                                              NodeIndex aIndex,
+                                                              const std::vector<DeferredSubtree> & aDeferred)
+{
+    const Node & node = aTop[aIndex];
+    if (node.axis == gDeferredAxis)
+    {
+        const NodeIndex base = static_cast<NodeIndex>(mNodes.size());
+        for (Node subtreeNode : aDeferred[node.offset].nodes)
+        {
+            if (!subtreeNode.isLeaf())
+            {
+                subtreeNode.offset += base;
+            }
+            mNodes.push_back(subtreeNode);
+        }
+    }
+    else if (node.isLeaf())
+    {
+        mNodes.push_back(node);
+    }
+    else
+    {
+        const std::size_t index = mNodes.size();
+        mNodes.push_back(node);
+        assemble(aTop, aIndex + 1, aDeferred);
+        mNodes[index].offset = static_cast<std::uint32_t>(mNodes.size());
+        assemble(aTop, node.offset, aDeferred);
+    }
+}
+
+
+template <int N_dimension, class T_number>
+void BoundingVolumeHierarchy<N_dimension, T_number>::refit(const box_type * aBounds)
+{
+    for (std::size_t position = 0; position != mPrimitives.size(); ++position)
+    {
+        mPrimitiveBounds[position] = aBounds[mPrimitives[position]];
+    }
+
+    // Children always follow their parent: a reverse pass visits them first.
+    for (std::size_t index = mNodes.size(); index-- != 0;)
+    {
+        Node & node = mNodes[index];
+        if (node.isLeaf())
+        {
+            node.bounds = box_type::Empty();
+            for (std::size_t position = node.offset; position != node.offset + node.count; ++position)
+            {
+                node.bounds.expand(mPrimitiveBounds[position]);
+            }
+        }
+        else
+        {
+            node.bounds = mNodes[index + 1].bounds.unite(mNodes[node.offset].bounds);
+        }
+    }
+}
+
+
+template <int N_dimension, class T_number>
+template <class T_visitor>
+void BoundingVolumeHierarchy<N_dimension, T_number>::queryBox(const box_type & aQuery, T_visitor && aVisitor) const
+{
+    if (mNodes.empty())
+    {
+        return;
+    }
+
+    NodeIndex stack[gStackSize];
+    std::size_t stackSize = 0;
+    stack[stackSize++] = 0;
+    while (stackSize != 0)
+    {
+        const Node & node = mNodes[stack[--stackSize]];
+        if (!node.bounds.intersects(aQuery))
+        {
+            continue;
+        }
+
+        if (node.isLeaf())
+        {
+            for (std::size_t position = node.offset; position != node.offset + node.count; ++position)
+            {
+                if (mPrimitiveBounds[position].intersects(aQuery))
+                {
+                    aVisitor(mPrimitives[position]);
+                }
+            }
+        }
+        else
+        {
+            stack[stackSize++] = node.offset;
+            stack[stackSize++] = static_cast<NodeIndex>(&node - mNodes.data()) + 1;
+        }
+    }
+}
+
+
+template <int N_dimension, class T_number>
+Vec<N_dimension, T_number>
+BoundingVolumeHierarchy<N_dimension, T_number>::inverse(const Vec<N_dimension, T_number> & aDirection)
+{
+    Vec<N_dimension, T_number> result = aDirection;
+    for (std::size_t axis = 0; axis != N_dimension; ++axis)
+    {
+        result[axis] = T_number{1} / aDirection[axis];
+    }
+    return result;
+}
+
+
+template <int N_dimension, class T_number>
+template <class T_leafTest>
+auto BoundingVolumeHierarchy<N_dimension, T_number>::traverseRay(const position_type & aOrigin,
+                                                                 const Vec<N_dimension, T_number> & aInverseDirection,
+                                                                 T_number aMaxDistance,
+                                                                 T_leafTest && aTest) const
+    -> std::optional<RayHit>
+{
+    if (mNodes.empty())
+    {
+        return std::nullopt;
+    }
+
+    std::optional<RayHit> result;
+    T_number closest = aMaxDistance;
+
+    NodeIndex stack[gStackSize];
+    std::size_t stackSize = 0;
+    stack[stackSize++] = 0;
+    while (stackSize != 0)
+    {
+        const NodeIndex index = stack[--stackSize];
+        const Node & node = mNodes[index];
+        // Also prunes the nodes pushed before a closer hit was found
+        if (!node.bounds.intersectRay(aOrigin, aInverseDirection, closest))
+        {
+            continue;
+        }
+
+        if (node.isLeaf())
+        {
+            for (std::size_t position = node.offset; position != node.offset + node.count; ++position)
+            {
+                if (std::optional<T_number> distance = aTest(position, closest);
+                    distance && *distance <= closest)
+                {
+                    closest = *distance;
+                    result = RayHit{mPrimitives[position], *distance};
+                }
+            }
+        }
+        else
+        {
+            // Visits first the child on the side the ray comes from
+            NodeIndex nearChild = index + 1;
+            NodeIndex farChild = node.offset;
+            if (std::signbit(aInverseDirection[node.axis]))
+            {
+                std::swap(nearChild, farChild);
+            }
+            stack[stackSize++] = farChild;
+            stack[stackSize++] = nearChild;
+        }
+    }
+    return result;
+}
+
+
+template <int N_dimension, class T_number>
+auto BoundingVolumeHierarchy<N_dimension, T_number>::intersectRay(const position_type & aOrigin,
+                                                                  const Vec<N_dimension, T_number> & aDirection,
+                                                                  T_number aMaxDistance) const
+    -> std::optional<RayHit>
+{
+    const Vec<N_dimension, T_number> inverseDirection = inverse(aDirection);
+    return traverseRay(aOrigin, inverseDirection, aMaxDistance,
+                       [&](std::size_t aPosition, T_number aClosest)
+                       {
+                           return mPrimitiveBounds[aPosition].intersectRay(aOrigin, inverseDirection, aClosest);
+                       });
+}
+
+
+template <int N_dimension, class T_number>
+template <class T_intersector>
+auto BoundingVolumeHierarchy<N_dimension, T_number>::intersectRay(const position_type & aOrigin,
+                                                                  const Vec<N_dimension, T_number> & aDirection,
+                                                                  T_number aMaxDistance,
+                                                                  T_intersector && aIntersect) const
+    -> std::optional<RayHit>
+{
+    return traverseRay(aOrigin, inverse(aDirection), aMaxDistance,
+                       [&](std::size_t aPosition, T_number aClosest) -> std::optional<T_number>
+                       {
+                           return aIntersect(mPrimitives[aPosition], aClosest);
+                       });
+}
+
+
+template <int N_dimension, class T_number>
+template <class T_leafTest>
+auto BoundingVolumeHierarchy<N_dimension, T_number>::traverseClosest(const position_type & aPosition,
+                                                                     T_number aMaxDistance,
+                                                                     T_leafTest && aTest) const
+    -> std::optional<Nearest>
+{
+    if (mNodes.empty())
+    {
+        return std::nullopt;
+    }
+
+    std::optional<Nearest> result;
+    T_number closest = aMaxDistance * aMaxDistance;
+
+    NodeIndex stack[gStackSize];
+    std::size_t stackSize = 0;
+    stack[stackSize++] = 0;
+    while (stackSize != 0)
+    {
+        const NodeIndex index = stack[--stackSize];
+        const Node & node = mNodes[index];
+        if (node.bounds.squaredDistance(aPosition) > closest)
+        {
+            continue;
+        }
+
+        if (node.isLeaf())
+        {
+            for (std::size_t position = node.offset; position != node.offset + node.count; ++position)
+            {
+                const T_number squaredDistance = aTest(position);
+                if (squaredDistance <= closest)
+                {
+                    closest = squaredDistance;
+                    result = Nearest{mPrimitives[position], squaredDistance};
+                }
+            }
+        }
+        else
+        {
+            // Visits first the closest child, which is most likely to shrink the search radius
+            NodeIndex nearChild = index + 1;
+            NodeIndex farChild = node.offset;
+            if (mNodes[farChild].bounds.squaredDistance(aPosition) < mNodes[nearChild].bounds.squaredDistance(aPosition))
+            {
+                std::swap(nearChild, farChild);
+            }
+            stack[stackSize++] = farChild;
+            stack[stackSize++] = nearChild;
+        }
+    }
+    return result;
+}
+
+
+template <int N_dimension, class T_number>
+auto BoundingVolumeHierarchy<N_dimension, T_number>::findClosest(const position_type & aPosition,
+                                                                 T_number aMaxDistance) const
+    -> std::optional<Nearest>
+{
+    return traverseClosest(aPosition, aMaxDistance,
+                           [&](std::size_t aLeafPosition)
+                           {
+                               return mPrimitiveBounds[aLeafPosition].squaredDistance(aPosition);
+                           });
+}
+
+
+template <int N_dimension, class T_number>
+template <class T_distance>
+auto BoundingVolumeHierarchy<N_dimension, T_number>::findClosest(const position_type & aPosition,
+                                                                 T_number aMaxDistance,
+                                                                 T_distance && aSquaredDistance) const
+    -> std::optional<Nearest>
+{
+    return traverseClosest(aPosition, aMaxDistance,
+                           [&](std::size_t aLeafPosition) -> T_number
+                           {
+                               return aSquaredDistance(mPrimitives[aLeafPosition], aPosition);
+                           });
+}
+
+
+}} // namespace ad::math
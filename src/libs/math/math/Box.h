@@ -0,0 +1,449 @@
+#pragma once
+
+
+#include "Bitmask.h"
+#include "Rectangle.h"
+#include "Vector.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <optional>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace ad {
+namespace math {
+
+
+/// \brief Axis-aligned box in N_dimension, stored as its min and max corners.
+///
+/// Unlike Rectangle, the bounds are stored rather than recomputed from an origin and a size.
+/// In 2D, it is the min/max alternative to the origin/size Rectangle: both convert into each other
+/// (the Rectangle constructor and toRectangle()), and FromOriginSize() builds a box in any dimension.
+/// A box is empty when its min is above its max on any axis, as is the Empty() box,
+/// which is the neutral element of unite().
+template <int N_dimension, class T_number=real_number>
+struct Box
+{
+    using position_type = Position<N_dimension, T_number>;
+
+    static constexpr Box FromMinMax(position_type aMin, position_type aMax);
+    static constexpr Box FromOriginSize(position_type aOrigin, Size<N_dimension, T_number> aSize);
+    /// \brief Box containing no position, expanding it to a position makes a box of this position only.
+    static constexpr Box Empty();
+
+    template <int N=N_dimension, class = std::enable_if_t<(N==2 && N==N_dimension)>>
+    explicit constexpr Box(const Rectangle<T_number> & aRectangle) :
+        Box{FromMinMax(aRectangle.origin(), aRectangle.topRight())}
+    {}
+
+    constexpr Box(position_type aMin, position_type aMax) :
+        mMin{aMin},
+        mMax{aMax}
+    {}
+
+    template <int N=N_dimension, class = std::enable_if_t<(N==2 && N==N_dimension)>>
+    Rectangle<T_number> toRectangle() const
+    { return {mMin, size()}; }
+
+    constexpr const position_type & min() const
+    { return mMin; }
+    constexpr const position_type & max() const
+    { return mMax; }
+
+    constexpr T_number min(std::size_t aAxis) const
+    { return mMin[aAxis]; }
+    constexpr T_number max(std::size_t aAxis) const
+    { return mMax[aAxis]; }
+
+    constexpr Size<N_dimension, T_number> size() const;
+    constexpr position_type center() const;
+    /// \brief Area in 2D, volume in 3D. Null for empty boxes.
+    constexpr T_number volume() const;
+
+    constexpr bool isEmpty() const;
+
+    constexpr bool operator==(const Box & aRhs) const
+    { return mMin == aRhs.mMin && mMax == aRhs.mMax; }
+    constexpr bool operator!=(const Box & aRhs) const
+    { return !(*this == aRhs); }
+
+    /// \brief Bounds are inclusive.
+    constexpr bool contains(const position_type & aPosition) const;
+    constexpr bool contains(const Box & aOther) const;
+    constexpr bool intersects(const Box & aOther) const;
+
+    /// \brief Common part of both boxes, which is empty if they do not intersect.
+    constexpr Box intersect(const Box & aOther) const;
+    /// \brief Smallest box containing both boxes.
+    constexpr Box unite(const Box & aOther) const;
+
+    /// \brief Grows the box to contain aPosition.
+    constexpr Box & expand(const position_type & aPosition);
+    /// \brief Grows the box to contain aOther.
+    constexpr Box & expand(const Box & aOther);
+    /// \brief Moves each face outward by aMargin (inward if negative).
+    constexpr Box & grow(T_number aMargin);
+
+    constexpr position_type closestPoint(const position_type & aPosition) const;
+    /// \brief Null for positions inside the box.
+    constexpr T_number squaredDistance(const position_type & aPosition) const;
+    /*constexpr*/ T_number distance(const position_type & aPosition) const;
+
+    /// \brief Slab test of the ray `aOrigin + t.direction`, for t in [0, aMaxDistance].
+    ///
+    /// \param aInverseDirection Component-wise inverse of the ray direction,
+    /// infinite for null components.
+    /// \return The smallest t at which the ray is in the box, if any.
+    /// \note A ray parallel to a face, with its origin exactly on this face's plane, gives NaNs:
+    /// it may be reported as missing the box.
+    std::optional<T_number> intersectRay(const position_type & aOrigin,
+                                         const Vec<N_dimension, T_number> & aInverseDirection,
+                                         T_number aMaxDistance = std::numeric_limits<T_number>::infinity()) const;
+
+    position_type mMin;
+    position_type mMax;
+};
+
+
+/***
+ * Batch operations
+ *
+ * Results are bitmasks of bitmaskWordCount(aCount) words (see Bitmask.h).
+ ***/
+
+/// \brief Boxes stored as a structure of arrays.
+template <int N_dimension, class T_number>
+struct BoxArrays
+{
+    /// \brief mMins[axis][i] is the min of box i along axis.
+    std::array<const T_number *, N_dimension> mMins;
+    /// \brief mMaxs[axis][i] is the max of box i along axis.
+    std::array<const T_number *, N_dimension> mMaxs;
+};
+
+
+/// \brief Batch Box::intersects(), testing aCount boxes against aQuery.
+template <int N_dimension, class T_number>
+void intersects(const Box<N_dimension, T_number> & aQuery,
+                const BoxArrays<N_dimension, T_number> & aBoxes,
+                std::size_t aCount,
+                std::uint64_t * aResults);
+
+/// \brief Batch Box::contains(), testing whether each of aCount boxes contains aPosition.
+template <int N_dimension, class T_number>
+void contains(const BoxArrays<N_dimension, T_number> & aBoxes,
+              std::size_t aCount,
+              const Position<N_dimension, T_number> & aPosition,
+              std::uint64_t * aResults);
+
+/// \brief Batch Box::intersectRay(), testing a single ray against aCount boxes.
+template <int N_dimension, class T_number>
+void intersectRay(const BoxArrays<N_dimension, T_number> & aBoxes,
+                  std::size_t aCount,
+                  const Position<N_dimension, T_number> & aOrigin,
+                  const Vec<N_dimension, T_number> & aInverseDirection,
+                  T_number aMaxDistance,
+                  std::uint64_t * aResults);
+
+
+/***
+ * Implementation
+ ***/
+
+template <int N_dimension, class T_number>
+constexpr Box<N_dimension, T_number> Box<N_dimension, T_number>::FromMinMax(position_type aMin,
+                                                                            position_type aMax)
+{
+    return {aMin, aMax};
+}
+
+
+template <int N_dimension, class T_number>
+constexpr Box<N_dimension, T_number> Box<N_dimension, T_number>::FromOriginSize(position_type aOrigin,
+                                                                                Size<N_dimension, T_number> aSize)
+{
+    return {aOrigin, aOrigin + static_cast<Vec<N_dimension, T_number>>(aSize)};
+}
+
+
+template <int N_dimension, class T_number>
+constexpr Box<N_dimension, T_number> Box<N_dimension, T_number>::Empty()
+{
+    position_type min = position_type::Zero();
+    position_type max = position_type::Zero();
+    for (std::size_t axis = 0; axis != N_dimension; ++axis)
+    {
+        min[axis] = std::numeric_limits<T_number>::max();
+        max[axis] = std::numeric_limits<T_number>::lowest();
+    }
+    return {min, max};
+}
+
+
+template <int N_dimension, class T_number>
+constexpr Size<N_dimension, T_number> Box<N_dimension, T_number>::size() const
+{
+    return static_cast<Size<N_dimension, T_number>>(mMax - mMin);
+}
+
+
+template <int N_dimension, class T_number>
+constexpr Position<N_dimension, T_number> Box<N_dimension, T_number>::center() const
+{
+    return mMin + (mMax - mMin) / T_number{2};
+}
+
+
+template <int N_dimension, class T_number>
+constexpr T_number Box<N_dimension, T_number>::volume() const
+{
+    if (isEmpty())
+    {
+        return T_number{0};
+    }
+
+    T_number result{1};
+    for (std::size_t axis = 0; axis != N_dimension; ++axis)
+    {
+        result *= mMax[axis] - mMin[axis];
+    }
+    return result;
+}
+
+
+template <int N_dimension, class T_number>
+constexpr bool Box<N_dimension, T_number>::isEmpty() const
+{
+    for (std::size_t axis = 0; axis != N_dimension; ++axis)
+    {
+        if (mMin[axis] > mMax[axis])
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+template <int N_dimension, class T_number>
+constexpr bool Box<N_dimension, T_number>::contains(const position_type & aPosition) const
+{
+    bool result = true;
+    for (std::size_t axis = 0; axis != N_dimension; ++axis)
+    {
+        result &= (aPosition[axis] >= mMin[axis]) & (aPosition[axis] <= mMax[axis]);
+    }
+    return result;
+}
+
+
+template <int N_dimension, class T_number>
+constexpr bool Box<N_dimension, T_number>::contains(const Box & aOther) const
+{
+    bool result = true;
+    for (std::size_t axis = 0; axis != N_dimension; ++axis)
+    {
+        result &= (aOther.mMin[axis] >= mMin[axis]) & (aOther.mMax[axis] <= mMax[axis]);
+    }
+    return result;
+}
+
+
+template <int N_dimension, class T_number>
+constexpr bool Box<N_dimension, T_number>::intersects(const Box & aOther) const
+{
+    bool result = true;
+    for (std::size_t axis = 0; axis != N_dimension; ++axis)
+    {
+        result &= (aOther.mMin[axis] <= mMax[axis]) & (aOther.mMax[axis] >= mMin[axis]);
+    }
+    return result;
+}
+
+
+template <int N_dimension, class T_number>
+constexpr Box<N_dimension, T_number> Box<N_dimension, T_number>::intersect(const Box & aOther) const
+{
+    Box result = *this;
+    for (std::size_t axis = 0; axis != N_dimension; ++axis)
+    {
+        result.mMin[axis] = std::max(mMin[axis], aOther.mMin[axis]);
+        result.mMax[axis] = std::min(mMax[axis], aOther.mMax[axis]);
+    }
+    return result;
+}
+
+
+template <int N_dimension, class T_number>
+constexpr Box<N_dimension, T_number> Box<N_dimension, T_number>::unite(const Box & aOther) const
+{
+    Box result = *this;
+    return result.expand(aOther);
+}
+
+
+template <int N_dimension, class T_number>
+constexpr Box<N_dimension, T_number> & Box<N_dimension, T_number>::expand(const position_type & aPosition)
+{
+    return expand(Box{aPosition, aPosition});
+}
+
+
+template <int N_dimension, class T_number>
+constexpr Box<N_dimension, T_number> & Box<N_dimension, T_number>::expand(const Box & aOther)
+{
+    for (std::size_t axis = 0; axis != N_dimension; ++axis)
+    {
+        mMin[axis] = std::min(mMin[axis], aOther.mMin[axis]);
+        mMax[axis] = std::max(mMax[axis], aOther.mMax[axis]);
+    }
+    return *this;
+}
+
+
+template <int N_dimension, class T_number>
+constexpr Box<N_dimension, T_number> & Box<N_dimension, T_number>::grow(T_number aMargin)
+{
+    for (std::size_t axis = 0; axis != N_dimension; ++axis)
+    {
+        mMin[axis] -= aMargin;
+        mMax[axis] += aMargin;
+    }
+    return *this;
+}
+
+
+template <int N_dimension, class T_number>
+constexpr Position<N_dimension, T_number>
+Box<N_dimension, T_number>::closestPoint(const position_type & aPosition) const
+{
+    position_type result = aPosition;
+    for (std::size_t axis = 0; axis != N_dimension; ++axis)
+    {
+        result[axis] = std::min(std::max(aPosition[axis], mMin[axis]), mMax[axis]);
+    }
+    return result;
+}
+
+
+template <int N_dimension, class T_number>
+constexpr T_number Box<N_dimension, T_number>::squaredDistance(const position_type & aPosition) const
+{
+    return (aPosition - closestPoint(aPosition)).getNormSquared();
+}
+
+
+template <int N_dimension, class T_number>
+T_number Box<N_dimension, T_number>::distance(const position_type & aPosition) const
+{
+    return std::sqrt(squaredDistance(aPosition));
+}
+
+
+template <int N_dimension, class T_number>
+std::optional<T_number> Box<N_dimension, T_number>::intersectRay(const position_type & aOrigin,
+                                                                 const Vec<N_dimension, T_number> & aInverseDirection,
+                                                                 T_number aMaxDistance) const
+{
+    T_number entry = 0;
+    T_number exit = aMaxDistance;
+    for (std::size_t axis = 0; axis != N_dimension; ++axis)
+    {
+        const T_number toMin = (mMin[axis] - aOrigin[axis]) * aInverseDirection[axis];
+        const T_number toMax = (mMax[axis] - aOrigin[axis]) * aInverseDirection[axis];
+        entry = std::max(entry, std::min(toMin, toMax));
+        exit = std::min(exit, std::max(toMin, toMax));
+    }
+    if (entry <= exit)
+    {
+        return entry;
+    }
+    return std::nullopt;
+}
+
+
+template <int N_dimension, class T_number>
+void intersects(const Box<N_dimension, T_number> & aQuery,
+                const BoxArrays<N_dimension, T_number> & aBoxes,
+                std::size_t aCount,
+                std::uint64_t * aResults)
+{
+    detail::packBits(aCount, aResults,
+                     [&](std::size_t aBegin, std::size_t aBlockCount, std::uint8_t * aFlags)
+    {
+        std::fill(aFlags, aFlags + aBlockCount, std::uint8_t{1});
+        // Axis by axis, so each inner loop is a simple stream over two arrays
+        for (std::size_t axis = 0; axis != N_dimension; ++axis)
+        {
+            // Locals, see detail::packBits()
+            const T_number queryMin = aQuery.mMin[axis];
+            const T_number queryMax = aQuery.mMax[axis];
+            const T_number * mins = aBoxes.mMins[axis] + aBegin;
+            const T_number * maxs = aBoxes.mMaxs[axis] + aBegin;
+            for (std::size_t index = 0; index != aBlockCount; ++index)
+            {
+                aFlags[index] &= (mins[index] <= queryMax) & (maxs[index] >= queryMin);
+            }
+        }
+    });
+}
+
+
+template <int N_dimension, class T_number>
+void contains(const BoxArrays<N_dimension, T_number> & aBoxes,
+              std::size_t aCount,
+              const Position<N_dimension, T_number> & aPosition,
+              std::uint64_t * aResults)
+{
+    intersects(Box<N_dimension, T_number>{aPosition, aPosition}, aBoxes, aCount, aResults);
+}
+
+
+template <int N_dimension, class T_number>
+void intersectRay(const BoxArrays<N_dimension, T_number> & aBoxes,
+                  std::size_t aCount,
+                  const Position<N_dimension, T_number> & aOrigin,
+                  const Vec<N_dimension, T_number> & aInverseDirection,
+                  T_number aMaxDistance,
+                  std::uint64_t * aResults)
+{
+    detail::packBits(aCount, aResults,
+                     [&](std::size_t aBegin, std::size_t aBlockCount, std::uint8_t * aFlags)
+    {
+        T_number entries[64];
+        T_number exits[64];
+        std::fill(entries, entries + aBlockCount, T_number{0});
+        std::fill(exits, exits + aBlockCount, aMaxDistance);
+
+        for (std::size_t axis = 0; axis != N_dimension; ++axis)
+        {
+            const T_number origin = aOrigin[axis];
+            const T_number inverse = aInverseDirection[axis];
+            const T_number * mins = aBoxes.mMins[axis] + aBegin;
+            const T_number * maxs = aBoxes.mMaxs[axis] + aBegin;
+            for (std::size_t index = 0; index != aBlockCount; ++index)
+            {
+                const T_number toMin = (mins[index] - origin) * inverse;
+                const T_number toMax = (maxs[index] - origin) * inverse;
+                // Written as comparisons, which compilers turn into vector min and max
+                const T_number nearest = toMin < toMax ? toMin : toMax;
+                const T_number farthest = toMin < toMax ? toMax : toMin;
+                entries[index] = entries[index] < nearest ? nearest : entries[index];
+                exits[index] = exits[index] < farthest ? exits[index] : farthest;
+            }
+        }
+
+        for (std::size_t index = 0; index != aBlockCount; ++index)
+        {
+            aFlags[index] = entries[index] <= exits[index];
+        }
+    });
+}
+
+
+}} // namespace ad::math
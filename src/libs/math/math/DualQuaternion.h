@@ -0,0 +1,313 @@
+#pragma once
+
+
+#include "Affine.h"
+#include "Angle.h"
+#include "Quaternion.h"
+#include "Trigonometry.h"
+#include "Vector.h"
+
+#include <cmath>
+#include <cstdint>
+
+
+namespace ad {
+namespace math {
+
+
+/// \brief Dual quaternion `real + e.dual`, representing a rigid transformation.
+///
+/// The represented transformation rotates by the real part, then translates.
+/// Composition follows the row vector convention of the library:
+/// `a * b` applies `a`, then `b`.
+template <class T_number=real_number>
+class DualQuaternion
+{
+public:
+    using quaternion_type = Quaternion<T_number>;
+
+    constexpr DualQuaternion(quaternion_type aReal, quaternion_type aDual);
+
+    /// \brief Rotation by the unit quaternion aRotation, followed by aTranslation.
+    constexpr DualQuaternion(const quaternion_type & aRotation, const Vec<3, T_number> & aTranslation);
+
+    /// \brief Rotation of aAngle around aAxis, followed by aTranslation.
+    template <class T_unitTag>
+    DualQuaternion(const Angle<T_number, T_unitTag> aAngle,
+                   const UnitVec<3, T_number> aAxis,
+                   const Vec<3, T_number> & aTranslation);
+
+    static constexpr DualQuaternion Identity();
+
+    constexpr const quaternion_type & getReal() const
+    { return mReal; }
+
+    constexpr const quaternion_type & getDual() const
+    { return mDual; }
+
+    /// \brief For unit dual quaternions, the rotation is the real part.
+    constexpr const quaternion_type & getRotation() const
+    { return mReal; }
+
+    constexpr Vec<3, T_number> getTranslation() const;
+
+    /// \brief Quaternion conjugate of both parts, which is the inverse of unit dual quaternions.
+    constexpr DualQuaternion conjugate() const;
+
+    /// \brief Inverse of the rigid transformation.
+    constexpr DualQuaternion inverse() const;
+
+    /// \brief Scales both parts so the real part has norm 1.
+    DualQuaternion & normalize();
+
+    constexpr DualQuaternion & operator*=(const DualQuaternion & aRhs);
+
+    // Implementer's note: Not constexpr, because Quaternion::rotate() is not
+    /*constexpr*/ Position<3, T_number> transform(const Position<3, T_number> & aPosition) const;
+
+    /// \brief Rotates aVector, displacements not being affected by the translation.
+    /*constexpr*/ Vec<3, T_number> transform(const Vec<3, T_number> & aVector) const;
+
+    constexpr Affine<3, T_number> toAffine() const;
+
+private:
+    quaternion_type mReal;
+    quaternion_type mDual;
+};
+
+
+template <class T_number>
+constexpr DualQuaternion<T_number> operator*(DualQuaternion<T_number> aLhs,
+                                             const DualQuaternion<T_number> & aRhs)
+{
+    return aLhs *= aRhs;
+}
+
+template <class T_number>
+Position<3, T_number> operator*(const Position<3, T_number> & aLhs, const DualQuaternion<T_number> & aRhs)
+{
+    return aRhs.transform(aLhs);
+}
+
+template <class T_number>
+Vec<3, T_number> operator*(const Vec<3, T_number> & aLhs, const DualQuaternion<T_number> & aRhs)
+{
+    return aRhs.transform(aLhs);
+}
+
+template <class T_number>
+constexpr bool operator==(const DualQuaternion<T_number> & aLhs, const DualQuaternion<T_number> & aRhs)
+{
+    return aLhs.getReal() == aRhs.getReal() && aLhs.getDual() == aRhs.getDual();
+}
+
+template <class T_number>
+constexpr bool operator!=(const DualQuaternion<T_number> & aLhs, const DualQuaternion<T_number> & aRhs)
+{
+    return !(aLhs == aRhs);
+}
+
+
+/***
+ * Blending
+ ***/
+
+/// \brief Dual quaternion linear blending of aCount transformations, normalized.
+///
+/// Each dual quaternion is negated if needed, so it blends along the shortest path from the first one.
+template <class T_number>
+DualQuaternion<T_number> blend(const DualQuaternion<T_number> * aTransformations,
+                               const T_number * aWeights,
+                               std::size_t aCount);
+
+
+/// \brief Skins aCount vertices, stored as a structure of arrays, by dual quaternion linear blending.
+///
+/// \tparam N_influences The number of bones influencing each vertex.
+/// \param aBoneIndices For each vertex, N_influences consecutive indices into aBones.
+/// \param aBoneWeights For each vertex, N_influences consecutive weights.
+///
+/// \note Each vertex reads 8 values per influence, instead of the 12 of a matrix palette.
+template <int N_influences, class T_number>
+void skin(const DualQuaternion<T_number> * aBones,
+          const std::uint32_t * aBoneIndices,
+          const T_number * aBoneWeights,
+          const T_number * aX, const T_number * aY, const T_number * aZ,
+          std::size_t aCount,
+          T_number * aResultX, T_number * aResultY, T_number * aResultZ);
+
+
+/***
+ * Implementation
+ ***/
+
+template <class T_number>
+constexpr DualQuaternion<T_number>::DualQuaternion(quaternion_type aReal, quaternion_type aDual) :
+    mReal{aReal},
+    mDual{aDual}
+{}
+
+
+template <class T_number>
+constexpr DualQuaternion<T_number>::DualQuaternion(const quaternion_type & aRotation,
+                                                   const Vec<3, T_number> & aTranslation) :
+    mReal{aRotation},
+    // Hamilton product t.r/2, where t is the pure quaternion of the translation
+    mDual{aRotation
+          * quaternion_type{aTranslation.x(), aTranslation.y(), aTranslation.z(), T_number{0}}
+          / T_number{2}}
+{}
+
+
+template <class T_number>
+template <class T_unitTag>
+DualQuaternion<T_number>::DualQuaternion(const Angle<T_number, T_unitTag> aAngle,
+                                         const UnitVec<3, T_number> aAxis,
+                                         const Vec<3, T_number> & aTranslation) :
+    DualQuaternion{quaternion_type{aAngle, aAxis}, aTranslation}
+{}
+
+
+template <class T_number>
+constexpr DualQuaternion<T_number> DualQuaternion<T_number>::Identity()
+{
+    return {quaternion_type::Identity(), quaternion_type::Zero()};
+}
+
+
+template <class T_number>
+constexpr Vec<3, T_number> DualQuaternion<T_number>::getTranslation() const
+{
+    // Hamilton product 2.d.r*
+    return (mReal.conjugate() * mDual).getVector() * T_number{2};
+}
+
+
+template <class T_number>
+constexpr DualQuaternion<T_number> DualQuaternion<T_number>::conjugate() const
+{
+    return {mReal.conjugate(), mDual.conjugate()};
+}
+
+
+template <class T_number>
+constexpr DualQuaternion<T_number> DualQuaternion<T_number>::inverse() const
+{
+    return conjugate();
+}
+
+
+template <class T_number>
+DualQuaternion<T_number> & DualQuaternion<T_number>::normalize()
+{
+    const T_number norm = mReal.getNorm();
+    mReal /= norm;
+    mDual /= norm;
+    return *this;
+}
+
+
+template <class T_number>
+constexpr DualQuaternion<T_number> & DualQuaternion<T_number>::operator*=(const DualQuaternion & aRhs)
+{
+    // Quaternion products already compose in application order
+    mDual = mDual * aRhs.mReal + mReal * aRhs.mDual;
+    mReal *= aRhs.mReal;
+    return *this;
+}
+
+
+template <class T_number>
+Position<3, T_number> DualQuaternion<T_number>::transform(const Position<3, T_number> & aPosition) const
+{
+    const Vec<3, T_number> rotated = mReal.rotate(static_cast<Vec<3, T_number>>(aPosition));
+    return static_cast<Position<3, T_number>>(rotated + getTranslation());
+}
+
+
+template <class T_number>
+Vec<3, T_number> DualQuaternion<T_number>::transform(const Vec<3, T_number> & aVector) const
+{
+    return mReal.rotate(aVector);
+}
+
+
+template <class T_number>
+constexpr Affine<3, T_number> DualQuaternion<T_number>::toAffine() const
+{
+    return {mReal.toRotationMatrix(), getTranslation()};
+}
+
+
+template <class T_number>
+DualQuaternion<T_number> blend(const DualQuaternion<T_number> * aTransformations,
+                               const T_number * aWeights,
+                               std::size_t aCount)
+{
+    Quaternion<T_number> real = Quaternion<T_number>::Zero();
+    Quaternion<T_number> dual = Quaternion<T_number>::Zero();
+    for (std::size_t index = 0; index != aCount; ++index)
+    {
+        const DualQuaternion<T_number> & transformation = aTransformations[index];
+        const T_number weight =
+            (transformation.getReal().dot(aTransformations[0].getReal()) < 0) ? -aWeights[index]
+                                                                               : aWeights[index];
+        real += transformation.getReal() * weight;
+        dual += transformation.getDual() * weight;
+    }
+    return DualQuaternion<T_number>{real, dual}.normalize();
+}
+
+
+template <int N_influences, class T_number>
+void skin(const DualQuaternion<T_number> * aBones,
+          const std::uint32_t * aBoneIndices,
+          const T_number * aBoneWeights,
+          const T_number * aX, const T_number * aY, const T_number * aZ,
+          std::size_t aCount,
+          T_number * aResultX, T_number * aResultY, T_number * aResultZ)
+{
+    for (std::size_t vertex = 0; vertex != aCount; ++vertex)
+    {
+        const std::uint32_t * indices = aBoneIndices + vertex * N_influences;
+        const T_number * weights = aBoneWeights + vertex * N_influences;
+
+        // Blended components, as (x, y, z, w) of the real then of the dual part
+        T_number b[8] = {};
+        const DualQuaternion<T_number> & pivot = aBones[indices[0]];
+        for (int influence = 0; influence != N_influences; ++influence)
+        {
+            const DualQuaternion<T_number> & bone = aBones[indices[influence]];
+            const T_number weight = detail::select(bone.getReal().dot(pivot.getReal()) < 0,
+                                                   -weights[influence],
+                                                   weights[influence]);
+            for (std::size_t component = 0; component != 4; ++component)
+            {
+                b[component] += bone.getReal()[component] * weight;
+                b[component + 4] += bone.getDual()[component] * weight;
+            }
+        }
+
+        // The rotation is applied on the non-normalized blend, hence the division by the squared norm
+        const T_number normSquared = b[0]*b[0] + b[1]*b[1] + b[2]*b[2] + b[3]*b[3];
+        const T_number inverseNormSquared = 1 / normSquared;
+
+        const T_number x = aX[vertex], y = aY[vertex], z = aZ[vertex];
+        // p' = p + 2 r x (r x p + w.p) / |q|^2
+        const T_number ux = b[1]*z - b[2]*y + b[3]*x;
+        const T_number uy = b[2]*x - b[0]*z + b[3]*y;
+        const T_number uz = b[0]*y - b[1]*x + b[3]*z;
+        // t = 2 (w.d - dw.r + r x d) / |q|^2
+        const T_number tx = b[3]*b[4] - b[7]*b[0] + b[1]*b[6] - b[2]*b[5];
+        const T_number ty = b[3]*b[5] - b[7]*b[1] + b[2]*b[4] - b[0]*b[6];
+        const T_number tz = b[3]*b[6] - b[7]*b[2] + b[0]*b[5] - b[1]*b[4];
+
+        const T_number scale = 2 * inverseNormSquared;
+        aResultX[vertex] = x + scale * (b[1]*uz - b[2]*uy + tx);
+        aResultY[vertex] = y + scale * (b[2]*ux - b[0]*uz + ty);
+        aResultZ[vertex] = z + scale * (b[0]*uy - b[1]*ux + tz);
+    }
+}
+
+
+}} // namespace ad::math
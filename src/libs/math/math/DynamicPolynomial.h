@@ -0,0 +1,441 @@
+#pragma once
+
+
+#include "Constants.h"
+#include "Polynomial.h"
+
+#include <complex>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+
+
+namespace ad {
+namespace math {
+
+
+namespace detail {
+
+
+    /// \brief The complex type used to multiply polynomials of T_number via FFT.
+    ///
+    /// Single precision is promoted, its round-off errors would be too large on long products.
+    template <class T_number>
+    using fft_complex = std::complex<std::common_type_t<T_number, double>>;
+
+
+    /// \brief Complex product, without the checks for infinities and NaNs of std::complex operator*.
+    template <class T_real>
+    std::complex<T_real> multiply(std::complex<T_real> aLhs, std::complex<T_real> aRhs)
+    {
+        return {aLhs.real() * aRhs.real() - aLhs.imag() * aRhs.imag(),
+                aLhs.real() * aRhs.imag() + aLhs.imag() * aRhs.real()};
+    }
+
+
+    /// \brief In place iterative radix-2 FFT.
+    ///
+    /// \param aRoots The aValues.size()/2 first powers of the primitive root of unity `exp(-2*i*pi / size)`.
+    /// \param aInverse Transforms with the conjugate roots, without the `1 / size` normalization.
+    /// \attention aValues.size() must be a power of two.
+    template <class T_real>
+    void fft(std::vector<std::complex<T_real>> & aValues,
+             const std::vector<std::complex<T_real>> & aRoots,
+             bool aInverse)
+    {
+        const std::size_t size = aValues.size();
+        assert((size & (size - 1)) == 0);
+
+        // Bit reversal permutation
+        for (std::size_t index = 1, reversed = 0; index < size; ++index)
+        {
+            std::size_t bit = size >> 1;
+            for (; reversed & bit; bit >>= 1)
+            {
+                reversed ^= bit;
+            }
+            reversed ^= bit;
+            if (index < reversed)
+            {
+                std::swap(aValues[index], aValues[reversed]);
+            }
+        }
+
+        for (std::size_t length = 2; length <= size; length <<= 1)
+        {
+            const std::size_t half = length / 2;
+            const std::size_t stride = size / length;
+            for (std::size_t start = 0; start < size; start += length)
+            {
+                for (std::size_t offset = 0; offset != half; ++offset)
+                {
+                    const std::complex<T_real> root = aInverse ? std::conj(aRoots[offset * stride])
+                                                               : aRoots[offset * stride];
+                    const std::complex<T_real> even = aValues[start + offset];
+                    const std::complex<T_real> odd = multiply(aValues[start + offset + half], root);
+                    aValues[start + offset] = even + odd;
+                    aValues[start + offset + half] = even - odd;
+                }
+            }
+        }
+    }
+
+
+    /// \brief Product of two real coefficient sequences, with a single forward and a single inverse transform.
+    template <class T_number>
+    std::vector<T_number> multiplyFft(const std::vector<T_number> & aLhs, const std::vector<T_number> & aRhs)
+    {
+        using complex_type = fft_complex<T_number>;
+        using real_type = typename complex_type::value_type;
+
+        const std::size_t resultCount = aLhs.size() + aRhs.size() - 1;
+        std::size_t size = 1;
+        while (size < resultCount)
+        {
+            size <<= 1;
+        }
+
+        std::vector<complex_type> roots(size / 2);
+        for (std::size_t index = 0; index != roots.size(); ++index)
+        {
+            const real_type angle = -2 * pi<real_type> * static_cast<real_type>(index) / static_cast<real_type>(size);
+            roots[index] = {std::cos(angle), std::sin(angle)};
+        }
+
+        // Both real sequences are packed in a single complex signal, as real and imaginary parts
+        std::vector<complex_type> signal(size);
+        for (std::size_t index = 0; index != aLhs.size(); ++index)
+        {
+            signal[index].real(static_cast<real_type>(aLhs[index]));
+        }
+        for (std::size_t index = 0; index != aRhs.size(); ++index)
+        {
+            signal[index].imag(static_cast<real_type>(aRhs[index]));
+        }
+        fft(signal, roots, false);
+
+        // The spectra of the real sequences are separated by the conjugate symmetry,
+        // their product being `(S[k]^2 - conj(S[size-k])^2) / 4i`
+        std::vector<complex_type> product(size);
+        for (std::size_t index = 0; index != size; ++index)
+        {
+            const complex_type direct = signal[index];
+            const complex_type mirrored = std::conj(signal[(size - index) & (size - 1)]);
+            const complex_type difference = multiply(direct, direct) - multiply(mirrored, mirrored);
+            product[index] = {difference.imag() / 4, -difference.real() / 4};
+        }
+        fft(product, roots, true);
+
+        std::vector<T_number> result;
+        result.reserve(resultCount);
+        for (std::size_t index = 0; index != resultCount; ++index)
+        {
+            result.push_back(static_cast<T_number>(product[index].real() / static_cast<real_type>(size)));
+        }
+        return result;
+    }
+
+
+} // namespace detail
+
+
+/// \brief Polynomial whose degree is only known at runtime, e.g. the product of many factors.
+///
+/// Trailing null coefficients are removed, so the degree is the degree of the leading non-null coefficient.
+/// The null polynomial has degree 0.
+template <class T_number=double>
+class DynamicPolynomial
+{
+public:
+    /// \brief For floating point numbers, products where both operands have at least this many
+    /// coefficients are computed via FFT, in `O(n.log(n))` instead of `O(n^2)`.
+    ///
+    /// The result then has round-off errors relative to the largest coefficients of the operands.
+    static constexpr std::size_t gFftThreshold = 128;
+
+    /// \brief The null polynomial.
+    DynamicPolynomial();
+
+    /// \parameter aCoefficients Given in increasing degree.
+    DynamicPolynomial(std::initializer_list<T_number> aCoefficients);
+
+    /// \parameter aCoefficients Given in increasing degree.
+    explicit DynamicPolynomial(std::vector<T_number> aCoefficients);
+
+    template <int N_degree>
+    DynamicPolynomial(const Polynomial<N_degree, T_number> & aPolynomial);
+
+    std::size_t degree() const
+    { return mCoefficients.size() - 1; }
+
+    T_number coefficient(std::size_t aIndex) const
+    { return mCoefficients.at(aIndex); }
+
+    /// \brief The coefficients in increasing degree.
+    const std::vector<T_number> & coefficients() const
+    { return mCoefficients; }
+
+    /// \brief Evaluates the polynomial with Horner's scheme.
+    T_number evaluate(T_number aVariableValue) const;
+
+    /// \brief Reads aCount values from aVariableValues, and writes aCount results to aResults.
+    ///
+    /// aResults may be aVariableValues, for an in place evaluation.
+    void evaluate(const T_number * aVariableValues, std::size_t aCount, T_number * aResults) const;
+
+    DynamicPolynomial derivative() const;
+
+    /// \brief The antiderivative taking the value aConstant at 0.
+    DynamicPolynomial integral(T_number aConstant = T_number{0}) const;
+
+    /// \brief The polynomial `x -> this(aInner(x))`.
+    DynamicPolynomial compose(const DynamicPolynomial & aInner) const;
+
+    DynamicPolynomial operator-() const;
+
+    DynamicPolynomial & operator+=(const DynamicPolynomial & aRhs);
+    DynamicPolynomial & operator-=(const DynamicPolynomial & aRhs);
+    DynamicPolynomial & operator*=(const DynamicPolynomial & aRhs);
+    DynamicPolynomial & operator*=(T_number aScalar);
+
+    bool operator==(const DynamicPolynomial & aRhs) const
+    { return mCoefficients == aRhs.mCoefficients; }
+
+    bool operator!=(const DynamicPolynomial & aRhs) const
+    { return !(*this == aRhs); }
+
+private:
+    /// \brief Removes the trailing null coefficients, keeping at least the constant.
+    void trim();
+
+    std::vector<T_number> mCoefficients;
+};
+
+
+template <class T_number>
+DynamicPolynomial<T_number> operator+(DynamicPolynomial<T_number> aLhs, const DynamicPolynomial<T_number> & aRhs)
+{ return aLhs += aRhs; }
+
+template <class T_number>
+DynamicPolynomial<T_number> operator-(DynamicPolynomial<T_number> aLhs, const DynamicPolynomial<T_number> & aRhs)
+{ return aLhs -= aRhs; }
+
+template <class T_number>
+DynamicPolynomial<T_number> operator*(DynamicPolynomial<T_number> aLhs, const DynamicPolynomial<T_number> & aRhs)
+{ return aLhs *= aRhs; }
+
+template <class T_number>
+DynamicPolynomial<T_number> operator*(DynamicPolynomial<T_number> aLhs, T_number aRhs)
+{ return aLhs *= aRhs; }
+
+template <class T_number>
+DynamicPolynomial<T_number> operator*(T_number aLhs, DynamicPolynomial<T_number> aRhs)
+{ return aRhs *= aLhs; }
+
+
+//
+// Implementation
+//
+template <class T_number>
+DynamicPolynomial<T_number>::DynamicPolynomial() :
+    mCoefficients{T_number{0}}
+{}
+
+
+template <class T_number>
+DynamicPolynomial<T_number>::DynamicPolynomial(std::initializer_list<T_number> aCoefficients) :
+    DynamicPolynomial{std::vector<T_number>(aCoefficients)}
+{}
+
+
+template <class T_number>
+DynamicPolynomial<T_number>::DynamicPolynomial(std::vector<T_number> aCoefficients) :
+    mCoefficients{std::move(aCoefficients)}
+{
+    trim();
+}
+
+
+template <class T_number>
+template <int N_degree>
+DynamicPolynomial<T_number>::DynamicPolynomial(const Polynomial<N_degree, T_number> & aPolynomial) :
+    DynamicPolynomial{std::vector<T_number>(aPolynomial.coefficients().begin(),
+                                            aPolynomial.coefficients().end())}
+{}
+
+
+template <class T_number>
+void DynamicPolynomial<T_number>::trim()
+{
+    while (mCoefficients.size() > 1 && mCoefficients.back() == T_number{0})
+    {
+        mCoefficients.pop_back();
+    }
+    if (mCoefficients.empty())
+    {
+        mCoefficients.push_back(T_number{0});
+    }
+}
+
+
+template <class T_number>
+T_number DynamicPolynomial<T_number>::evaluate(T_number aVariableValue) const
+{
+    T_number accumulator = mCoefficients.back();
+    for (std::size_t degree = mCoefficients.size() - 1; degree != 0; --degree)
+    {
+        accumulator = accumulator * aVariableValue + mCoefficients[degree - 1];
+    }
+    return accumulator;
+}
+
+
+template <class T_number>
+void DynamicPolynomial<T_number>::evaluate(const T_number * aVariableValues, std::size_t aCount,
+                                           T_number * aResults) const
+{
+    const T_number * coefficients = mCoefficients.data();
+    const std::size_t degree = this->degree();
+    for (std::size_t index = 0; index != aCount; ++index)
+    {
+        const T_number value = aVariableValues[index];
+        T_number accumulator = coefficients[degree];
+        for (std::size_t coefficient = degree; coefficient != 0; --coefficient)
+        {
+            accumulator = accumulator * value + coefficients[coefficient - 1];
+        }
+        aResults[index] = accumulator;
+    }
+}
+
+
+template <class T_number>
+DynamicPolynomial<T_number> DynamicPolynomial<T_number>::derivative() const
+{
+    std::vector<T_number> result;
+    result.reserve(mCoefficients.size());
+    for (std::size_t degree = 1; degree < mCoefficients.size(); ++degree)
+    {
+        result.push_back(static_cast<T_number>(degree) * mCoefficients[degree]);
+    }
+    return DynamicPolynomial{std::move(result)};
+}
+
+
+template <class T_number>
+DynamicPolynomial<T_number> DynamicPolynomial<T_number>::integral(T_number aConstant) const
+{
+    std::vector<T_number> result;
+    result.reserve(mCoefficients.size() + 1);
+    result.push_back(aConstant);
+    for (std::size_t degree = 0; degree != mCoefficients.size(); ++degree)
+    {
+        result.push_back(mCoefficients[degree] / static_cast<T_number>(degree + 1));
+    }
+    return DynamicPolynomial{std::move(result)};
+}
+
+
+template <class T_number>
+DynamicPolynomial<T_number> DynamicPolynomial<T_number>::compose(const DynamicPolynomial & aInner) const
+{
+    // Horner's scheme, where the variable is the inner polynomial
+    DynamicPolynomial result{mCoefficients.back()};
+    for (std::size_t degree = mCoefficients.size() - 1; degree != 0; --degree)
+    {
+        result *= aInner;
+        result += DynamicPolynomial{mCoefficients[degree - 1]};
+    }
+    return result;
+}
+
+
+template <class T_number>
+DynamicPolynomial<T_number> DynamicPolynomial<T_number>::operator-() const
+{
+    DynamicPolynomial result = *this;
+    for (T_number & coefficient : result.mCoefficients)
+    {
+        coefficient = -coefficient;
+    }
+    return result;
+}
+
+
+template <class T_number>
+DynamicPolynomial<T_number> & DynamicPolynomial<T_number>::operator+=(const DynamicPolynomial & aRhs)
+{
+    if (aRhs.mCoefficients.size() > mCoefficients.size())
+    {
+        mCoefficients.resize(aRhs.mCoefficients.size(), T_number{0});
+    }
+    for (std::size_t degree = 0; degree != aRhs.mCoefficients.size(); ++degree)
+    {
+        mCoefficients[degree] += aRhs.mCoefficients[degree];
+    }
+    trim();
+    return *this;
+}
+
+
+template <class T_number>
+DynamicPolynomial<T_number> & DynamicPolynomial<T_number>::operator-=(const DynamicPolynomial & aRhs)
+{
+    if (aRhs.mCoefficients.size() > mCoefficients.size())
+    {
+        mCoefficients.resize(aRhs.mCoefficients.size(), T_number{0});
+    }
+    for (std::size_t degree = 0; degree != aRhs.mCoefficients.size(); ++degree)
+    {
+        mCoefficients[degree] -= aRhs.mCoefficients[degree];
+    }
+    trim();
+    return *this;
+}
+
+
+template <class T_number>
+DynamicPolynomial<T_number> & DynamicPolynomial<T_number>::operator*=(const DynamicPolynomial & aRhs)
+{
+    if constexpr (std::is_floating_point_v<T_number>)
+    {
+        if (mCoefficients.size() >= gFftThreshold && aRhs.mCoefficients.size() >= gFftThreshold)
+        {
+            mCoefficients = detail::multiplyFft(mCoefficients, aRhs.mCoefficients);
+            trim();
+            return *this;
+        }
+    }
+
+    std::vector<T_number> result(mCoefficients.size() + aRhs.mCoefficients.size() - 1, T_number{0});
+    for (std::size_t left = 0; left != mCoefficients.size(); ++left)
+    {
+        for (std::size_t right = 0; right != aRhs.mCoefficients.size(); ++right)
+        {
+            result[left + right] += mCoefficients[left] * aRhs.mCoefficients[right];
+        }
+    }
+    mCoefficients = std::move(result);
+    trim();
+    return *this;
+}
+
+
+template <class T_number>
+DynamicPolynomial<T_number> & DynamicPolynomial<T_number>::operator*=(T_number aScalar)
+{
+    for (T_number & coefficient : mCoefficients)
+    {
+        coefficient *= aScalar;
+    }
+    trim();
+    return *this;
+}
+
+
+}} // namespace ad::math
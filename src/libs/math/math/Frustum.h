@@ -0,0 +1,216 @@
+#pragma once
+
+
+#include "Bitmask.h"
+#include "Matrix.h"
+#include "Vector.h"
+
+#include <algorithm>
+#include <array>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace ad {
+namespace math {
+
+
+/// \brief Visibility volume of a camera, as 6 planes pointing inward.
+///
+/// Each plane is a Vec<4> (a, b, c, d) with a normalized (a, b, c) normal,
+/// a position p being on the inner side when `a.x + b.y + c.z + d >= 0`.
+template <class T_number=real_number>
+class Frustum
+{
+public:
+    enum Plane
+    {
+        Left,
+        Right,
+        Bottom,
+        Top,
+        Near,
+        Far,
+    };
+
+    static constexpr std::size_t plane_count = 6;
+
+    /// \brief Extracts the planes of a projection (or view-projection) matrix.
+    ///
+    /// The matrix maps row vectors to OpenGL clip space, as produced by trans3d::perspective()
+    /// and trans3d::orthographic(). The planes are expressed in the space of the transformed positions,
+    /// e.g. the world space for a view-projection matrix.
+    explicit Frustum(const Matrix<4, 4, T_number> & aProjection);
+
+    Vec<4, T_number> getPlane(Plane aPlane) const
+    { return {mPlanes[aPlane][0], mPlanes[aPlane][1], mPlanes[aPlane][2], mPlanes[aPlane][3]}; }
+
+    bool contains(const Position<3, T_number> & aPosition) const;
+
+    /// \brief Conservative: can report spheres outside the frustum, near its corners, as intersecting.
+    bool intersectsSphere(const Position<3, T_number> & aCenter, T_number aRadius) const;
+
+    /// \brief Conservative: can report boxes outside the frustum, near its corners, as intersecting.
+    bool intersectsBox(const Position<3, T_number> & aCenter, const Vec<3, T_number> & aHalfExtents) const;
+
+    /// \brief Batch intersectsSphere() over spheres stored as a structure of arrays.
+    ///
+    /// \param aVisibility Receives one bit per sphere, in bitmaskWordCount(aCount) words (see Bitmask.h).
+    void intersectSpheres(const T_number * aX, const T_number * aY, const T_number * aZ,
+                          const T_number * aRadii,
+                          std::size_t aCount,
+                          std::uint64_t * aVisibility) const;
+
+    /// \brief Batch intersectsBox() over boxes stored as a structure of arrays.
+    ///
+    /// \param aVisibility Same layout as for intersectSpheres().
+    void intersectBoxes(const T_number * aCenterX, const T_number * aCenterY, const T_number * aCenterZ,
+                        const T_number * aHalfX, const T_number * aHalfY, const T_number * aHalfZ,
+                        std::size_t aCount,
+                        std::uint64_t * aVisibility) const;
+
+private:
+    using plane_type = std::array<T_number, 4>;
+    std::array<plane_type, plane_count> mPlanes;
+};
+
+
+//
+// Implementation
+//
+template <class T_number>
+Frustum<T_number>::Frustum(const Matrix<4, 4, T_number> & aProjection)
+{
+    // Gribb & Hartmann: the clip coordinate c_i of a row vector p is p.column_i.
+    // A position is inside when -c_w <= c_i <= c_w for x, y and z.
+    auto setPlane = [&aProjection, this](Plane aPlane, std::size_t aColumn, T_number aSign)
+    {
+        plane_type & plane = mPlanes[aPlane];
+        for (std::size_t row = 0; row != 4; ++row)
+        {
+            plane[row] = aProjection.at(row, 3) + aSign * aProjection.at(row, aColumn);
+        }
+        const T_number normalNorm = std::sqrt(plane[0]*plane[0] + plane[1]*plane[1] + plane[2]*plane[2]);
+        for (T_number & coefficient : plane)
+        {
+            coefficient /= normalNorm;
+        }
+    };
+
+    setPlane(Left, 0, 1);
+    setPlane(Right, 0, -1);
+    setPlane(Bottom, 1, 1);
+    setPlane(Top, 1, -1);
+    setPlane(Near, 2, 1);
+    setPlane(Far, 2, -1);
+}
+
+
+template <class T_number>
+bool Frustum<T_number>::contains(const Position<3, T_number> & aPosition) const
+{
+    return intersectsSphere(aPosition, T_number{0});
+}
+
+
+template <class T_number>
+bool Frustum<T_number>::intersectsSphere(const Position<3, T_number> & aCenter, T_number aRadius) const
+{
+    for (const plane_type & plane : mPlanes)
+    {
+        if (plane[0]*aCenter.x() + plane[1]*aCenter.y() + plane[2]*aCenter.z() + plane[3] < -aRadius)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+template <class T_number>
+bool Frustum<T_number>::intersectsBox(const Position<3, T_number> & aCenter,
+                                      const Vec<3, T_number> & aHalfExtents) const
+{
+    for (const plane_type & plane : mPlanes)
+    {
+        // Projection of the half extents on the plane normal
+        const T_number radius = std::abs(plane[0])*aHalfExtents.x()
+                                + std::abs(plane[1])*aHalfExtents.y()
+                                + std::abs(plane[2])*aHalfExtents.z();
+        if (plane[0]*aCenter.x() + plane[1]*aCenter.y() + plane[2]*aCenter.z() + plane[3] < -radius)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+template <class T_number>
+void Frustum<T_number>::intersectSpheres(const T_number * aX, const T_number * aY, const T_number * aZ,
+                                         const T_number * aRadii,
+                                         std::size_t aCount,
+                                         std::uint64_t * aVisibility) const
+{
+    const std::array<plane_type, plane_count> planes = mPlanes;
+
+    detail::packBits(aCount, aVisibility,
+                     [&](std::size_t aBegin, std::size_t aBlockCount, std::uint8_t * aFlags)
+    {
+        const T_number * x = aX + aBegin;
+        const T_number * y = aY + aBegin;
+        const T_number * z = aZ + aBegin;
+        const T_number * radii = aRadii + aBegin;
+
+        std::fill(aFlags, aFlags + aBlockCount, std::uint8_t{1});
+        // Plane by plane, so each inner loop is free of branches
+        for (const plane_type & plane : planes)
+        {
+            // Copied to locals, see detail::packBits()
+            const T_number a = plane[0], b = plane[1], c = plane[2], d = plane[3];
+            for (std::size_t index = 0; index != aBlockCount; ++index)
+            {
+                aFlags[index] &= (a*x[index] + b*y[index] + c*z[index] + d >= -radii[index]);
+            }
+        }
+    });
+}
+
+
+template <class T_number>
+void Frustum<T_number>::intersectBoxes(const T_number * aCenterX, const T_number * aCenterY, const T_number * aCenterZ,
+                                       const T_number * aHalfX, const T_number * aHalfY, const T_number * aHalfZ,
+                                       std::size_t aCount,
+                                       std::uint64_t * aVisibility) const
+{
+    const std::array<plane_type, plane_count> planes = mPlanes;
+
+    detail::packBits(aCount, aVisibility,
+                     [&](std::size_t aBegin, std::size_t aBlockCount, std::uint8_t * aFlags)
+    {
+        const T_number * centerX = aCenterX + aBegin;
+        const T_number * centerY = aCenterY + aBegin;
+        const T_number * centerZ = aCenterZ + aBegin;
+        const T_number * halfX = aHalfX + aBegin;
+        const T_number * halfY = aHalfY + aBegin;
+        const T_number * halfZ = aHalfZ + aBegin;
+
+        std::fill(aFlags, aFlags + aBlockCount, std::uint8_t{1});
+        for (const plane_type & plane : planes)
+        {
+            const T_number a = plane[0], b = plane[1], c = plane[2], d = plane[3];
+            const T_number absA = std::abs(a), absB = std::abs(b), absC = std::abs(c);
+            for (std::size_t index = 0; index != aBlockCount; ++index)
+            {
+                // Projection of the half extents on the plane normal
+                const T_number radius = absA*halfX[index] + absB*halfY[index] + absC*halfZ[index];
+                aFlags[index] &= (a*centerX[index] + b*centerY[index] + c*centerZ[index] + d >= -radius);
+            }
+        }
+    });
+}
+
+
+}} // namespace ad::math
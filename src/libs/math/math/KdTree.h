@@ -0,0 +1,429 @@
+#pragma once
+
+
+#include "Parallel.h"
+#include "Vector.h"
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace ad {
+namespace math {
+
+
+/// \brief Balanced k-d tree over positions, for nearest, k-nearest and radius queries.
+///
+/// The tree is implicit: positions are reordered so that the node of a range [begin, end)
+/// is its middle element, with its left subtree in [begin, middle) and its right subtree in (middle, end).
+/// Only the split axis of each node is stored in addition to the positions, and no child pointers.
+/// Each node splits its range at the median along the largest extent of its positions.
+template <int N_dimension, class T_number=real_number>
+class KdTree
+{
+public:
+    using position_type = Position<N_dimension, T_number>;
+    using PointIndex = std::uint32_t;
+
+    static constexpr PointIndex gNoPoint = std::numeric_limits<PointIndex>::max();
+
+    struct Neighbour
+    {
+        /// \brief Index in the array given at construction, gNoPoint when no neighbour was found.
+        PointIndex index;
+        T_number squaredDistance;
+    };
+
+    /// \param aThreadCount The top levels are split by the calling thread,
+    /// then the subtrees below are built concurrently.
+    KdTree(const position_type * aPositions, std::size_t aCount, std::size_t aThreadCount = 1);
+
+    std::size_t size() const
+    { return mPositions.size(); }
+
+    /// \brief Closest position to aPosition, within aMaxDistance.
+    std::optional<Neighbour> findNearest(const position_type & aPosition,
+                                         T_number aMaxDistance = std::numeric_limits<T_number>::infinity()) const;
+
+    /// \brief Writes the (up to) aK closest positions within aMaxDistance to aResults, closest first.
+    /// \return The number of neighbours written.
+    std::size_t findKNearest(const position_type & aPosition,
+                             std::size_t aK,
+                             Neighbour * aResults,
+                             T_number aMaxDistance = std::numeric_limits<T_number>::infinity()) const;
+
+    /// \brief Calls `aVisitor(PointIndex, T_number squaredDistance)` for each position within aRadius
+    /// of aPosition (inclusive), in no particular order.
+    template <class T_visitor>
+    void forEachInRadius(const position_type & aPosition, T_number aRadius, T_visitor && aVisitor) const;
+
+    /// \brief Batch findNearest(), with queries distributed over aThreadCount threads.
+    ///
+    /// aResults receives aCount neighbours, with index gNoPoint for queries without neighbour.
+    void findNearest(const position_type * aPositions,
+                     std::size_t aCount,
+                     Neighbour * aResults,
+                     std::size_t aThreadCount) const;
+
+    /// \brief Batch findKNearest(), with queries distributed over aThreadCount threads.
+    ///
+    /// aResults receives aK neighbours per query, closest first. When the tree holds less than aK positions,
+    /// the missing neighbours have index gNoPoint.
+    void findKNearest(const position_type * aPositions,
+                      std::size_t aCount,
+                      std::size_t aK,
+                      Neighbour * aResults,
+                      std::size_t aThreadCount) const;
+
+private:
+    // Positions and indices are permuted together during the build
+    struct Entry
+    {
+        position_type position;
+        PointIndex index;
+    };
+
+    /// \brief Splits the node of [aBegin, aEnd), recording its axis, without building its subtrees.
+    void splitNode(Entry * aEntries, std::size_t aBegin, std::size_t aEnd);
+    void build(Entry * aEntries, std::size_t aBegin, std::size_t aEnd);
+
+    void searchNearest(std::size_t aBegin, std::size_t aEnd,
+                       const position_type & aPosition, Neighbour & aBest) const;
+
+    /// \brief aHeap is a max-heap on the squared distance, of aCount elements.
+    void searchKNearest(std::size_t aBegin, std::size_t aEnd,
+                        const position_type & aPosition,
+                        std::size_t aK, Neighbour * aHeap, std::size_t & aCount,
+                        T_number & aSquaredRadius) const;
+
+    template <class T_visitor>
+    void searchRadius(std::size_t aBegin, std::size_t aEnd,
+                      const position_type & aPosition, T_number aSquaredRadius,
+                      T_visitor & aVisitor) const;
+
+    std::vector<position_type> mPositions;
+    std::vector<PointIndex> mIndices;
+    // Split axis of the node at each position
+    std::vector<std::uint8_t> mAxes;
+};
+
+
+//
+// Implementation
+//
+template <int N_dimension, class T_number>
+KdTree<N_dimension, T_number>::KdTree(const position_type * aPositions,
+                                      std::size_t aCount,
+                                      std::size_t aThreadCount) :
+    mAxes(aCount)
+{
+    assert(aCount < gNoPoint);
+
+    std::vector<Entry> entries;
+    entries.reserve(aCount);
+    for (std::size_t index = 0; index != aCount; ++index)
+    {
+        entries.push_back(Entry{aPositions[index], static_cast<PointIndex>(index)});
+    }
+
+    // Splits the top levels until there are several subtrees per thread
+    std::vector<std::pair<std::size_t, std::size_t>> subtrees{{0, aCount}};
+    while (aThreadCount > 1 && subtrees.size() < 4 * aThreadCount && subtrees.front().second > subtrees.front().first)
+    {
+        std::vector<std::pair<std::size_t, std::size_t>> children;
+        for (auto [begin, end] : subtrees)
+        {
+            if (begin != end)
+            {
+                splitNode(entries.data(), begin, end);
+                const std::size_t middle = begin + (end - begin) / 2;
+                children.emplace_back(begin, middle);
+                children.emplace_back(middle + 1, end);
+            }
+        }
+        subtrees = std::move(children);
+    }
+
+    // Median splits keep the subtrees balanced, a static distribution is enough.
+    parallelFor(subtrees.size(), aThreadCount, [&](std::size_t aBegin, std::size_t aEnd)
+    {
+        for (std::size_t subtree = aBegin; subtree != aEnd; ++subtree)
+        {
+            build(entries.data(), subtrees[subtree].first, subtrees[subtree].second);
+        }
+    });
+
+    mPositions.reserve(aCount);
+    mIndices.reserve(aCount);
+    for (const Entry & entry : entries)
+    {
+        mPositions.push_back(entry.position);
+        mIndices.push_back(entry.index);
+    }
+}
+
+
+template <int N_dimension, class T_number>
+void KdTree<N_dimension, T_number>::splitNode(Entry * aEntries, std::size_t aBegin, std::size_t aEnd)
+{
+    position_type min = aEntries[aBegin].position;
+    position_type max = aEntries[aBegin].position;
+    for (std::size_t entry = aBegin + 1; entry != aEnd; ++entry)
+    {
+        for (std::size_t axis = 0; axis != N_dimension; ++axis)
+        {
+            min[axis] = std::min(min[axis], aEntries[entry].position[axis]);
+            max[axis] = std::max(max[axis], aEntries[entry].position[axis]);
+        }
+    }
+    std::uint8_t axis = 0;
+    for (std::uint8_t candidate = 1; candidate != N_dimension; ++candidate)
+    {
+        if (max[candidate] - min[candidate] > max[axis] - min[axis])
+        {
+            axis = candidate;
+        }
+    }
+
+    const std::size_t middle = aBegin + (aEnd - aBegin) / 2;
+    std::nth_element(aEntries + aBegin, aEntries + middle, aEntries + aEnd,
+                     [axis](const Entry & aLhs, const Entry & aRhs)
+                     {
+                         return aLhs.position[axis] < aRhs.position[axis];
+                     });
+    mAxes[middle] = axis;
+}
+
+
+template <int N_dimension, class T_number>
+void KdTree<N_dimension, T_number>::build(Entry * aEntries, std::size_t aBegin, std::size_t aEnd)
+{
+    // A single position needs no split, its axis is never read
+    if (aEnd - aBegin <= 1)
+    {
+        return;
+    }
+    splitNode(aEntries, aBegin, aEnd);
+    const std::size_t middle = aBegin + (aEnd - aBegin) / 2;
+    build(aEntries, aBegin, middle);
+    build(aEntries, middle + 1, aEnd);
+}
+
+
+template <int N_dimension, class T_number>
+void KdTree<N_dimension, T_number>::searchNearest(std::size_t aBegin, std::size_t aEnd,
+                                                  const position_type & aPosition,
+                                                  Neighbour & aBest) const
+{
+    if (aBegin == aEnd)
+    {
+        return;
+    }
+
+    const std::size_t middle = aBegin + (aEnd - aBegin) / 2;
+    const T_number squaredDistance = (mPositions[middle] - aPosition).getNormSquared();
+    if (squaredDistance <= aBest.squaredDistance)
+    {
+        aBest = Neighbour{mIndices[middle], squaredDistance};
+    }
+
+    const std::size_t axis = mAxes[middle];
+    const T_number offset = aPosition[axis] - mPositions[middle][axis];
+    // The side containing the query first, it is the most likely to shrink the search radius
+    if (offset < T_number{0})
+    {
+        searchNearest(aBegin, middle, aPosition, aBest);
+        if (offset * offset <= aBest.squaredDistance)
+        {
+            searchNearest(middle + 1, aEnd, aPosition, aBest);
+        }
+    }
+    else
+    {
+        searchNearest(middle + 1, aEnd, aPosition, aBest);
+        if (offset * offset <= aBest.squaredDistance)
+        {
+            searchNearest(aBegin, middle, aPosition, aBest);
+        }
+    }
+}
+
+
+template <int N_dimension, class T_number>
+auto KdTree<N_dimension, T_number>::findNearest(const position_type & aPosition, T_number aMaxDistance) const
+    -> std::optional<Neighbour>
+{
+    Neighbour best{gNoPoint, aMaxDistance * aMaxDistance};
+    searchNearest(0, mPositions.size(), aPosition, best);
+    if (best.index == gNoPoint)
+    {
+        return std::nullopt;
+    }
+    return best;
+}
+
+
+template <int N_dimension, class T_number>
+void KdTree<N_dimension, T_number>::searchKNearest(std::size_t aBegin, std::size_t aEnd,
+                                                   const position_type & aPosition,
+                                                   std::size_t aK, Neighbour * aHeap, std::size_t & aCount,
+                                                   T_number & aSquaredRadius) const
+{
+    if (aBegin == aEnd)
+    {
+        return;
+    }
+
+    auto closer = [](const Neighbour & aLhs, const Neighbour & aRhs)
+    {
+        return aLhs.squaredDistance < aRhs.squaredDistance;
+    };
+
+    const std::size_t middle = aBegin + (aEnd - aBegin) / 2;
+    const T_number squaredDistance = (mPositions[middle] - aPosition).getNormSquared();
+    if (squaredDistance <= aSquaredRadius)
+    {
+        if (aCount == aK)
+        {
+            // Replaces the farthest neighbour
+            std::pop_heap(aHeap, aHeap + aCount, closer);
+            --aCount;
+        }
+        aHeap[aCount++] = Neighbour{mIndices[middle], squaredDistance};
+        std::push_heap(aHeap, aHeap + aCount, closer);
+        if (aCount == aK)
+        {
+            aSquaredRadius = aHeap[0].squaredDistance;
+        }
+    }
+
+    const std::size_t axis = mAxes[middle];
+    const T_number offset = aPosition[axis] - mPositions[middle][axis];
+    if (offset < T_number{0})
+    {
+        searchKNearest(aBegin, middle, aPosition, aK, aHeap, aCount, aSquaredRadius);
+        if (offset * offset <= aSquaredRadius)
+        {
+            searchKNearest(middle + 1, aEnd, aPosition, aK, aHeap, aCount, aSquaredRadius);
+        }
+    }
+    else
+    {
+        searchKNearest(middle + 1, aEnd, aPosition, aK, aHeap, aCount, aSquaredRadius);
+        if (offset * offset <= aSquaredRadius)
+        {
+            searchKNearest(aBegin, middle, aPosition, aK, aHeap, aCount, aSquaredRadius);
+        }
+    }
+}
+
+
+template <int N_dimension, class T_number>
+std::size_t KdTree<N_dimension, T_number>::findKNearest(const position_type & aPosition,
+                                                        std::size_t aK,
+                                                        Neighbour * aResults,
+                                                        T_number aMaxDistance) const
+{
+    if (aK == 0)
+    {
+        return 0;
+    }
+
+    // aResults is used as the heap of the current neighbours, which needs no allocation
+    std::size_t count = 0;
+    T_number squaredRadius = aMaxDistance * aMaxDistance;
+    searchKNearest(0, mPositions.size(), aPosition, aK, aResults, count, squaredRadius);
+    std::sort_heap(aResults, aResults + count, [](const Neighbour & aLhs, const Neighbour & aRhs)
+                   {
+                       return aLhs.squaredDistance < aRhs.squaredDistance;
+                   });
+    return count;
+}
+
+
+template <int N_dimension, class T_number>
+template <class T_visitor>
+void KdTree<N_dimension, T_number>::searchRadius(std::size_t aBegin, std::size_t aEnd,
+                                                 const position_type & aPosition, T_number aSquaredRadius,
+                                                 T_visitor & aVisitor) const
+{
+    if (aBegin == aEnd)
+    {
+        return;
+    }
+
+    const std::size_t middle = aBegin + (aEnd - aBegin) / 2;
+    const T_number squaredDistance = (mPositions[middle] - aPosition).getNormSquared();
+    if (squaredDistance <= aSquaredRadius)
+    {
+        aVisitor(mIndices[middle], squaredDistance);
+    }
+
+    const std::size_t axis = mAxes[middle];
+    const T_number offset = aPosition[axis] - mPositions[middle][axis];
+    if (offset <= T_number{0} || offset * offset <= aSquaredRadius)
+    {
+        searchRadius(aBegin, middle, aPosition, aSquaredRadius, aVisitor);
+    }
+    if (offset >= T_number{0} || offset * offset <= aSquaredRadius)
+    {
+        searchRadius(middle + 1, aEnd, aPosition, aSquaredRadius, aVisitor);
+    }
+}
+
+
+template <int N_dimension, class T_number>
+template <class T_visitor>
+void KdTree<N_dimension, T_number>::forEachInRadius(const position_type & aPosition,
+                                                    T_number aRadius,
+                                                    T_visitor && aVisitor) const
+{
+    searchRadius(0, mPositions.size(), aPosition, aRadius * aRadius, aVisitor);
+}
+
+
+template <int N_dimension, class T_number>
+void KdTree<N_dimension, T_number>::findNearest(const position_type * aPositions,
+                                                std::size_t aCount,
+                                                Neighbour * aResults,
+                                                std::size_t aThreadCount) const
+{
+    parallelFor(aCount, aThreadCount, [&](std::size_t aBegin, std::size_t aEnd)
+    {
+        for (std::size_t query = aBegin; query != aEnd; ++query)
+        {
+            aResults[query] = Neighbour{gNoPoint, std::numeric_limits<T_number>::infinity()};
+            searchNearest(0, mPositions.size(), aPositions[query], aResults[query]);
+        }
+    });
+}
+
+
+template <int N_dimension, class T_number>
+void KdTree<N_dimension, T_number>::findKNearest(const position_type * aPositions,
+                                                 std::size_t aCount,
+                                                 std::size_t aK,
+                                                 Neighbour * aResults,
+                                                 std::size_t aThreadCount) const
+{
+    parallelFor(aCount, aThreadCount, [&](std::size_t aBegin, std::size_t aEnd)
+    {
+        for (std::size_t query = aBegin; query != aEnd; ++query)
+        {
+            Neighbour * results = aResults + query * aK;
+            const std::size_t found = findKNearest(aPositions[query], aK, results);
+            std::fill(results + found, results + aK,
+                      Neighbour{gNoPoint, std::numeric_limits<T_number>::infinity()});
+        }
+    });
+}
+
+
+}} // namespace ad::math
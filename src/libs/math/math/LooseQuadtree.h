@@ -0,0 +1,376 @@
+#pragma once
+
+
+#include "Box.h"
+#include "Rectangle.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace ad {
+namespace math {
+
+
+/// \brief Loose quadtree indexing rectangles, for region and point queries.
+///
+/// The node at depth `d` covers a cell of `world / 2^d`, loosened to twice this size
+/// around the cell center. An object is stored in the deepest node whose cell is at least as large
+/// as the object and contains its center: its placement is computed directly, without descending the tree.
+///
+/// All nodes down to the maximum depth are allocated by the constructor, as a complete tree
+/// addressed implicitly. Objects are stored in a pool reusing the slots of removed objects.
+///
+/// T_number may be an integer type: the cells, whose sizes are generally fractional,
+/// are then computed with real_number, while object bounds keep their exact integer values.
+template <class T_number=real_number>
+class LooseQuadtree
+{
+public:
+    using ObjectId = std::size_t;
+
+    /// \param aWorld The region where objects are expected. Objects outside are still accepted,
+    /// but end up in shallow nodes.
+    /// \param aMaxDepth The tree has (4^(aMaxDepth+1) - 1) / 3 nodes. Must be in [0, 15].
+    explicit LooseQuadtree(const Rectangle<T_number> & aWorld, int aMaxDepth = 6);
+
+    ObjectId insert(const Rectangle<T_number> & aBounds);
+
+    /// \attention aObject must be a currently inserted object.
+    void remove(ObjectId aObject);
+
+    /// \brief Updates the bounds of aObject, only relinking it if it changes of node.
+    void move(ObjectId aObject, const Rectangle<T_number> & aBounds);
+
+    Rectangle<T_number> getBounds(ObjectId aObject) const
+    { return mObjects[aObject].bounds.toRectangle(); }
+
+    std::size_t size() const
+    { return mSize; }
+
+    /// \brief Calls aVisitor(ObjectId) for each object intersecting aRegion (bounds inclusive).
+    template <class T_visitor>
+    void queryRegion(const Rectangle<T_number> & aRegion, T_visitor && aVisitor) const;
+
+    /// \brief Calls aVisitor(ObjectId) for each object containing aPosition (bounds inclusive).
+    template <class T_visitor>
+    void queryPoint(const Position<2, T_number> & aPosition, T_visitor && aVisitor) const;
+
+private:
+    using real_type = std::conditional_t<std::is_floating_point_v<T_number>, T_number, real_number>;
+    using NodeIndex = std::uint32_t;
+    static constexpr std::uint32_t gNone = std::numeric_limits<std::uint32_t>::max();
+
+    struct Node
+    {
+        // Head of the doubly linked list of objects stored in this node
+        std::uint32_t firstObject{gNone};
+        // Number of objects stored in this node and its descendants, to prune empty subtrees
+        std::uint32_t subtreeCount{0};
+    };
+
+    struct Object
+    {
+        Box<2, T_number> bounds;
+        NodeIndex node;
+        std::uint32_t previous;
+        std::uint32_t next;
+    };
+
+    struct Cell
+    {
+        int depth;
+        std::uint32_t x;
+        std::uint32_t y;
+    };
+
+    static constexpr NodeIndex levelOffset(int aDepth)
+    { return static_cast<NodeIndex>(((std::uint64_t{1} << (2 * aDepth)) - 1) / 3); }
+
+    NodeIndex nodeIndex(Cell aCell) const
+    { return levelOffset(aCell.depth) + (aCell.y << aCell.depth) + aCell.x; }
+
+    static Box<2, real_type> toReal(const Box<2, T_number> & aBox);
+
+    Box<2, real_type> looseBounds(Cell aCell) const;
+
+    Cell placeObject(const Box<2, T_number> & aBounds) const;
+
+    void link(ObjectId aObject, Cell aCell);
+    void unlink(ObjectId aObject);
+    void addToSubtreeCounts(Cell aCell, int aDelta);
+
+    static constexpr int gDepthLimit = 16;
+
+    /// \brief Asserts aMaxDepth is below gDepthLimit, and clamps it otherwise,
+    /// before it sizes the node allocation.
+    static int checkMaxDepth(int aMaxDepth)
+    {
+        assert(aMaxDepth >= 0 && aMaxDepth < gDepthLimit);
+        return std::clamp(aMaxDepth, 0, gDepthLimit - 1);
+    }
+
+    Box<2, real_type> mWorld;
+    int mMaxDepth;
+    // Cell width and height per depth, and their inverse, sparing divisions in placeObject()
+    std::array<std::array<real_type, 2>, gDepthLimit> mCellSizes;
+    std::array<std::array<real_type, 2>, gDepthLimit> mInverseCellSizes;
+    std::vector<Node> mNodes;
+    std::vector<Object> mObjects;
+    // Head of the list of free slots in mObjects, chained through Object::next
+    std::uint32_t mFreeObject{gNone};
+    std::size_t mSize{0};
+};
+
+
+//
+// Implementation
+//
+template <class T_number>
+LooseQuadtree<T_number>::LooseQuadtree(const Rectangle<T_number> & aWorld, int aMaxDepth) :
+    mWorld{toReal(Box<2, T_number>{aWorld})},
+    mMaxDepth{checkMaxDepth(aMaxDepth)},
+    mNodes(levelOffset(mMaxDepth + 1))
+{
+    for (int depth = 0; depth != gDepthLimit; ++depth)
+    {
+        for (int axis = 0; axis != 2; ++axis)
+        {
+            const real_type cellCount = static_cast<real_type>(1u << depth);
+            mCellSizes[depth][axis] = (mWorld.max(axis) - mWorld.min(axis)) / cellCount;
+            mInverseCellSizes[depth][axis] = cellCount / (mWorld.max(axis) - mWorld.min(axis));
+        }
+    }
+}
+
+
+template <class T_number>
+auto LooseQuadtree<T_number>::toReal(const Box<2, T_number> & aBox) -> Box<2, real_type>
+{
+    return Box<2, real_type>{
+        {static_cast<real_type>(aBox.min(0)), static_cast<real_type>(aBox.min(1))},
+        {static_cast<real_type>(aBox.max(0)), static_cast<real_type>(aBox.max(1))},
+    };
+}
+
+
+template <class T_number>
+auto LooseQuadtree<T_number>::looseBounds(Cell aCell) const -> Box<2, real_type>
+{
+    const real_type cellWidth = mCellSizes[aCell.depth][0];
+    const real_type cellHeight = mCellSizes[aCell.depth][1];
+    const real_type xMin = mWorld.min(0) + cellWidth * aCell.x;
+    const real_type yMin = mWorld.min(1) + cellHeight * aCell.y;
+    // Loose by half a cell on each side
+    return Box<2, real_type>{
+        {xMin - cellWidth / 2, yMin - cellHeight / 2},
+        {xMin + cellWidth * real_type{1.5}, yMin + cellHeight * real_type{1.5}},
+    };
+}
+
+
+template <class T_number>
+auto LooseQuadtree<T_number>::placeObject(const Box<2, T_number> & aBounds) const -> Cell
+{
+    const Box<2, real_type> bounds = toReal(aBounds);
+    const Size<2, real_type> size = bounds.size();
+
+    // Deepest level whose cells are at least as large as the object on both axes
+    int depth = mMaxDepth;
+    while (depth > 0
+           && (size.width() > mCellSizes[depth][0] || size.height() > mCellSizes[depth][1]))
+    {
+        --depth;
+    }
+
+    const Position<2, real_type> center = bounds.center();
+    auto cellCoordinate = [&](int aAxis)
+    {
+        const real_type cell = std::floor((center[aAxis] - mWorld.min(aAxis)) * mInverseCellSizes[depth][aAxis]);
+        // Clamping, for objects centered outside of the world
+        return static_cast<std::uint32_t>(
+            std::clamp(cell, real_type{0}, static_cast<real_type>((1u << depth) - 1)));
+    };
+
+    Cell cell{depth, cellCoordinate(0), cellCoordinate(1)};
+
+    // Objects outside the world may not fit the loose bounds of the clamped cell:
+    // move them up, the root being the only node never pruned by queries.
+    while (cell.depth > 0 && !looseBounds(cell).contains(bounds))
+    {
+        cell = Cell{cell.depth - 1, cell.x / 2, cell.y / 2};
+    }
+    return cell;
+}
+
+
+template <class T_number>
+void LooseQuadtree<T_number>::addToSubtreeCounts(Cell aCell, int aDelta)
+{
+    for (;;)
+    {
+        mNodes[nodeIndex(aCell)].subtreeCount += aDelta;
+        if (aCell.depth == 0)
+        {
+            return;
+        }
+        aCell = Cell{aCell.depth - 1, aCell.x / 2, aCell.y / 2};
+    }
+}
+
+
+template <class T_number>
+void LooseQuadtree<T_number>::link(ObjectId aObject, Cell aCell)
+{
+    const NodeIndex node = nodeIndex(aCell);
+    Object & object = mObjects[aObject];
+    object.node = node;
+    object.previous = gNone;
+    object.next = mNodes[node].firstObject;
+    if (object.next != gNone)
+    {
+        mObjects[object.next].previous = static_cast<std::uint32_t>(aObject);
+    }
+    mNodes[node].firstObject = static_cast<std::uint32_t>(aObject);
+    addToSubtreeCounts(aCell, +1);
+}
+
+
+template <class T_number>
+void LooseQuadtree<T_number>::unlink(ObjectId aObject)
+{
+    Object & object = mObjects[aObject];
+    if (object.previous != gNone)
+    {
+        mObjects[object.previous].next = object.next;
+    }
+    else
+    {
+        mNodes[object.node].firstObject = object.next;
+    }
+    if (object.next != gNone)
+    {
+        mObjects[object.next].previous = object.previous;
+    }
+
+    // Recovers the cell from the node index
+    Cell cell{0, 0, 0};
+    while (levelOffset(cell.depth + 1) <= object.node)
+    {
+        ++cell.depth;
+    }
+    const NodeIndex inLevel = object.node - levelOffset(cell.depth);
+    cell.x = inLevel & ((1u << cell.depth) - 1);
+    cell.y = inLevel >> cell.depth;
+    addToSubtreeCounts(cell, -1);
+}
+
+
+template <class T_number>
+auto LooseQuadtree<T_number>::insert(const Rectangle<T_number> & aBounds) -> ObjectId
+{
+    const Box<2, T_number> bounds{aBounds};
+
+    ObjectId id;
+    if (mFreeObject != gNone)
+    {
+        id = mFreeObject;
+        mFreeObject = mObjects[id].next;
+        mObjects[id].bounds = bounds;
+    }
+    else
+    {
+        id = mObjects.size();
+        mObjects.push_back(Object{bounds, gNone, gNone, gNone});
+    }
+
+    link(id, placeObject(bounds));
+    ++mSize;
+    return id;
+}
+
+
+template <class T_number>
+void LooseQuadtree<T_number>::remove(ObjectId aObject)
+{
+    unlink(aObject);
+    mObjects[aObject].node = gNone;
+    mObjects[aObject].next = mFreeObject;
+    mFreeObject = static_cast<std::uint32_t>(aObject);
+    --mSize;
+}
+
+
+template <class T_number>
+void LooseQuadtree<T_number>::move(ObjectId aObject, const Rectangle<T_number> & aBounds)
+{
+    const Box<2, T_number> bounds{aBounds};
+    const Cell cell = placeObject(bounds);
+
+    mObjects[aObject].bounds = bounds;
+    if (nodeIndex(cell) != mObjects[aObject].node)
+    {
+        unlink(aObject);
+        link(aObject, cell);
+    }
+}
+
+
+template <class T_number>
+template <class T_visitor>
+void LooseQuadtree<T_number>::queryRegion(const Rectangle<T_number> & aRegion, T_visitor && aVisitor) const
+{
+    const Box<2, T_number> region{aRegion};
+    const Box<2, real_type> realRegion = toReal(region);
+
+    // Depth first, the explicit stack never holding more than 3 siblings per level plus the current node
+    Cell stack[3 * gDepthLimit + 1];
+    std::size_t stackSize = 0;
+    stack[stackSize++] = Cell{0, 0, 0};
+
+    while (stackSize != 0)
+    {
+        const Cell cell = stack[--stackSize];
+        const Node & node = mNodes[nodeIndex(cell)];
+        if (node.subtreeCount == 0
+            || (cell.depth != 0 && !looseBounds(cell).intersects(realRegion)))
+        {
+            continue;
+        }
+
+        for (std::uint32_t objectId = node.firstObject; objectId != gNone; objectId = mObjects[objectId].next)
+        {
+            if (mObjects[objectId].bounds.intersects(region))
+            {
+                aVisitor(static_cast<ObjectId>(objectId));
+            }
+        }
+
+        if (cell.depth != mMaxDepth)
+        {
+            for (std::uint32_t child = 0; child != 4; ++child)
+            {
+                stack[stackSize++] = Cell{cell.depth + 1, 2 * cell.x + (child & 1), 2 * cell.y + (child >> 1)};
+            }
+        }
+    }
+}
+
+
+template <class T_number>
+template <class T_visitor>
+void LooseQuadtree<T_number>::queryPoint(const Position<2, T_number> & aPosition, T_visitor && aVisitor) const
+{
+    queryRegion(Rectangle<T_number>{aPosition, {T_number{0}, T_number{0}}}, std::forward<T_visitor>(aVisitor));
+}
+
+
+}} // namespace ad::math
@@ -0,0 +1,389 @@
+#pragma once
+
+
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <cerrno>
+#include <cstddef>
+
+#if defined(_WIN32)
+#   ifndef WIN32_LEAN_AND_MEAN
+#       define WIN32_LEAN_AND_MEAN
+#   endif
+#   ifndef NOMINMAX
+#       define NOMINMAX
+#   endif
+#   include <windows.h>
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+
+namespace ad {
+namespace math {
+
+
+/// \brief File mapped in memory for its whole lifetime.
+///
+/// Failures to open, create or map the file are reported by throwing std::system_error.
+class MappedFile
+{
+public:
+    /// \brief Expected access to the mapped memory, a hint for the system paging.
+    enum class Access
+    {
+        Sequential,
+        Random,
+    };
+
+    /// \brief Maps an existing file, read-only.
+    static MappedFile OpenRead(const std::string & aPath, Access aAccess = Access::Sequential);
+
+    /// \brief Maps an existing file for reading and writing, keeping its content.
+    static MappedFile OpenReadWrite(const std::string & aPath);
+
+    /// \brief Creates (or truncates) a file of aSize bytes, mapped for reading and writing.
+    static MappedFile Create(const std::string & aPath, std::size_t aSize);
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile & operator=(const MappedFile &) = delete;
+
+    MappedFile(MappedFile && aOther) noexcept;
+    MappedFile & operator=(MappedFile && aOther) noexcept;
+
+    ~MappedFile();
+
+    /// \brief Null for an empty file.
+    const std::byte * data() const
+    { return mData; }
+
+    /// \attention Must only be written to if the file was mapped by Create() or OpenReadWrite().
+    std::byte * data()
+    { return mData; }
+
+    std::size_t size() const
+    { return mSize; }
+
+private:
+    MappedFile() = default;
+
+    void release() noexcept;
+
+    std::byte * mData{nullptr};
+    std::size_t mSize{0};
+#if defined(_WIN32)
+    HANDLE mFile{INVALID_HANDLE_VALUE};
+    HANDLE mMapping{nullptr};
+#else
+    int mFile{-1};
+#endif
+};
+
+
+/// \brief Whether both paths name the same existing file, e.g. through links or different spellings.
+///
+/// \return false if either file does not exist.
+bool isSameFile(const std::string & aLeftPath, const std::string & aRightPath);
+
+
+//
+// Implementation
+//
+#if defined(_WIN32)
+
+namespace detail {
+
+    [[noreturn]] inline void throwLastError(const std::string & aWhat)
+    {
+        throw std::system_error{static_cast<int>(::GetLastError()), std::system_category(), aWhat};
+    }
+
+    inline std::byte * mapView(HANDLE aFile, HANDLE & aMapping, std::size_t aSize, bool aWritable)
+    {
+        if (aSize == 0)
+        {
+            return nullptr;
+        }
+
+        const DWORD protection = aWritable ? PAGE_READWRITE : PAGE_READONLY;
+        const unsigned long long size = aSize;
+        aMapping = ::CreateFileMappingA(aFile, nullptr, protection,
+                                        static_cast<DWORD>(size >> 32), static_cast<DWORD>(size),
+                                        nullptr);
+        if (aMapping == nullptr)
+        {
+            throwLastError("Cannot create file mapping");
+        }
+
+        void * view = ::MapViewOfFile(aMapping, aWritable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, aSize);
+        if (view == nullptr)
+        {
+            throwLastError("Cannot map view of file");
+        }
+        return static_cast<std::byte *>(view);
+    }
+
+} // namespace detail
+
+
+inline MappedFile MappedFile::OpenRead(const std::string & aPath, Access aAccess)
+{
+    MappedFile result;
+    result.mFile = ::CreateFileA(aPath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                 OPEN_EXISTING,
+                                 aAccess == Access::Random ? FILE_FLAG_RANDOM_ACCESS : FILE_FLAG_SEQUENTIAL_SCAN,
+                                 nullptr);
+    if (result.mFile == INVALID_HANDLE_VALUE)
+    {
+        detail::throwLastError("Cannot open '" + aPath + "'");
+    }
+
+    LARGE_INTEGER size;
+    if (!::GetFileSizeEx(result.mFile, &size))
+    {
+        detail::throwLastError("Cannot get size of '" + aPath + "'");
+    }
+    result.mSize = static_cast<std::size_t>(size.QuadPart);
+    result.mData = detail::mapView(result.mFile, result.mMapping, result.mSize, false);
+    return result;
+}
+
+
+inline MappedFile MappedFile::OpenReadWrite(const std::string & aPath)
+{
+    MappedFile result;
+    result.mFile = ::CreateFileA(aPath.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr,
+                                 OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (result.mFile == INVALID_HANDLE_VALUE)
+    {
+        detail::throwLastError("Cannot open '" + aPath + "'");
+    }
+
+    LARGE_INTEGER size;
+    if (!::GetFileSizeEx(result.mFile, &size))
+    {
+        detail::throwLastError("Cannot get size of '" + aPath + "'");
+    }
+    result.mSize = static_cast<std::size_t>(size.QuadPart);
+    result.mData = detail::mapView(result.mFile, result.mMapping, result.mSize, true);
+    return result;
+}
+
+
+inline MappedFile MappedFile::Create(const std::string & aPath, std::size_t aSize)
+{
+    MappedFile result;
+    result.mFile = ::CreateFileA(aPath.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr,
+                                 CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (result.mFile == INVALID_HANDLE_VALUE)
+    {
+        detail::throwLastError("Cannot create '" + aPath + "'");
+    }
+
+    // The mapping extends the file to its size
+    result.mSize = aSize;
+    result.mData = detail::mapView(result.mFile, result.mMapping, result.mSize, true);
+    return result;
+}
+
+
+inline bool isSameFile(const std::string & aLeftPath, const std::string & aRightPath)
+{
+    // The volume and the file index identify a file
+    auto identify = [](const std::string & aPath, BY_HANDLE_FILE_INFORMATION & aInformation)
+    {
+        // No access is required to query the information, and directories need the backup semantics
+        const HANDLE file = ::CreateFileA(aPath.c_str(), 0,
+                                          FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                                          OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+        const bool identified = ::GetFileInformationByHandle(file, &aInformation);
+        ::CloseHandle(file);
+        return identified;
+    };
+
+    BY_HANDLE_FILE_INFORMATION left, right;
+    return identify(aLeftPath, left) && identify(aRightPath, right)
+           && left.dwVolumeSerialNumber == right.dwVolumeSerialNumber
+           && left.nFileIndexHigh == right.nFileIndexHigh
+           && left.nFileIndexLow == right.nFileIndexLow;
+}
+
+
+inline void MappedFile::release() noexcept
+{
+    if (mData != nullptr)
+    {
+        ::UnmapViewOfFile(mData);
+    }
+    if (mMapping != nullptr)
+    {
+        ::CloseHandle(mMapping);
+    }
+    if (mFile != INVALID_HANDLE_VALUE)
+    {
+        ::CloseHandle(mFile);
+    }
+}
+
+#else
+
+namespace detail {
+
+    [[noreturn]] inline void throwErrno(const std::string & aWhat)
+    {
+        throw std::system_error{errno, std::generic_category(), aWhat};
+    }
+
+    inline std::byte * mapFile(int aFile, std::size_t aSize, bool aWritable, int aAdvice = MADV_SEQUENTIAL)
+    {
+        if (aSize == 0)
+        {
+            return nullptr;
+        }
+
+        void * data = ::mmap(nullptr, aSize,
+                             aWritable ? (PROT_READ | PROT_WRITE) : PROT_READ,
+                             MAP_SHARED, aFile, 0);
+        if (data == MAP_FAILED)
+        {
+            throwErrno("Cannot map file");
+        }
+        // Only a hint, failure is not an error
+        ::madvise(data, aSize, aAdvice);
+        return static_cast<std::byte *>(data);
+    }
+
+} // namespace detail
+
+
+inline MappedFile MappedFile::OpenRead(const std::string & aPath, Access aAccess)
+{
+    MappedFile result;
+    result.mFile = ::open(aPath.c_str(), O_RDONLY);
+    if (result.mFile == -1)
+    {
+        detail::throwErrno("Cannot open '" + aPath + "'");
+    }
+
+    struct stat status;
+    if (::fstat(result.mFile, &status) == -1)
+    {
+        detail::throwErrno("Cannot get size of '" + aPath + "'");
+    }
+    result.mSize = static_cast<std::size_t>(status.st_size);
+    result.mData = detail::mapFile(result.mFile, result.mSize, false,
+                                   aAccess == Access::Random ? MADV_RANDOM : MADV_SEQUENTIAL);
+    return result;
+}
+
+
+inline MappedFile MappedFile::OpenReadWrite(const std::string & aPath)
+{
+    MappedFile result;
+    result.mFile = ::open(aPath.c_str(), O_RDWR);
+    if (result.mFile == -1)
+    {
+        detail::throwErrno("Cannot open '" + aPath + "'");
+    }
+
+    struct stat status;
+    if (::fstat(result.mFile, &status) == -1)
+    {
+        detail::throwErrno("Cannot get size of '" + aPath + "'");
+    }
+    result.mSize = static_cast<std::size_t>(status.st_size);
+    result.mData = detail::mapFile(result.mFile, result.mSize, true);
+    return result;
+}
+
+
+inline MappedFile MappedFile::Create(const std::string & aPath, std::size_t aSize)
+{
+    MappedFile result;
+    result.mFile = ::open(aPath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (result.mFile == -1)
+    {
+        detail::throwErrno("Cannot create '" + aPath + "'");
+    }
+
+    if (::ftruncate(result.mFile, static_cast<off_t>(aSize)) == -1)
+    {
+        detail::throwErrno("Cannot resize '" + aPath + "'");
+    }
+    result.mSize = aSize;
+    result.mData = detail::mapFile(result.mFile, result.mSize, true);
+    return result;
+}
+
+
+inline bool isSameFile(const std::string & aLeftPath, const std::string & aRightPath)
+{
+    // The device and the inode identify a file
+    struct stat left, right;
+    return ::stat(aLeftPath.c_str(), &left) == 0 && ::stat(aRightPath.c_str(), &right) == 0
+           && left.st_dev == right.st_dev
+           && left.st_ino == right.st_ino;
+}
+
+
+inline void MappedFile::release() noexcept
+{
+    if (mData != nullptr)
+    {
+        ::munmap(mData, mSize);
+    }
+    if (mFile != -1)
+    {
+        ::close(mFile);
+    }
+}
+
+#endif
+
+
+inline MappedFile::MappedFile(MappedFile && aOther) noexcept :
+    mData{std::exchange(aOther.mData, nullptr)},
+    mSize{std::exchange(aOther.mSize, 0)},
+#if defined(_WIN32)
+    mFile{std::exchange(aOther.mFile, INVALID_HANDLE_VALUE)},
+    mMapping{std::exchange(aOther.mMapping, nullptr)}
+#else
+    mFile{std::exchange(aOther.mFile, -1)}
+#endif
+{}
+
+
+inline MappedFile & MappedFile::operator=(MappedFile && aOther) noexcept
+{
+    if (this != &aOther)
+    {
+        release();
+        mData = std::exchange(aOther.mData, nullptr);
+        mSize = std::exchange(aOther.mSize, 0);
+#if defined(_WIN32)
+        mFile = std::exchange(aOther.mFile, INVALID_HANDLE_VALUE);
+        mMapping = std::exchange(aOther.mMapping, nullptr);
+#else
+        mFile = std::exchange(aOther.mFile, -1);
+#endif
+    }
+    return *this;
+}
+
+
+inline MappedFile::~MappedFile()
+{
+    release();
+}
+
+
+}} // namespace ad::math
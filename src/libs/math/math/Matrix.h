@@ -4,6 +4,8 @@
 #include "commons.h"
 #include "MatrixBase.h"
 
+#include <type_traits>
+
 
 namespace ad {
 namespace math {
@@ -26,6 +28,10 @@ public:
 
     constexpr Matrix<N_cols, N_rows, T_number> transpose() const noexcept(should_noexcept);
 
+    /// \brief Inverse by Gauss-Jordan elimination, with partial pivoting.
+    /// \attention Undefined behaviour if the matrix is singular.
+    constexpr Matrix inverse() const noexcept(should_noexcept);
+
     using base_type::operator*=;
     constexpr Matrix & operator*=(const Matrix & aRhs) noexcept(should_noexcept);
 };
@@ -106,4 +112,64 @@ Matrix<N_rows, N_cols, T_number>::transpose() const noexcept(should_noexcept)
 }
 
 
+template <int N_rows, int N_cols, class T_number>
+constexpr Matrix<N_rows, N_cols, T_number>
+Matrix<N_rows, N_cols, T_number>::inverse() const noexcept(should_noexcept)
+{
+    static_assert(is_square_value, "Only square matrices can be inverted.");
+    static_assert(std::is_floating_point<T_number>::value,
+                  "Inversion requires floating point numbers.");
+
+    // std::abs is not constexpr
+    auto absolute = [](T_number aValue){ return aValue < 0 ? -aValue : aValue; };
+
+    // The elementary operations reducing the source to identity turn the result into the inverse
+    Matrix source = *this;
+    Matrix result = Identity();
+    for (std::size_t col = 0; col != N_cols; ++col)
+    {
+        std::size_t pivot = col;
+        for (std::size_t row = col + 1; row != N_rows; ++row)
+        {
+            if (absolute(source.at(row, col)) > absolute(source.at(pivot, col)))
+            {
+                pivot = row;
+            }
+        }
+
+        for (std::size_t swapCol = 0; swapCol != N_cols; ++swapCol)
+        {
+            T_number sourceValue = source.at(col, swapCol);
+            source.at(col, swapCol) = source.at(pivot, swapCol);
+            source.at(pivot, swapCol) = sourceValue;
+
+            T_number resultValue = result.at(col, swapCol);
+            result.at(col, swapCol) = result.at(pivot, swapCol);
+            result.at(pivot, swapCol) = resultValue;
+        }
+
+        const T_number pivotValue = source.at(col, col);
+        for (std::size_t scaleCol = 0; scaleCol != N_cols; ++scaleCol)
+        {
+            source.at(col, scaleCol) /= pivotValue;
+            result.at(col, scaleCol) /= pivotValue;
+        }
+
+        for (std::size_t row = 0; row != N_rows; ++row)
+        {
+            const T_number factor = source.at(row, col);
+            if (row != col && factor != 0)
+            {
+                for (std::size_t eliminateCol = 0; eliminateCol != N_cols; ++eliminateCol)
+                {
+                    source.at(row, eliminateCol) -= factor * source.at(col, eliminateCol);
+                    result.at(row, eliminateCol) -= factor * result.at(col, eliminateCol);
+                }
+            }
+        }
+    }
+    return result;
+}
+
+
 }} // namespace ad::math
@@ -0,0 +1,425 @@
+#pragma once
+
+
+#include "MappedFile.h"
+#include "Rectangle.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+
+namespace ad {
+namespace math {
+
+
+/// \brief Static R-tree over rectangles, bulk loaded with Sort-Tile-Recursive (STR),
+/// and stored as a single flat buffer which can be saved to a file then memory mapped.
+///
+/// Every node is full except the last of each level: the children of node i are the nodes
+/// [i * nodeSize, (i + 1) * nodeSize) of the level below, so the layout needs no child pointers.
+/// The buffer holds:
+/// * a header,
+/// * the bounds of all levels as (xMin, yMin, xMax, yMax) quadruples, from the rectangles up to the root,
+/// * the index, in the array given to Build(), of each rectangle in the stored order.
+///
+/// \note The file format stores numbers in native byte order, it is not portable across endianness.
+template <class T_number=real_number>
+class PackedRTree
+{
+public:
+    using ItemIndex = std::uint32_t;
+
+    /// \brief Bulk loads an in-memory tree.
+    /// \param aNodeSize The number of children of each node, at least 2.
+    static PackedRTree Build(const Rectangle<T_number> * aRectangles,
+                             std::size_t aCount,
+                             std::size_t aNodeSize = 16);
+
+    /// \brief Maps a file written by save(), which is queried in place.
+    ///
+    /// Pages of the file are only read as queries reach them.
+    /// \throw std::system_error if the file cannot be opened or mapped.
+    /// \throw std::runtime_error if the file is not a tree of T_number.
+    static PackedRTree Open(const std::string & aPath);
+
+    /// \throw std::system_error if the file cannot be created or mapped.
+    void save(const std::string & aPath) const;
+
+    std::size_t size() const
+    { return header().itemCount; }
+
+    std::size_t getNodeSize() const
+    { return header().nodeSize; }
+
+    /// \brief Calls aVisitor(ItemIndex) for each rectangle intersecting aRegion (bounds inclusive).
+    template <class T_visitor>
+    void query(const Rectangle<T_number> & aRegion, T_visitor && aVisitor) const;
+
+    /// \brief Calls aVisitor(ItemIndex) for each rectangle containing aPosition (bounds inclusive).
+    template <class T_visitor>
+    void query(const Position<2, T_number> & aPosition, T_visitor && aVisitor) const;
+
+private:
+    struct Header
+    {
+        char magic[8];
+        std::uint32_t version;
+        // Guards against opening a tree of another number type
+        std::uint32_t numberSize;
+        std::uint64_t itemCount;
+        std::uint32_t nodeSize;
+        std::uint32_t levelCount;
+    };
+
+    static constexpr char gMagic[8] = {'A', 'D', 'R', 'T', 'R', 'E', 'E', '\0'};
+    static constexpr std::uint32_t gVersion = 1;
+
+    using Bounds = std::array<T_number, 4>;
+
+    PackedRTree() = default;
+
+    /// \brief Number of nodes of each level, from the rectangles up to the root.
+    static std::vector<std::size_t> levelSizes(std::size_t aCount, std::size_t aNodeSize);
+    static std::size_t bufferSize(std::size_t aBoundsCount, std::size_t aItemCount);
+
+    /// \brief Points the accessors into aData, which must hold a complete tree.
+    void attach(const std::byte * aData);
+
+    const Header & header() const
+    { return *reinterpret_cast<const Header *>(mData); }
+
+    template <class T_visitor>
+    void queryNode(const Bounds & aRegion, std::size_t aLevel, std::size_t aNode, T_visitor & aVisitor) const;
+
+    // Either the in-memory buffer of a built tree, or the mapping of an opened file
+    std::vector<std::byte> mBuffer;
+    std::optional<MappedFile> mMapping;
+
+    const std::byte * mData{nullptr};
+    const Bounds * mBounds{nullptr};
+    const ItemIndex * mItems{nullptr};
+    // Offset in mBounds of the first node of each level
+    std::vector<std::size_t> mLevelOffsets;
+    std::size_t mBufferSize{0};
+};
+
+
+//
+// Implementation
+//
+namespace detail {
+
+    /// \brief Reorders [aBegin, aEnd) into consecutive chunks of aChunkSize elements,
+    /// each element of a chunk comparing lower or equal to the elements of the next chunks.
+    ///
+    /// Selects the chunk boundaries by bisection, which is cheaper than a complete sort.
+    template <class T_iterator, class T_compare>
+    void selectChunks(T_iterator aBegin, T_iterator aEnd, std::size_t aChunkSize, T_compare aCompare)
+    {
+        const std::size_t chunkCount = (static_cast<std::size_t>(aEnd - aBegin) + aChunkSize - 1) / aChunkSize;
+        if (chunkCount <= 1)
+        {
+            return;
+        }
+        const T_iterator middle = aBegin + (chunkCount / 2) * aChunkSize;
+        std::nth_element(aBegin, middle, aEnd, aCompare);
+        selectChunks(aBegin, middle, aChunkSize, aCompare);
+        selectChunks(middle, aEnd, aChunkSize, aCompare);
+    }
+
+} // namespace detail
+
+
+template <class T_number>
+std::vector<std::size_t> PackedRTree<T_number>::levelSizes(std::size_t aCount, std::size_t aNodeSize)
+{
+    std::vector<std::size_t> result{aCount};
+    while (result.back() > 1)
+    {
+        result.push_back((result.back() + aNodeSize - 1) / aNodeSize);
+    }
+    return result;
+}
+
+
+template <class T_number>
+std::size_t PackedRTree<T_number>::bufferSize(std::size_t aBoundsCount, std::size_t aItemCount)
+{
+    return sizeof(Header) + aBoundsCount * sizeof(Bounds) + aItemCount * sizeof(ItemIndex);
+}
+
+
+template <class T_number>
+void PackedRTree<T_number>::attach(const std::byte * aData)
+{
+    mData = aData;
+    const std::vector<std::size_t> sizes = levelSizes(header().itemCount, header().nodeSize);
+
+    mLevelOffsets.clear();
+    std::size_t offset = 0;
+    for (std::size_t size : sizes)
+    {
+        mLevelOffsets.push_back(offset);
+        offset += size;
+    }
+
+    mBounds = reinterpret_cast<const Bounds *>(mData + sizeof(Header));
+    mItems = reinterpret_cast<const ItemIndex *>(mData + sizeof(Header) + offset * sizeof(Bounds));
+    mBufferSize = bufferSize(offset, header().itemCount);
+}
+
+
+template <class T_number>
+PackedRTree<T_number> PackedRTree<T_number>::Build(const Rectangle<T_number> * aRectangles,
+                                                   std::size_t aCount,
+                                                   std::size_t aNodeSize)
+{
+    assert(aNodeSize >= 2);
+    assert(aCount < std::numeric_limits<ItemIndex>::max());
+
+    struct Item
+    {
+        Bounds bounds;
+        ItemIndex index;
+    };
+
+    std::vector<Item> items;
+    items.reserve(aCount);
+    for (std::size_t index = 0; index != aCount; ++index)
+    {
+        const Rectangle<T_number> & rectangle = aRectangles[index];
+        items.push_back(Item{
+            {rectangle.xMin(), rectangle.yMin(), rectangle.xMax(), rectangle.yMax()},
+            static_cast<ItemIndex>(index)
+        });
+    }
+
+    const std::vector<std::size_t> sizes = levelSizes(aCount, aNodeSize);
+
+    // Sort-Tile-Recursive, applied top-down so that each level is tiled:
+    // a subtree range is sliced along X, each slice being cut along Y into its child subtrees.
+    // Keys are twice the centers, which orders the same.
+    auto centerX = [](const Item & aLhs, const Item & aRhs)
+    { return aLhs.bounds[0] + aLhs.bounds[2] < aRhs.bounds[0] + aRhs.bounds[2]; };
+    auto centerY = [](const Item & aLhs, const Item & aRhs)
+    { return aLhs.bounds[1] + aLhs.bounds[3] < aRhs.bounds[1] + aRhs.bounds[3]; };
+
+    auto tile = [&](auto & aTile, std::size_t aBegin, std::size_t aEnd, std::size_t aSubtreeCapacity) -> void
+    {
+        const std::size_t count = aEnd - aBegin;
+        if (aSubtreeCapacity == 1 || count <= 1)
+        {
+            return;
+        }
+
+        // Number of items in each child subtree, all full but the last
+        const std::size_t childCapacity = aSubtreeCapacity / aNodeSize;
+        const std::size_t childCount = (count + childCapacity - 1) / childCapacity;
+        std::size_t sliceCount = 1;
+        while (sliceCount * sliceCount < childCount)
+        {
+            ++sliceCount;
+        }
+        const std::size_t sliceSize = ((childCount + sliceCount - 1) / sliceCount) * childCapacity;
+
+        detail::selectChunks(items.begin() + aBegin, items.begin() + aEnd, sliceSize, centerX);
+        for (std::size_t slice = aBegin; slice < aEnd; slice += sliceSize)
+        {
+            const std::size_t sliceEnd = std::min(slice + sliceSize, aEnd);
+            detail::selectChunks(items.begin() + slice, items.begin() + sliceEnd, childCapacity, centerY);
+            for (std::size_t child = slice; child < sliceEnd; child += childCapacity)
+            {
+                aTile(aTile, child, std::min(child + childCapacity, sliceEnd), childCapacity);
+            }
+        }
+    };
+    std::size_t rootCapacity = 1;
+    for (std::size_t level = 1; level != sizes.size(); ++level)
+    {
+        rootCapacity *= aNodeSize;
+    }
+    tile(tile, 0, aCount, rootCapacity);
+
+    std::size_t boundsCount = 0;
+    for (std::size_t size : sizes)
+    {
+        boundsCount += size;
+    }
+
+    PackedRTree result;
+    result.mBuffer.resize(bufferSize(boundsCount, aCount));
+
+    Header header{};
+    std::memcpy(header.magic, gMagic, sizeof(gMagic));
+    header.version = gVersion;
+    header.numberSize = sizeof(T_number);
+    header.itemCount = aCount;
+    header.nodeSize = static_cast<std::uint32_t>(aNodeSize);
+    header.levelCount = static_cast<std::uint32_t>(sizes.size());
+    std::memcpy(result.mBuffer.data(), &header, sizeof(Header));
+
+    Bounds * bounds = reinterpret_cast<Bounds *>(result.mBuffer.data() + sizeof(Header));
+    ItemIndex * indices = reinterpret_cast<ItemIndex *>(result.mBuffer.data() + sizeof(Header)
+                                                        + boundsCount * sizeof(Bounds));
+    for (std::size_t position = 0; position != aCount; ++position)
+    {
+        bounds[position] = items[position].bounds;
+        indices[position] = items[position].index;
+    }
+
+    // Each level bounds consecutive groups of the level below
+    const Bounds * children = bounds;
+    Bounds * nodes = bounds + aCount;
+    for (std::size_t level = 1; level != sizes.size(); ++level)
+    {
+        for (std::size_t node = 0; node != sizes[level]; ++node)
+        {
+            Bounds & nodeBounds = nodes[node];
+            nodeBounds = {
+                std::numeric_limits<T_number>::max(), std::numeric_limits<T_number>::max(),
+                std::numeric_limits<T_number>::lowest(), std::numeric_limits<T_number>::lowest(),
+            };
+            const std::size_t childEnd = std::min((node + 1) * aNodeSize, sizes[level - 1]);
+            for (std::size_t child = node * aNodeSize; child != childEnd; ++child)
+            {
+                nodeBounds[0] = std::min(nodeBounds[0], children[child][0]);
+                nodeBounds[1] = std::min(nodeBounds[1], children[child][1]);
+                nodeBounds[2] = std::max(nodeBounds[2], children[child][2]);
+                nodeBounds[3] = std::max(nodeBounds[3], children[child][3]);
+            }
+        }
+        children = nodes;
+        nodes += sizes[level];
+    }
+
+    result.attach(result.mBuffer.data());
+    return result;
+}
+
+
+template <class T_number>
+PackedRTree<T_number> PackedRTree<T_number>::Open(const std::string & aPath)
+{
+    PackedRTree result;
+    result.mMapping = MappedFile::OpenRead(aPath, MappedFile::Access::Random);
+    const MappedFile & mapping = *result.mMapping;
+
+    Header header;
+    if (mapping.size() < sizeof(Header))
+    {
+        throw std::runtime_error{"'" + aPath + "' is too small to be an R-tree."};
+    }
+    std::memcpy(&header, mapping.data(), sizeof(Header));
+    if (std::memcmp(header.magic, gMagic, sizeof(gMagic)) != 0 || header.version != gVersion)
+    {
+        throw std::runtime_error{"'" + aPath + "' is not an R-tree file of a supported version."};
+    }
+    if (header.numberSize != sizeof(T_number))
+    {
+        throw std::runtime_error{"'" + aPath + "' stores numbers of another size."};
+    }
+    if (header.nodeSize < 2)
+    {
+        throw std::runtime_error{"'" + aPath + "' has an invalid node size."};
+    }
+
+    const std::vector<std::size_t> sizes = levelSizes(header.itemCount, header.nodeSize);
+    std::size_t boundsCount = 0;
+    for (std::size_t size : sizes)
+    {
+        boundsCount += size;
+    }
+    if (header.levelCount != sizes.size() || mapping.size() != bufferSize(boundsCount, header.itemCount))
+    {
+        throw std::runtime_error{"'" + aPath + "' is truncated or corrupted."};
+    }
+
+    result.attach(mapping.data());
+    return result;
+}
+
+
+template <class T_number>
+void PackedRTree<T_number>::save(const std::string & aPath) const
+{
+    MappedFile file = MappedFile::Create(aPath, mBufferSize);
+    std::memcpy(file.data(), mData, mBufferSize);
+}
+
+
+template <class T_number>
+template <class T_visitor>
+void PackedRTree<T_number>::queryNode(const Bounds & aRegion,
+                                      std::size_t aLevel,
+                                      std::size_t aNode,
+                                      T_visitor & aVisitor) const
+{
+    const std::size_t nodeSize = header().nodeSize;
+    const std::size_t childLevel = aLevel - 1;
+    const std::size_t childLevelSize = mLevelOffsets[aLevel] - mLevelOffsets[childLevel];
+    const std::size_t childEnd = std::min((aNode + 1) * nodeSize, childLevelSize);
+
+    const Bounds * children = mBounds + mLevelOffsets[childLevel];
+    for (std::size_t child = aNode * nodeSize; child != childEnd; ++child)
+    {
+        const Bounds & bounds = children[child];
+        if (bounds[0] <= aRegion[2] && bounds[2] >= aRegion[0]
+            && bounds[1] <= aRegion[3] && bounds[3] >= aRegion[1])
+        {
+            if (childLevel == 0)
+            {
+                aVisitor(mItems[child]);
+            }
+            else
+            {
+                queryNode(aRegion, childLevel, child, aVisitor);
+            }
+        }
+    }
+}
+
+
+template <class T_number>
+template <class T_visitor>
+void PackedRTree<T_number>::query(const Rectangle<T_number> & aRegion, T_visitor && aVisitor) const
+{
+    const std::size_t rootLevel = mLevelOffsets.size() - 1;
+    const Bounds region{aRegion.xMin(), aRegion.yMin(), aRegion.xMax(), aRegion.yMax()};
+    if (rootLevel == 0)
+    {
+        // A single item (or none) has no node above it
+        if (size() == 1)
+        {
+            const Bounds & bounds = mBounds[0];
+            if (bounds[0] <= region[2] && bounds[2] >= region[0]
+                && bounds[1] <= region[3] && bounds[3] >= region[1])
+            {
+                aVisitor(mItems[0]);
+            }
+        }
+        return;
+    }
+    queryNode(region, rootLevel, 0, aVisitor);
+}
+
+
+template <class T_number>
+template <class T_visitor>
+void PackedRTree<T_number>::query(const Position<2, T_number> & aPosition, T_visitor && aVisitor) const
+{
+    query(Rectangle<T_number>{aPosition, {T_number{0}, T_number{0}}}, std::forward<T_visitor>(aVisitor));
+}
+
+
+}} // namespace ad::math
@@ -0,0 +1,60 @@
+#pragma once
+
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include <cstddef>
+
+
+namespace ad {
+namespace math {
+
+
+/// \brief Default number of threads for the parallel algorithms of the library.
+inline std::size_t defaultThreadCount()
+{
+    // hardware_concurrency() is allowed to return 0 when it cannot be computed
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+
+/// \brief Partitions [0, aCount) into contiguous ranges, calling `aTask(begin, end)`
+/// for each range on its own thread.
+///
+/// The calling thread processes the last range, and the function returns once all ranges are done.
+/// \attention aTask is invoked concurrently, it must not introduce data races between ranges.
+template <class T_task>
+void parallelFor(std::size_t aCount, std::size_t aThreadCount, T_task && aTask)
+{
+    aThreadCount = std::max<std::size_t>(1, std::min(aThreadCount, aCount));
+
+    std::vector<std::thread> threads;
+    threads.reserve(aThreadCount - 1);
+
+    const std::size_t chunk = aCount / aThreadCount;
+    const std::size_t remainder = aCount % aThreadCount;
+    std::size_t begin = 0;
+    for (std::size_t thread = 0; thread != aThreadCount; ++thread)
+    {
+        const std::size_t end = begin + chunk + (thread < remainder ? 1 : 0);
+        if (thread + 1 == aThreadCount)
+        {
+            aTask(begin, end);
+        }
+        else
+        {
+            threads.emplace_back([&aTask, begin, end](){ aTask(begin, end); });
+        }
+        begin = end;
+    }
+
+    for (std::thread & thread : threads)
+    {
+        thread.join();
+    }
+}
+
+
+}} // namespace ad::math
@@ -1,76 +1,596 @@
 #pragma once
 
 
+#include "Constants.h"
+#include "Parallel.h"
 #include "Utilities.h"
 
+#include <algorithm>
 #include <array>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
+#include <cassert>
 #include <cmath>
+#include <cstddef>
 
 
 namespace ad {
 namespace math {
 
 
+namespace detail {
+
+
+    /// \brief One step of Estrin's scheme: pairs consecutive coefficients as `a[2i] + a[2i+1] * x`.
+    template <class T_number, std::size_t N_count, std::size_t... VN_indices>
+    constexpr std::array<T_number, sizeof...(VN_indices)>
+    estrinPairs(const std::array<T_number, N_count> & aCoefficients, T_number aVariable,
+                std::index_sequence<VN_indices...>)
+    {
+        return {{
+            (2*VN_indices + 1 < N_count ? aCoefficients[2*VN_indices] + aCoefficients[2*VN_indices + 1] * aVariable
+                                        : aCoefficients[2*VN_indices])...
+        }};
+    }
+
+
+    /// \brief Coefficients are given in increasing degree.
+    template <class T_number, std::size_t N_count>
+    constexpr T_number estrin(const std::array<T_number, N_count> & aCoefficients, T_number aVariable)
+    {
+        if constexpr (N_count == 1)
+        {
+            return aCoefficients[0];
+        }
+        else
+        {
+            return estrin(estrinPairs(aCoefficients, aVariable, std::make_index_sequence<(N_count + 1) / 2>{}),
+                          aVariable * aVariable);
+        }
+    }
+
+
+} // namespace detail
+
+
 template <int N_degree, class T_number=double>
 class Polynomial
 {
     /// \brief The number of element in the mCoefficients array, thus including the constant.
     constexpr static int coefficient_count = N_degree+1;
 
+    /// \brief From this degree, evaluate() uses Estrin's scheme instead of Horner's.
+    constexpr static int estrin_degree = 4;
+
 public:
     /// \parameter aCoefficients the constant and polynomials coefficients. Given in increasing degree.
     template <class... VT_coefficients>
-    Polynomial(VT_coefficients... aCoefficients);
+    constexpr Polynomial(VT_coefficients... aCoefficients);
+
+    /// \parameter aCoefficients Given in increasing degree.
+    explicit constexpr Polynomial(const std::array<T_number, coefficient_count> & aCoefficients);
+
+    /// \brief Evaluates the polynomial with Horner's scheme for low degrees, Estrin's scheme above.
+    constexpr T_number evaluate(T_number aVariableValue) const;
+
+    /// \brief Reads aCount values from aVariableValues, and writes aCount results to aResults.
+    ///
+    /// aResults may be aVariableValues, for an in place evaluation.
+    void evaluate(const T_number * aVariableValues, std::size_t aCount, T_number * aResults) const;
+
+    /// \brief A single chain of multiply-adds: the fewest operations, but each depends on the previous.
+    constexpr T_number evaluateHorner(T_number aVariableValue) const;
+
+    /// \brief Evaluates pairs of coefficients independently then combines them with increasing powers
+    /// of the variable, which shortens the dependency chain to log2 of the degree.
+    constexpr T_number evaluateEstrin(T_number aVariableValue) const;
 
-    T_number evaluate(T_number aVariableValue);
+    constexpr T_number coefficient(std::size_t aIndex) const;
 
-    T_number coefficient(std::size_t aIndex) const;
+    /// \brief The coefficients in increasing degree.
+    constexpr const std::array<T_number, coefficient_count> & coefficients() const
+    { return mCoefficients; }
+
+    /// \brief The derivative of a constant is the null polynomial of degree 0.
+    constexpr Polynomial<(N_degree > 0 ? N_degree-1 : 0), T_number> derivative() const;
+
+    /// \brief The antiderivative taking the value aConstant at 0.
+    constexpr Polynomial<N_degree+1, T_number> integral(T_number aConstant = T_number{0}) const;
+
+    /// \brief The polynomial `x -> this(aInner(x))`.
+    template <int N_innerDegree>
+    constexpr Polynomial<N_degree*N_innerDegree, T_number>
+    compose(const Polynomial<N_innerDegree, T_number> & aInner) const;
+
+    constexpr Polynomial operator-() const;
+
+    constexpr Polynomial & operator*=(T_number aScalar);
 
 private:
     std::array<T_number, coefficient_count> mCoefficients;
 };
 
 
+/// \brief The degree of the sum is the highest of both degrees, even if the leading coefficients cancel out.
+template <int N_leftDegree, int N_rightDegree, class T_number>
+constexpr Polynomial<std::max(N_leftDegree, N_rightDegree), T_number>
+operator+(const Polynomial<N_leftDegree, T_number> & aLhs, const Polynomial<N_rightDegree, T_number> & aRhs);
+
+template <int N_leftDegree, int N_rightDegree, class T_number>
+constexpr Polynomial<std::max(N_leftDegree, N_rightDegree), T_number>
+operator-(const Polynomial<N_leftDegree, T_number> & aLhs, const Polynomial<N_rightDegree, T_number> & aRhs);
+
+template <int N_leftDegree, int N_rightDegree, class T_number>
+constexpr Polynomial<N_leftDegree+N_rightDegree, T_number>
+operator*(const Polynomial<N_leftDegree, T_number> & aLhs, const Polynomial<N_rightDegree, T_number> & aRhs);
+
+template <int N_degree, class T_number>
+constexpr Polynomial<N_degree, T_number> operator*(Polynomial<N_degree, T_number> aLhs, T_number aRhs)
+{ return aLhs *= aRhs; }
+
+template <int N_degree, class T_number>
+constexpr Polynomial<N_degree, T_number> operator*(T_number aLhs, Polynomial<N_degree, T_number> aRhs)
+{ return aRhs *= aLhs; }
+
+template <int N_degree, class T_number>
+constexpr bool operator==(const Polynomial<N_degree, T_number> & aLhs, const Polynomial<N_degree, T_number> & aRhs)
+{
+    for (std::size_t index = 0; index != N_degree+1; ++index)
+    {
+        if (aLhs.coefficients()[index] != aRhs.coefficients()[index])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <int N_degree, class T_number>
+constexpr bool operator!=(const Polynomial<N_degree, T_number> & aLhs, const Polynomial<N_degree, T_number> & aRhs)
+{ return !(aLhs == aRhs); }
+
+
 template <int N_degree, class T_number>
 template <class... VT_coefficients>
-Polynomial<N_degree, T_number>::Polynomial(VT_coefficients... aCoefficients) :
+constexpr Polynomial<N_degree, T_number>::Polynomial(VT_coefficients... aCoefficients) :
         mCoefficients{{aCoefficients...}}
 {}
 
 
 template <int N_degree, class T_number>
-T_number Polynomial<N_degree, T_number>::evaluate(T_number aVariableValue)
+constexpr Polynomial<N_degree, T_number>::Polynomial(const std::array<T_number, coefficient_count> & aCoefficients) :
+        mCoefficients{aCoefficients}
+{}
+
+
+template <int N_degree, class T_number>
+constexpr T_number Polynomial<N_degree, T_number>::evaluate(T_number aVariableValue) const
 {
-    T_number accumulator = mCoefficients.front();
-    for(std::size_t degree = 1; degree != coefficient_count; ++degree)
+    if constexpr (N_degree < estrin_degree)
     {
-        accumulator += std::pow(aVariableValue, degree)*coefficient(degree);
+        return evaluateHorner(aVariableValue);
+    }
+    else
+    {
+        return evaluateEstrin(aVariableValue);
+    }
+}
+
+
+template <int N_degree, class T_number>
+void Polynomial<N_degree, T_number>::evaluate(const T_number * aVariableValues, std::size_t aCount,
+                                              T_number * aResults) const
+{
+    // A copy of the coefficients, which the outputs may alias
+    const Polynomial polynomial = *this;
+    for (std::size_t index = 0; index != aCount; ++index)
+    {
+        aResults[index] = polynomial.evaluate(aVariableValues[index]);
+    }
+}
+
+
+template <int N_degree, class T_number>
+constexpr T_number Polynomial<N_degree, T_number>::evaluateHorner(T_number aVariableValue) const
+{
+    T_number accumulator = mCoefficients.back();
+    for(std::size_t degree = coefficient_count - 1; degree != 0; --degree)
+    {
+        accumulator = accumulator * aVariableValue + mCoefficients[degree - 1];
     }
     return accumulator;
 }
 
 
 template <int N_degree, class T_number>
-T_number Polynomial<N_degree, T_number>::coefficient(std::size_t aIndex) const
+constexpr T_number Polynomial<N_degree, T_number>::evaluateEstrin(T_number aVariableValue) const
+{
+    return detail::estrin(mCoefficients, aVariableValue);
+}
+
+
+template <int N_degree, class T_number>
+constexpr T_number Polynomial<N_degree, T_number>::coefficient(std::size_t aIndex) const
 {
     return mCoefficients.at(aIndex);
 }
 
 
+template <int N_degree, class T_number>
+constexpr auto Polynomial<N_degree, T_number>::derivative() const
+    -> Polynomial<(N_degree > 0 ? N_degree-1 : 0), T_number>
+{
+    std::array<T_number, (N_degree > 0 ? N_degree : 1)> result{};
+    for (std::size_t degree = 1; degree != coefficient_count; ++degree)
+    {
+        result[degree - 1] = static_cast<T_number>(degree) * mCoefficients[degree];
+    }
+    return Polynomial<(N_degree > 0 ? N_degree-1 : 0), T_number>{result};
+}
+
+
+template <int N_degree, class T_number>
+constexpr Polynomial<N_degree+1, T_number> Polynomial<N_degree, T_number>::integral(T_number aConstant) const
+{
+    std::array<T_number, coefficient_count+1> result{};
+    result[0] = aConstant;
+    for (std::size_t degree = 0; degree != coefficient_count; ++degree)
+    {
+        result[degree + 1] = mCoefficients[degree] / static_cast<T_number>(degree + 1);
+    }
+    return Polynomial<N_degree+1, T_number>{result};
+}
+
+
+template <int N_degree, class T_number>
+template <int N_innerDegree>
+constexpr Polynomial<N_degree*N_innerDegree, T_number>
+Polynomial<N_degree, T_number>::compose(const Polynomial<N_innerDegree, T_number> & aInner) const
+{
+    constexpr std::size_t resultCount = N_degree*N_innerDegree + 1;
+
+    // Horner's scheme, where the variable is the inner polynomial
+    std::array<T_number, resultCount> result{};
+    result[0] = mCoefficients.back();
+    std::size_t resultDegree = 0;
+    for (std::size_t degree = coefficient_count - 1; degree != 0; --degree)
+    {
+        std::array<T_number, resultCount> product{};
+        for (std::size_t left = 0; left != resultDegree + 1; ++left)
+        {
+            for (std::size_t right = 0; right != N_innerDegree + 1; ++right)
+            {
+                product[left + right] += result[left] * aInner.coefficients()[right];
+            }
+        }
+        product[0] += mCoefficients[degree - 1];
+        result = product;
+        resultDegree += N_innerDegree;
+    }
+    return Polynomial<N_degree*N_innerDegree, T_number>{result};
+}
+
+
+template <int N_degree, class T_number>
+constexpr Polynomial<N_degree, T_number> Polynomial<N_degree, T_number>::operator-() const
+{
+    Polynomial result = *this;
+    for (T_number & coefficient : result.mCoefficients)
+    {
+        coefficient = -coefficient;
+    }
+    return result;
+}
+
+
+template <int N_degree, class T_number>
+constexpr Polynomial<N_degree, T_number> & Polynomial<N_degree, T_number>::operator*=(T_number aScalar)
+{
+    for (T_number & coefficient : mCoefficients)
+    {
+        coefficient *= aScalar;
+    }
+    return *this;
+}
+
+
+template <int N_leftDegree, int N_rightDegree, class T_number>
+constexpr Polynomial<std::max(N_leftDegree, N_rightDegree), T_number>
+operator+(const Polynomial<N_leftDegree, T_number> & aLhs, const Polynomial<N_rightDegree, T_number> & aRhs)
+{
+    std::array<T_number, std::max(N_leftDegree, N_rightDegree) + 1> result{};
+    for (std::size_t degree = 0; degree != N_leftDegree + 1; ++degree)
+    {
+        result[degree] += aLhs.coefficients()[degree];
+    }
+    for (std::size_t degree = 0; degree != N_rightDegree + 1; ++degree)
+    {
+        result[degree] += aRhs.coefficients()[degree];
+    }
+    return Polynomial<std::max(N_leftDegree, N_rightDegree), T_number>{result};
+}
+
+
+template <int N_leftDegree, int N_rightDegree, class T_number>
+constexpr Polynomial<std::max(N_leftDegree, N_rightDegree), T_number>
+operator-(const Polynomial<N_leftDegree, T_number> & aLhs, const Polynomial<N_rightDegree, T_number> & aRhs)
+{
+    return aLhs + (-aRhs);
+}
+
+
+template <int N_leftDegree, int N_rightDegree, class T_number>
+constexpr Polynomial<N_leftDegree+N_rightDegree, T_number>
+operator*(const Polynomial<N_leftDegree, T_number> & aLhs, const Polynomial<N_rightDegree, T_number> & aRhs)
+{
+    std::array<T_number, N_leftDegree + N_rightDegree + 1> result{};
+    for (std::size_t left = 0; left != N_leftDegree + 1; ++left)
+    {
+        for (std::size_t right = 0; right != N_rightDegree + 1; ++right)
+        {
+            result[left + right] += aLhs.coefficients()[left] * aRhs.coefficients()[right];
+        }
+    }
+    return Polynomial<N_leftDegree+N_rightDegree, T_number>{result};
+}
+
+
 /***
  * Solvers
  ***/
 
-/// \return A vector containing the roots, in ascending order.
+/// \brief Fixed capacity container for the real roots of a polynomial, stored inline.
+///
+/// Solving does not allocate, while the roots remain convertible to a std::vector.
+template <int N_capacity, class T_number=double>
+class Roots
+{
+public:
+    using value_type = T_number;
+    using const_iterator = const T_number *;
+
+    constexpr std::size_t size() const
+    { return mSize; }
+
+    constexpr bool empty() const
+    { return mSize == 0; }
+
+    constexpr static std::size_t capacity()
+    { return N_capacity; }
+
+    constexpr T_number operator[](std::size_t aIndex) const
+    { assert(aIndex < mSize); return mRoots[aIndex]; }
+
+    constexpr T_number front() const
+    { return (*this)[0]; }
+
+    constexpr T_number back() const
+    { return (*this)[mSize - 1]; }
+
+    constexpr const_iterator begin() const
+    { return mRoots.data(); }
+
+    constexpr const_iterator end() const
+    { return mRoots.data() + mSize; }
+
+    constexpr void push_back(T_number aRoot)
+    { assert(mSize < N_capacity); mRoots[mSize++] = aRoot; }
+
+    operator std::vector<T_number>() const
+    { return std::vector<T_number>(begin(), end()); }
+
+private:
+    std::array<T_number, N_capacity> mRoots{};
+    std::size_t mSize{0};
+};
+
+
+/// \brief Solves with the formulation avoiding the cancellation of `-b + sqrt(delta)`.
+/// \return The distinct real roots, in ascending order.
+///
+/// A null leading coefficient degrades to the linear equation. Non-finite coefficients give no roots.
+template <class T_number>
+Roots<2, T_number> solve(const Polynomial<2, T_number> &aPolynomial);
+
+/// \brief Solves with the trigonometric method when there are three real roots, Cardano's formula otherwise.
+/// \return The distinct real roots, in ascending order.
+///
+/// A null leading coefficient degrades to the quadratic equation. Non-finite coefficients give no roots.
+template <class T_number>
+Roots<3, T_number> solve(const Polynomial<3, T_number> &aPolynomial);
+
+/// \brief Solves with Ferrari's method, factoring the depressed quartic in two quadratics
+/// via the largest root of its resolvent cubic.
+/// \return The distinct real roots, in ascending order.
+///
+/// A null leading coefficient degrades to the cubic equation. Non-finite coefficients give no roots.
+template <class T_number>
+Roots<4, T_number> solve(const Polynomial<4, T_number> &aPolynomial);
+
+/// \brief Isolates the real roots by bisection, counting the roots in each interval with a Sturm sequence,
+/// then refines each isolated root with Newton-Raphson steps, falling back to bisection.
+/// \return The distinct real roots, in ascending order.
+///
+/// Works for any degree, and handles null leading coefficients. Non-finite coefficients give no roots.
+/// The variable is scaled by a bound of the roots magnitudes, so the accuracy is relative to the largest root.
+/// Roots closer than the floating point resolution are returned once.
+///
+/// \attention The detection of multiple roots relies on estimates of the round-off errors of the Sturm sequence.
+/// On random polynomials of degree 10 with roots repeated among a few values, about 1 in 2000
+/// get a wrong count of roots in double precision, either losing or splitting a multiple root,
+/// while none did in 20000 polynomials of degree 8.
+/// A remainder of the sequence within these errors only ends it if the roots of the previous term
+/// are multiple roots of the polynomial, so close distinct roots are kept apart, unless the polynomial
+/// between them is itself within the round-off errors of its evaluation.
+/// When the rounding of the coefficients splits a multiple root into a cluster, it is only found
+/// to about the m-th root of the floating point precision, m being the multiplicity.
+template <int N_degree, class T_number>
+Roots<N_degree, T_number> solveSturm(const Polynomial<N_degree, T_number> &aPolynomial);
+
+/// \brief There is no closed-form solution above degree 4, solves with solveSturm().
+template <int N_degree, class T_number, class = std::enable_if_t<(N_degree > 4)>>
+Roots<N_degree, T_number> solve(const Polynomial<N_degree, T_number> &aPolynomial)
+{ return solveSturm(aPolynomial); }
+
+
+/***
+ * Batch solvers
+ *
+ * The polynomials are given as one array per coefficient, in increasing degree,
+ * and the roots are written to one array per root, in ascending order.
+ * For each polynomial, the number of real roots is written to aRootCounts,
+ * and the arrays past this count receive a quiet NaN, so that comparisons with them are false.
+ ***/
+
+/// \brief Branch-free, so the loop can vectorize.
+///
+/// \note std::sqrt is only inlined under -fno-math-errno, otherwise it remains a call that may set errno,
+/// which prevents vectorization.
+/// \attention Unlike the single polynomial solve(), the leading coefficients must not be null.
+template <class T_number>
+void solveQuadratics(const T_number * aCoefficients0, const T_number * aCoefficients1,
+                     const T_number * aCoefficients2,
+                     std::size_t aCount,
+                     T_number * aRoots0, T_number * aRoots1, int * aRootCounts);
+
+template <class T_number>
+void solveCubics(const T_number * aCoefficients0, const T_number * aCoefficients1,
+                 const T_number * aCoefficients2, const T_number * aCoefficients3,
+                 std::size_t aCount,
+                 T_number * aRoots0, T_number * aRoots1, T_number * aRoots2, int * aRootCounts);
+
+template <class T_number>
+void solveQuartics(const T_number * aCoefficients0, const T_number * aCoefficients1,
+                   const T_number * aCoefficients2, const T_number * aCoefficients3,
+                   const T_number * aCoefficients4,
+                   std::size_t aCount,
+                   T_number * aRoots0, T_number * aRoots1, T_number * aRoots2, T_number * aRoots3,
+                   int * aRootCounts);
+
+/// \brief Calls solve() on each of the aCount polynomials, distributed over aThreadCount threads.
+///
+/// Suited to the degrees above 4, whose solutions are found iteratively.
+template <int N_degree, class T_number>
+void solve(const Polynomial<N_degree, T_number> * aPolynomials, std::size_t aCount,
+           Roots<N_degree, T_number> * aResults, std::size_t aThreadCount = defaultThreadCount());
+
+
+namespace detail {
+
+
+    /// \brief Whether none of the coefficients is infinite or NaN.
+    template <int N_degree, class T_number>
+    bool isFinite(const Polynomial<N_degree, T_number> & aPolynomial)
+    {
+        const auto & coefficients = aPolynomial.coefficients();
+        return std::all_of(coefficients.begin(), coefficients.end(), [](T_number aCoefficient)
+                           { return std::isfinite(aCoefficient); });
+    }
+
+
+    /// \brief Converts to a container of larger capacity.
+    template <int N_capacity, int N_sourceCapacity, class T_number>
+    Roots<N_capacity, T_number> widen(const Roots<N_sourceCapacity, T_number> & aRoots)
+    {
+        Roots<N_capacity, T_number> result;
+        for (T_number root : aRoots)
+        {
+            result.push_back(root);
+        }
+        return result;
+    }
+
+
+    /// \brief One Newton-Raphson step on each root, only kept if it reduces the residual.
+    ///
+    /// The closed forms lose precision when computing with the depressed polynomial,
+    /// a single step recovers most of it.
+    template <int N_capacity, int N_degree, class T_number>
+    Roots<N_capacity, T_number> polish(const Roots<N_capacity, T_number> & aRoots,
+                                       const Polynomial<N_degree, T_number> & aPolynomial)
+    {
+        const Polynomial<N_degree-1, T_number> derivative = aPolynomial.derivative();
+
+        Roots<N_capacity, T_number> result;
+        for (T_number root : aRoots)
+        {
+            const T_number value = aPolynomial.evaluate(root);
+            const T_number slope = derivative.evaluate(root);
+            if (slope != T_number{0})
+            {
+                const T_number polished = root - value / slope;
+                if (std::abs(aPolynomial.evaluate(polished)) < std::abs(value))
+                {
+                    root = polished;
+                }
+            }
+            result.push_back(root);
+        }
+        return result;
+    }
+
+
+    /// \brief Sorts the roots in ascending order, and removes duplicates.
+    ///
+    /// Insertion sort, there are at most a handful of roots.
+    template <int N_capacity, class T_number>
+    Roots<N_capacity, T_number> sortUnique(const Roots<N_capacity, T_number> & aRoots)
+    {
+        std::array<T_number, N_capacity> sorted{};
+        std::size_t count = 0;
+        for (T_number root : aRoots)
+        {
+            std::size_t position = count++;
+            for (; position > 0 && root < sorted[position - 1]; --position)
+            {
+                sorted[position] = sorted[position - 1];
+            }
+            sorted[position] = root;
+        }
+
+        Roots<N_capacity, T_number> result;
+        for (std::size_t index = 0; index != count; ++index)
+        {
+            if (index == 0 || sorted[index] != sorted[index - 1])
+            {
+                result.push_back(sorted[index]);
+            }
+        }
+        return result;
+    }
+
+
+} // namespace detail
+
+
 template <class T_number>
-std::vector<T_number> solve(const Polynomial<2, T_number> &aPolynomial)
+Roots<2, T_number> solve(const Polynomial<2, T_number> &aPolynomial)
 {
+    if (!detail::isFinite(aPolynomial))
+    {
+        return {};
+    }
+
     const T_number A = aPolynomial.coefficient(2);
     const T_number B = aPolynomial.coefficient(1);
     const T_number C = aPolynomial.coefficient(0);
 
-    T_number delta = std::pow(B, 2) - 4*A*C;
+    Roots<2, T_number> result;
+
+    if (A == 0)
+    {
+        if (B != 0)
+        {
+            result.push_back(-C / B);
+        }
+        return result;
+    }
+
+    T_number delta = B*B - 4*A*C;
 
     if (delta > 0)
     {
@@ -79,17 +599,822 @@ std::vector<T_number> solve(const Polynomial<2, T_number> &aPolynomial)
         T_number bRoot = (2*C) / (-B + signedRoot);
         // By exhaustively writing all cases, we realize that when sign(A)==sign(B),
         // aRoot is always the smallest, bRoot otherwise
-        return sameSign(A, B) ? std::vector<T_number>{aRoot, bRoot}
-                              : std::vector<T_number>{bRoot, aRoot};
+        if (sameSign(A, B))
+        {
+            result.push_back(aRoot);
+            result.push_back(bRoot);
+        }
+        else
+        {
+            result.push_back(bRoot);
+            result.push_back(aRoot);
+        }
     } 
     else if (delta == 0)
     {
-        return { {-B / (2*A)} };
+        result.push_back(-B / (2*A));
+    }
+    return result;
+}
+
+
+template <class T_number>
+Roots<3, T_number> solve(const Polynomial<3, T_number> &aPolynomial)
+{
+    if (!detail::isFinite(aPolynomial))
+    {
+        return {};
+    }
+
+    if (aPolynomial.coefficient(3) == 0)
+    {
+        return detail::widen<3>(solve(Polynomial<2, T_number>{aPolynomial.coefficient(0),
+                                                              aPolynomial.coefficient(1),
+                                                              aPolynomial.coefficient(2)}));
+    }
+
+    // Normalized to `x^3 + a.x^2 + b.x + c`
+    const T_number a = aPolynomial.coefficient(2) / aPolynomial.coefficient(3);
+    const T_number b = aPolynomial.coefficient(1) / aPolynomial.coefficient(3);
+    const T_number c = aPolynomial.coefficient(0) / aPolynomial.coefficient(3);
+
+    const T_number shift = -a / 3;
+    const T_number Q = (a*a - 3*b) / 9;
+    const T_number R = (2*a*a*a - 9*a*b + 27*c) / 54;
+    const T_number Q3 = Q*Q*Q;
+    const T_number R2 = R*R;
+
+    Roots<3, T_number> result;
+    if (R2 < Q3)
+    {
+        // Three distinct real roots
+        const T_number theta = std::acos(std::clamp(R / std::sqrt(Q3), T_number{-1}, T_number{1}));
+        const T_number factor = -2 * std::sqrt(Q);
+        result.push_back(factor * std::cos(theta / 3) + shift);
+        result.push_back(factor * std::cos((theta + 2 * pi<T_number>) / 3) + shift);
+        result.push_back(factor * std::cos((theta - 2 * pi<T_number>) / 3) + shift);
     }
     else
+    {
+        const T_number cubicRoot = -std::copysign(std::cbrt(std::abs(R) + std::sqrt(R2 - Q3)), R);
+        const T_number other = (cubicRoot == 0) ? T_number{0} : Q / cubicRoot;
+        result.push_back(cubicRoot + other + shift);
+        // Double root, the other root being simple
+        if (R2 == Q3 && cubicRoot != 0)
+        {
+            result.push_back(-cubicRoot + shift);
+        }
+    }
+    return detail::sortUnique(detail::polish(result, aPolynomial));
+}
+
+
+template <class T_number>
+Roots<4, T_number> solve(const Polynomial<4, T_number> &aPolynomial)
+{
+    if (!detail::isFinite(aPolynomial))
     {
         return {};
     }
+
+    if (aPolynomial.coefficient(4) == 0)
+    {
+        return detail::widen<4>(solve(Polynomial<3, T_number>{aPolynomial.coefficient(0),
+                                                              aPolynomial.coefficient(1),
+                                                              aPolynomial.coefficient(2),
+                                                              aPolynomial.coefficient(3)}));
+    }
+
+    // Normalized to `x^4 + a.x^3 + b.x^2 + c.x + d`
+    const T_number a = aPolynomial.coefficient(3) / aPolynomial.coefficient(4);
+    const T_number b = aPolynomial.coefficient(2) / aPolynomial.coefficient(4);
+    const T_number c = aPolynomial.coefficient(1) / aPolynomial.coefficient(4);
+    const T_number d = aPolynomial.coefficient(0) / aPolynomial.coefficient(4);
+
+    // Depressed to `y^4 + p.y^2 + q.y + r`, with `x = y + shift`
+    const T_number shift = -a / 4;
+    const T_number a2 = a*a;
+    const T_number p = b - 3*a2/8;
+    const T_number q = c - a*b/2 + a2*a/8;
+    const T_number r = d - a*c/4 + a2*b/16 - 3*a2*a2/256;
+
+    Roots<4, T_number> result;
+    // `(y^2 + p/2 + m)^2 = 2m.(y - q/4m)^2` when m is a root of the resolvent cubic
+    const Roots<3, T_number> resolvent = solve(Polynomial<3, T_number>{-q*q, 2*p*p - 8*r, 8*p, T_number{8}});
+    const T_number m = resolvent.empty() ? T_number{0} : resolvent.back();
+
+    if (m > 0)
+    {
+        const T_number s = std::sqrt(2*m);
+        for (const T_number sign : {T_number{1}, T_number{-1}})
+        {
+            for (T_number root : solve(Polynomial<2, T_number>{p/2 + m + sign*q/(2*s), -sign*s, T_number{1}}))
+            {
+                result.push_back(root + shift);
+            }
+        }
+    }
+    else
+    {
+        // Biquadratic: q is null, solving for y^2
+        for (T_number square : solve(Polynomial<2, T_number>{r, p, T_number{1}}))
+        {
+            if (square >= 0)
+            {
+                result.push_back(std::sqrt(square) + shift);
+                result.push_back(-std::sqrt(square) + shift);
+            }
+        }
+    }
+    return detail::sortUnique(detail::polish(result, aPolynomial));
+}
+
+
+template <class T_number>
+void solveQuadratics(const T_number * aCoefficients0, const T_number * aCoefficients1,
+                     const T_number * aCoefficients2,
+                     std::size_t aCount,
+                     T_number * aRoots0, T_number * aRoots1, int * aRootCounts)
+{
+    constexpr T_number nan = std::numeric_limits<T_number>::quiet_NaN();
+
+    for (std::size_t index = 0; index != aCount; ++index)
+    {
+        const T_number A = aCoefficients2[index];
+        const T_number B = aCoefficients1[index];
+        const T_number C = aCoefficients0[index];
+
+        const T_number delta = B*B - 4*A*C;
+        const bool two = delta > 0;
+        const bool one = delta == 0;
+
+        const T_number root = std::sqrt(detail::select(two, delta, T_number{0}));
+        const T_number denominator = -B + detail::select(B >= 0, -root, root);
+        const T_number aRoot = denominator / (2*A);
+        // The denominator is only null for the double root 0, where aRoot is used
+        const T_number bRoot = (2*C) / detail::select(denominator == 0, T_number{1}, denominator);
+
+        aRootCounts[index] = 2 * static_cast<int>(two) + static_cast<int>(one);
+        aRoots0[index] = detail::select(two, std::min(aRoot, bRoot), detail::select(one, aRoot, nan));
+        aRoots1[index] = detail::select(two, std::max(aRoot, bRoot), nan);
+    }
+}
+
+
+namespace detail {
+
+
+    /// \brief Writes the roots to the SoA arrays, padding with NaNs.
+    template <int N_capacity, class T_number>
+    void scatterRoots(const Roots<N_capacity, T_number> & aRoots, std::size_t aIndex,
+                      T_number * const (&aOutputs)[N_capacity], int * aRootCounts)
+    {
+        for (std::size_t root = 0; root != N_capacity; ++root)
+        {
+            aOutputs[root][aIndex] = (root < aRoots.size()) ? aRoots[root]
+                                                            : std::numeric_limits<T_number>::quiet_NaN();
+        }
+        aRootCounts[aIndex] = static_cast<int>(aRoots.size());
+    }
+
+
+} // namespace detail
+
+
+template <class T_number>
+void solveCubics(const T_number * aCoefficients0, const T_number * aCoefficients1,
+                 const T_number * aCoefficients2, const T_number * aCoefficients3,
+                 std::size_t aCount,
+                 T_number * aRoots0, T_number * aRoots1, T_number * aRoots2, int * aRootCounts)
+{
+    T_number * const outputs[3] = {aRoots0, aRoots1, aRoots2};
+    for (std::size_t index = 0; index != aCount; ++index)
+    {
+        detail::scatterRoots(
+            solve(Polynomial<3, T_number>{aCoefficients0[index], aCoefficients1[index],
+                                          aCoefficients2[index], aCoefficients3[index]}),
+            index, outputs, aRootCounts);
+    }
+}
+
+
+template <class T_number>
+void solveQuartics(const T_number * aCoefficients0, const T_number * aCoefficients1,
+                   const T_number * aCoefficients2, const T_number * aCoefficients3,
+                   const T_number * aCoefficients4,
+                   std::size_t aCount,
+                   T_number * aRoots0, T_number * aRoots1, T_number * aRoots2, T_number * aRoots3,
+                   int * aRootCounts)
+{
+    T_number * const outputs[4] = {aRoots0, aRoots1, aRoots2, aRoots3};
+    for (std::size_t index = 0; index != aCount; ++index)
+    {
+        detail::scatterRoots(
+            solve(Polynomial<4, T_number>{aCoefficients0[index], aCoefficients1[index],
+                                          aCoefficients2[index], aCoefficients3[index],
+                                          aCoefficients4[index]}),
+            index, outputs, aRootCounts);
+    }
+}
+
+
+namespace detail {
+
+
+    /// \brief The sequence `p, p', -rem(p, p'), ...` where each term is minus the remainder of
+    /// the division of the two previous ones.
+    ///
+    /// The number of distinct real roots in `(a, b]` is the number of sign changes along the sequence
+    /// evaluated at a, minus the number of sign changes evaluated at b.
+    template <int N_degree, class T_number>
+    class SturmSequence
+    {
+        using coefficients_type = std::array<T_number, N_degree+1>;
+
+    public:
+        explicit SturmSequence(const Polynomial<N_degree, T_number> & aPolynomial);
+
+        T_number evaluate(T_number aVariableValue) const
+        { return mPolynomial.evaluate(aVariableValue); }
+
+        T_number evaluateDerivative(T_number aVariableValue) const
+        { return mDerivative.evaluate(aVariableValue); }
+
+        int countSignChanges(T_number aVariableValue) const;
+
+    private:
+        T_number evaluate(std::size_t aTerm, T_number aVariableValue) const;
+
+        /// \brief Divides the term and its errors by its largest coefficient magnitude,
+        /// which does not change its signs, and lowers its degree while the leading coefficient
+        /// is within its round-off errors.
+        /// \param aNormError Estimate of the round-off errors, relative to the dividend and divisor sizes.
+        /// \return false if the whole term is within its round-off errors, i.e. it might be null.
+        /// Its degree is then only lowered over null coefficients.
+        bool normalize(std::size_t aTerm, T_number aNormError);
+
+        /// \brief Whether the term can be the greatest common divisor of the polynomial and its derivative:
+        /// each of its real roots must be a multiple root of the polynomial.
+        bool isGreatestCommonDivisor(std::size_t aTerm) const;
+
+        /// \brief Whether each real root of the term, whose degree is at most N_divisor,
+        /// is a multiple root of the polynomial.
+        template <int N_divisor>
+        bool hasMultipleRootsOnly(std::size_t aTerm) const;
+
+        /// \brief A coefficient is within its round-off errors if it is not larger than both
+        /// the error relative to the term sizes, and its own propagated error.
+        bool isInsignificant(std::size_t aTerm, int aDegree) const
+        {
+            const T_number magnitude = std::abs(mTerms[aTerm][aDegree]);
+            return magnitude <= mNormErrors[aTerm] && magnitude <= mErrors[aTerm][aDegree];
+        }
+
+        // Not normalized, for the refinement of the roots
+        Polynomial<N_degree, T_number> mPolynomial;
+        Polynomial<(N_degree > 0 ? N_degree-1 : 0), T_number> mDerivative;
+
+        std::array<coefficients_type, N_degree+1> mTerms{};
+        std::array<int, N_degree+1> mDegrees{};
+        // Estimate of the round-off errors of each term, relative to its largest coefficient.
+        // It is not amplified by the normalization of small remainders, which would end the sequence
+        // early on close distinct roots.
+        std::array<T_number, N_degree+1> mNormErrors{};
+        // Running bound of the round-off error on each coefficient of each term.
+        // It follows the coefficients magnitudes, which can span many orders when the roots do.
+        std::array<coefficients_type, N_degree+1> mErrors{};
+        std::size_t mTermCount{0};
+    };
+
+
+    /// \brief Fujiwara's bound with a margin, all the roots being strictly inside `(-bound, bound)`.
+    /// \attention The leading coefficient must not be null.
+    template <int N_degree, class T_number>
+    T_number getRootBound(const std::array<T_number, N_degree+1> & aCoefficients, int aDegree);
+
+
+    /// \brief Polishes aRoot, which may be several steps away, into a multiple root of the polynomial.
+    /// \return The polished root if both the polynomial and its derivative are null there within their
+    /// round-off errors, nothing otherwise.
+    template <int N_degree, class T_number>
+    std::optional<T_number> findMultipleRoot(const std::array<T_number, N_degree+1> & aCoefficients, int aDegree,
+                                             T_number aRoot);
+
+
+    template <int N_degree, class T_number>
+    SturmSequence<N_degree, T_number>::SturmSequence(const Polynomial<N_degree, T_number> & aPolynomial) :
+        mPolynomial{aPolynomial},
+        mDerivative{aPolynomial.derivative()}
+    {
+        // The terms are normalized to a largest coefficient of 1, and carry estimates of their round-off errors,
+        // propagated through the divisions
+        const T_number epsilon = std::numeric_limits<T_number>::epsilon();
+
+        mTerms[0] = aPolynomial.coefficients();
+        mDegrees[0] = N_degree;
+        while (mDegrees[0] > 0 && mTerms[0][mDegrees[0]] == 0)
+        {
+            --mDegrees[0];
+        }
+        mTermCount = 1;
+        // The coefficients are assumed rounded once
+        for (int degree = 0; degree <= mDegrees[0]; ++degree)
+        {
+            mErrors[0][degree] = epsilon * std::abs(mTerms[0][degree]);
+        }
+        normalize(0, epsilon);
+        if (mDegrees[0] == 0)
+        {
+            return;
+        }
+
+        for (int degree = 1; degree <= mDegrees[0]; ++degree)
+        {
+            mTerms[1][degree - 1] = static_cast<T_number>(degree) * mTerms[0][degree];
+            mErrors[1][degree - 1] = static_cast<T_number>(degree) * mErrors[0][degree]
+                                     + epsilon * std::abs(mTerms[1][degree - 1]);
+        }
+        mDegrees[1] = mDegrees[0] - 1;
+        normalize(1, 2 * epsilon);
+        mTermCount = 2;
+
+        while (mDegrees[mTermCount - 1] > 0)
+        {
+            // Remainder of the division of the two previous terms, computed in place of the dividend
+            coefficients_type remainder = mTerms[mTermCount - 2];
+            coefficients_type error = mErrors[mTermCount - 2];
+            const coefficients_type & divisor = mTerms[mTermCount - 1];
+            const coefficients_type & divisorError = mErrors[mTermCount - 1];
+            const int divisorDegree = mDegrees[mTermCount - 1];
+            // The dividend and divisor have a largest coefficient of 1, so the magnitude of the
+            // subtracted products is bounded by the sum of the quotient magnitudes
+            T_number quotientMagnitude = 0;
+            int steps = 0;
+            for (int degree = mDegrees[mTermCount - 2]; degree >= divisorDegree; --degree)
+            {
+                const T_number quotient = remainder[degree] / divisor[divisorDegree];
+                quotientMagnitude += std::abs(quotient);
+                ++steps;
+                // First order propagation of the errors of the dividend and divisor through the quotient
+                const T_number quotientError = (error[degree] + std::abs(quotient) * divisorError[divisorDegree])
+                                               / std::abs(divisor[divisorDegree])
+                                               + epsilon * std::abs(quotient);
+                for (int term = 0; term <= divisorDegree; ++term)
+                {
+                    const int index = degree - divisorDegree + term;
+                    const T_number product = quotient * divisor[term];
+                    remainder[index] -= product;
+                    // Plus one rounding of the product and one of the difference
+                    error[index] += quotientError * std::abs(divisor[term])
+                                    + std::abs(quotient) * divisorError[term]
+                                    + epsilon * (std::abs(product) + std::abs(remainder[index]));
+                }
+                remainder[degree] = 0;
+            }
+
+            const std::size_t term = mTermCount;
+            mDegrees[term] = divisorDegree - 1;
+            for (int degree = 0; degree <= mDegrees[term]; ++degree)
+            {
+                mTerms[term][degree] = -remainder[degree];
+                mErrors[term][degree] = error[degree];
+            }
+            // The errors of the dividend and divisor, plus one rounding of the product and one of the difference,
+            // relative to the magnitude of the subtracted products and accumulated over the steps of the division.
+            const T_number normError = (mNormErrors[mTermCount - 2] + mNormErrors[mTermCount - 1] + 2 * epsilon)
+                                       * (1 + quotientMagnitude) * steps;
+            const bool significant = normalize(term, normError);
+            // A null remainder ends the sequence, the previous term being the greatest common divisor
+            // of the polynomial and its derivative.
+            // A remainder within its round-off errors might be null, but close distinct roots also leave
+            // small remainders: it only ends the sequence if the previous term is confirmed as the divisor.
+            if (mTerms[term][mDegrees[term]] == 0 || (!significant && isGreatestCommonDivisor(term - 1)))
+            {
+                break;
+            }
+            ++mTermCount;
+        }
+    }
+
+
+    template <int N_degree, class T_number>
+    bool SturmSequence<N_degree, T_number>::normalize(std::size_t aTerm, T_number aNormError)
+    {
+        mNormErrors[aTerm] = aNormError;
+        T_number largest = 0;
+        bool significant = false;
+        for (int degree = 0; degree <= mDegrees[aTerm]; ++degree)
+        {
+            largest = std::max(largest, std::abs(mTerms[aTerm][degree]));
+            significant |= !isInsignificant(aTerm, degree);
+        }
+
+        if (largest != 0)
+        {
+            for (int degree = 0; degree <= mDegrees[aTerm]; ++degree)
+            {
+                mTerms[aTerm][degree] /= largest;
+                mErrors[aTerm][degree] /= largest;
+            }
+        }
+        while (mDegrees[aTerm] > 0
+               && (mTerms[aTerm][mDegrees[aTerm]] == 0 || (significant && isInsignificant(aTerm, mDegrees[aTerm]))))
+        {
+            --mDegrees[aTerm];
+        }
+        return significant;
+    }
+
+
+    template <int N_degree, class T_number>
+    bool SturmSequence<N_degree, T_number>::isGreatestCommonDivisor(std::size_t aTerm) const
+    {
+        // The roots of the term are found with the closed forms, which do not rely on estimates of round-off errors:
+        // the coefficients of the term carry errors much larger than the machine precision.
+        // A term of higher degree would be a common divisor with at least 5 multiple roots,
+        // which close distinct roots do not mimic, and is accepted.
+        switch (mDegrees[aTerm])
+        {
+            case 1:
+            case 2:
+                return hasMultipleRootsOnly<2>(aTerm);
+            case 3:
+                return hasMultipleRootsOnly<3>(aTerm);
+            case 4:
+                return hasMultipleRootsOnly<4>(aTerm);
+            default:
+                return true;
+        }
+    }
+
+
+    template <int N_degree, class T_number>
+    template <int N_divisor>
+    bool SturmSequence<N_degree, T_number>::hasMultipleRootsOnly(std::size_t aTerm) const
+    {
+        // Coefficients above the degree of the term might not be null
+        std::array<T_number, N_divisor+1> divisor{};
+        std::copy_n(mTerms[aTerm].begin(), mDegrees[aTerm] + 1, divisor.begin());
+        // Without real roots, the term does not change sign, so it also ends a valid sequence
+        for (T_number root : solve(Polynomial<N_divisor, T_number>{divisor}))
+        {
+            if (!findMultipleRoot<N_degree>(mPolynomial.coefficients(), mDegrees[0], root))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+
+    template <int N_degree, class T_number>
+    T_number SturmSequence<N_degree, T_number>::evaluate(std::size_t aTerm, T_number aVariableValue) const
+    {
+        const coefficients_type & coefficients = mTerms[aTerm];
+        T_number accumulator = coefficients[mDegrees[aTerm]];
+        for (int degree = mDegrees[aTerm]; degree != 0; --degree)
+        {
+            accumulator = accumulator * aVariableValue + coefficients[degree - 1];
+        }
+        return accumulator;
+    }
+
+
+    template <int N_degree, class T_number>
+    int SturmSequence<N_degree, T_number>::countSignChanges(T_number aVariableValue) const
+    {
+        int changes = 0;
+        bool previousNegative = false;
+        bool hasPrevious = false;
+        for (std::size_t term = 0; term != mTermCount; ++term)
+        {
+            const T_number value = evaluate(term, aVariableValue);
+            // Null values are skipped
+            if (value != 0)
+            {
+                const bool negative = value < 0;
+                changes += (hasPrevious && negative != previousNegative) ? 1 : 0;
+                previousNegative = negative;
+                hasPrevious = true;
+            }
+        }
+        return changes;
+    }
+
+
+    template <int N_degree, class T_number>
+    T_number getRootBound(const std::array<T_number, N_degree+1> & aCoefficients, int aDegree)
+    {
+        // `2 * max(|a(n-i) / a(n)|^(1/i))`, where the constant term is halved
+        T_number largest = std::pow(std::abs(aCoefficients[0] / (2 * aCoefficients[aDegree])),
+                                    T_number{1} / aDegree);
+        for (int power = 1; power != aDegree; ++power)
+        {
+            largest = std::max(largest,
+                               std::pow(std::abs(aCoefficients[aDegree - power] / aCoefficients[aDegree]),
+                                        T_number{1} / power));
+        }
+        // The bound is reached by some polynomials, e.g. `x - a`.
+        // When all the other coefficients are null, the only root is 0.
+        return (largest == 0) ? T_number{1} : 2 * largest * T_number(1.0625);
+    }
+
+
+    /// \brief Refines the single root in `(aLow, aHigh]` where the polynomial changes sign,
+    /// with Newton-Raphson steps that fall back to bisection when leaving the bracket,
+    /// or when not converging fast enough.
+    template <int N_degree, class T_number>
+    T_number refineBracketed(const SturmSequence<N_degree, T_number> & aSequence, T_number aLow, T_number aHigh)
+    {
+        T_number lowValue = aSequence.evaluate(aLow);
+        T_number root = (aLow + aHigh) / 2;
+        T_number step = aHigh - aLow;
+        T_number previousStep = step;
+        // Enough for bisection alone to exhaust the floating point resolution
+        for (int iteration = 0; iteration != 2 * std::numeric_limits<T_number>::digits; ++iteration)
+        {
+            const T_number value = aSequence.evaluate(root);
+            if (value == 0)
+            {
+                return root;
+            }
+            if (sameSign(value, lowValue))
+            {
+                aLow = root;
+                lowValue = value;
+            }
+            else
+            {
+                aHigh = root;
+            }
+
+            const T_number slope = aSequence.evaluateDerivative(root);
+            T_number next = (slope != 0) ? root - value / slope : aLow;
+            // Each step must at least halve the step before the previous, as bisection does
+            if (!(next > aLow && next < aHigh) || 2 * std::abs(next - root) > previousStep)
+            {
+                next = (aLow + aHigh) / 2;
+            }
+            previousStep = step;
+            step = std::abs(next - root);
+            if (next == root || next == aLow || next == aHigh)
+            {
+                return next;
+            }
+            root = next;
+        }
+        return root;
+    }
+
+
+    /// \brief Finds the single root in `(aLow, aHigh]`, which may be a root of even multiplicity
+    /// where the polynomial does not change sign, by bisection with the sign changes counts.
+    template <int N_degree, class T_number>
+    T_number refineSturm(const SturmSequence<N_degree, T_number> & aSequence,
+                         T_number aLow, T_number aHigh, const int aHighChanges, T_number aResolution)
+    {
+        T_number middle = (aLow + aHigh) / 2;
+        while (aHigh - aLow > aResolution)
+        {
+            // The root is in `(middle, aHigh]` if the count of sign changes differs at both ends
+            if (aSequence.countSignChanges(middle) != aHighChanges)
+            {
+                aLow = middle;
+            }
+            else
+            {
+                aHigh = middle;
+            }
+            middle = (aLow + aHigh) / 2;
+        }
+        return middle;
+    }
+
+
+    /// \brief Horner's scheme, also returning `sum(|a(i)| * |x|^i)`, which bounds the round-off errors of the value
+    /// once multiplied by `2 * degree * epsilon`.
+    template <int N_degree, class T_number>
+    std::pair<T_number, T_number> evaluateWithMagnitude(const std::array<T_number, N_degree+1> & aCoefficients,
+                                                        int aDegree, T_number aVariableValue)
+    {
+        T_number value = aCoefficients[aDegree];
+        T_number magnitude = std::abs(value);
+        for (int degree = aDegree; degree != 0; --degree)
+        {
+            value = value * aVariableValue + aCoefficients[degree - 1];
+            magnitude = magnitude * std::abs(aVariableValue) + std::abs(aCoefficients[degree - 1]);
+        }
+        return {value, magnitude};
+    }
+
+
+    /// \brief Whether the value of the polynomial is within its round-off errors.
+    template <int N_degree, class T_number>
+    bool isNull(const std::array<T_number, N_degree+1> & aCoefficients, int aDegree, T_number aVariableValue)
+    {
+        const auto [value, magnitude] = evaluateWithMagnitude<N_degree>(aCoefficients, aDegree, aVariableValue);
+        return std::abs(value) <= 2 * aDegree * std::numeric_limits<T_number>::epsilon() * magnitude;
+    }
+
+
+    template <int N_degree, class T_number>
+    std::optional<T_number> findMultipleRoot(const std::array<T_number, N_degree+1> & aCoefficients, int aDegree,
+                                             T_number aRoot)
+    {
+        using coefficients_type = std::array<T_number, N_degree+1>;
+        const T_number epsilon = std::numeric_limits<T_number>::epsilon();
+
+        auto differentiate = [](coefficients_type aTerm, int aTermDegree)
+        {
+            for (int power = 1; power <= aTermDegree; ++power)
+            {
+                aTerm[power - 1] = static_cast<T_number>(power) * aTerm[power];
+            }
+            aTerm[aTermDegree] = 0;
+            return aTerm;
+        };
+
+        if (aDegree < 2)
+        {
+            return std::nullopt;
+        }
+
+        // Newton-Raphson steps for `p' / p''`
+        const coefficients_type first = differentiate(aCoefficients, aDegree);
+        const coefficients_type second = differentiate(first, aDegree - 1);
+        const coefficients_type third = differentiate(second, aDegree - 2);
+        auto isMultipleRoot = [&](T_number aValue)
+        {
+            return isNull<N_degree>(aCoefficients, aDegree, aValue) && isNull<N_degree>(first, aDegree - 1, aValue);
+        };
+        // Above multiplicity 2, the steps wander within the round-off errors of the derivatives:
+        // the last step meeting the conditions is kept
+        std::optional<T_number> result;
+        if (isMultipleRoot(aRoot))
+        {
+            result = aRoot;
+        }
+        T_number root = aRoot;
+        for (int iteration = 0; iteration != std::numeric_limits<T_number>::digits; ++iteration)
+        {
+            const T_number slope = evaluateWithMagnitude<N_degree>(first, aDegree - 1, root).first;
+            const T_number curvature = evaluateWithMagnitude<N_degree>(second, aDegree - 2, root).first;
+            const T_number change = evaluateWithMagnitude<N_degree>(third, std::max(aDegree - 3, 0), root).first;
+            const T_number denominator = curvature * curvature - slope * change;
+            if (denominator == 0)
+            {
+                break;
+            }
+            const T_number step = slope * curvature / denominator;
+            root -= step;
+            if (isMultipleRoot(root))
+            {
+                result = root;
+            }
+            if (std::abs(step) <= epsilon * std::abs(root))
+            {
+                break;
+            }
+        }
+        return result;
+    }
+
+
+    /// \brief A root of multiplicity m is only bracketed to about the m-th root of the floating point precision,
+    /// where the round-off errors of the polynomial exceed its value.
+    /// It is also a root of the derivative, on which Newton-Raphson steps for `p' / p''` converge quadratically
+    /// whatever the multiplicity.
+    /// \return The polished root if both the polynomial and its derivative are null there within their
+    /// round-off errors, i.e. it is a multiple root, and if it is the only distinct root around aRoot.
+    /// Otherwise aRoot, so close distinct roots are not moved to the extremum between them.
+    template <int N_degree, class T_number>
+    T_number polishMultipleRoot(const SturmSequence<N_degree, T_number> & aSequence,
+                                const std::array<T_number, N_degree+1> & aCoefficients, int aDegree,
+                                T_number aRoot)
+    {
+        // Simple roots are not polished
+        if (!isNull<N_degree>(aCoefficients, aDegree, aRoot))
+        {
+            return aRoot;
+        }
+        const std::optional<T_number> root = findMultipleRoot<N_degree>(aCoefficients, aDegree, aRoot);
+        if (!root)
+        {
+            return aRoot;
+        }
+        const T_number spread = 2 * std::abs(*root - aRoot);
+        return (spread == 0
+                || aSequence.countSignChanges(*root - spread) - aSequence.countSignChanges(*root + spread) == 1) ?
+               *root : aRoot;
+    }
+
+
+    /// \brief Appends the distinct roots in `(aLow, aHigh]` to aRoots, in ascending order.
+    ///
+    /// \param aResolution Intervals narrower than this are not split anymore,
+    /// the sign changes counts being unreliable at this scale.
+    template <int N_degree, class T_number>
+    void isolateRoots(const SturmSequence<N_degree, T_number> & aSequence,
+                      T_number aLow, T_number aHigh, int aLowChanges, int aHighChanges,
+                      T_number aResolution,
+                      Roots<N_degree, T_number> & aRoots)
+    {
+        const int count = aLowChanges - aHighChanges;
+        // Round-off errors in the sequence could report more roots than the degree allows
+        if (count <= 0 || aRoots.size() == aRoots.capacity())
+        {
+            return;
+        }
+
+        const T_number middle = (aLow + aHigh) / 2;
+        // The roots are numerically equal
+        if (aHigh - aLow <= aResolution)
+        {
+            aRoots.push_back(middle);
+            return;
+        }
+
+        if (count == 1)
+        {
+            if (!sameSign(aSequence.evaluate(aLow), aSequence.evaluate(aHigh)))
+            {
+                aRoots.push_back(refineBracketed(aSequence, aLow, aHigh));
+            }
+            else
+            {
+                aRoots.push_back(refineSturm(aSequence, aLow, aHigh, aHighChanges, aResolution));
+            }
+            return;
+        }
+
+        const int middleChanges = aSequence.countSignChanges(middle);
+        isolateRoots(aSequence, aLow, middle, aLowChanges, middleChanges, aResolution, aRoots);
+        isolateRoots(aSequence, middle, aHigh, middleChanges, aHighChanges, aResolution, aRoots);
+    }
+
+
+} // namespace detail
+
+
+template <int N_degree, class T_number>
+Roots<N_degree, T_number> solveSturm(const Polynomial<N_degree, T_number> &aPolynomial)
+{
+    Roots<N_degree, T_number> result;
+
+    std::array<T_number, N_degree+1> coefficients = aPolynomial.coefficients();
+    int degree = N_degree;
+    while (degree > 0 && coefficients[degree] == 0)
+    {
+        --degree;
+    }
+    if (degree == 0 || !detail::isFinite(aPolynomial))
+    {
+        return result;
+    }
+
+    // The variable is scaled by the root bound, so that all the roots are in (-1, 1).
+    // The coefficients of the Sturm sequence are then of comparable magnitudes whatever the scale of the roots,
+    // which the error estimates on its terms rely on.
+    // The bound is rounded up to a power of 2, so the scaling is exact.
+    // Dividing by `bound^degree` in the same pass keeps the leading coefficient unchanged, without overflows.
+    int exponent;
+    std::frexp(detail::getRootBound<N_degree>(coefficients, degree), &exponent);
+    for (int index = 0; index <= degree; ++index)
+    {
+        coefficients[index] = std::ldexp(coefficients[index], (index - degree) * exponent);
+    }
+    const detail::SturmSequence<N_degree, T_number> sequence{Polynomial<N_degree, T_number>{coefficients}};
+
+    // The sign changes are not counted correctly at a multiple root, where all terms are null.
+    // The interval is asymmetric, its width derived from the golden ratio, so that the bisection points avoid 0
+    // and the short binary and decimal fractions where multiple roots are common, which the exact scaling keeps.
+    const T_number low = -1;
+    const T_number high = T_number(1.0618034);
+    Roots<N_degree, T_number> scaled;
+    detail::isolateRoots(sequence, low, high,
+                         sequence.countSignChanges(low), sequence.countSignChanges(high),
+                         4 * std::numeric_limits<T_number>::epsilon(),
+                         scaled);
+
+    for (T_number root : scaled)
+    {
+        result.push_back(std::ldexp(detail::polishMultipleRoot(sequence, coefficients, degree, root), exponent));
+    }
+    return detail::sortUnique(result);
+}
+
+
+template <int N_degree, class T_number>
+void solve(const Polynomial<N_degree, T_number> * aPolynomials, std::size_t aCount,
+           Roots<N_degree, T_number> * aResults, std::size_t aThreadCount)
+{
+    parallelFor(aCount, aThreadCount, [&](std::size_t aBegin, std::size_t aEnd)
+    {
+        for (std::size_t index = aBegin; index != aEnd; ++index)
+        {
+            aResults[index] = solve(aPolynomials[index]);
+        }
+    });
 }
 
 
@@ -0,0 +1,389 @@
+#pragma once
+
+
+#include "Angle.h"
+#include "Matrix.h"
+#include "Trigonometry.h"
+#include "Vector.h"
+
+#include <cmath>
+
+
+namespace ad {
+namespace math {
+
+
+#define ACCESSOR_DIMENSION(symbol, dimension)  \
+    constexpr T_number & symbol()               \
+    { return this->at(dimension-1); }           \
+    constexpr T_number symbol() const           \
+    { return this->at(dimension-1); }
+
+
+/// \brief Quaternion stored as (x, y, z, w), w being the real part.
+///
+/// Composition follows the row vector convention of the library:
+/// `a * b` rotates by `a`, then by `b`, like `aMatrix * bMatrix` would.
+/// (This is the Hamilton product b.a)
+#define BASE Vector<Quaternion<T_number>, 4, T_number>
+template <class T_number=real_number>
+class Quaternion : public BASE
+{
+    typedef BASE base_type;
+    using base_type::base_type;
+
+public:
+    template<class T>
+    using derived_type = Quaternion<T>;
+
+    /// \brief Rotation of aAngle around aAxis, matching trans3d::rotate(aAngle, aAxis).
+    template <class T_unitTag>
+    Quaternion(const Angle<T_number, T_unitTag> aAngle, const UnitVec<3, T_number> aAxis);
+
+    /// \brief Rotation represented by the orthogonal matrix aRotation.
+    explicit Quaternion(const Matrix<3, 3, T_number> & aRotation);
+
+    static constexpr Quaternion Identity();
+
+    ACCESSOR_DIMENSION(x, 1)
+    ACCESSOR_DIMENSION(y, 2)
+    ACCESSOR_DIMENSION(z, 3)
+    ACCESSOR_DIMENSION(w, 4)
+
+    /// \brief The imaginary part
+    constexpr Vec<3, T_number> getVector() const;
+
+    constexpr Quaternion conjugate() const;
+    /// \brief For unit quaternions, the inverse is the conjugate.
+    constexpr Quaternion inverse() const;
+
+    constexpr Quaternion & operator*=(const Quaternion & aRhs);
+    using base_type::operator*=;
+
+    // Implementer's note: Not constexpr, because Vec::cross() is not
+    /// \brief Rotates aVector by this unit quaternion.
+    /*constexpr*/ Vec<3, T_number> rotate(Vec<3, T_number> aVector) const;
+
+    /// \brief Matrix to right-multiply row vectors by, matching trans3d::rotate().
+    constexpr Matrix<3, 3, T_number> toRotationMatrix() const;
+
+    /*constexpr*/ Radian<T_number> getAngle() const;
+    /// \brief The rotation axis, x axis for the identity rotation.
+    /*constexpr*/ UnitVec<3, T_number> getAxis() const;
+};
+#undef BASE
+
+
+#undef ACCESSOR_DIMENSION
+
+
+template <class T_number>
+constexpr Quaternion<T_number> operator*(Quaternion<T_number> aLhs, const Quaternion<T_number> & aRhs)
+{
+    return aLhs *= aRhs;
+}
+
+
+/// \brief Rotates the row vector by the quaternion, as `aVector * aQuaternion.toRotationMatrix()`.
+template <class T_number>
+Vec<3, T_number> operator*(const Vec<3, T_number> aVector, const Quaternion<T_number> & aRhs)
+{
+    return aRhs.rotate(aVector);
+}
+
+
+/***
+ * Interpolations
+ ***/
+
+/// \brief Normalized linear interpolation, along the shortest path.
+template <class T_number>
+Quaternion<T_number> nlerp(const Quaternion<T_number> & aFrom,
+                           const Quaternion<T_number> & aTo,
+                           T_number aFactor);
+
+/// \brief Spherical linear interpolation, along the shortest path.
+template <class T_number>
+Quaternion<T_number> slerp(const Quaternion<T_number> & aFrom,
+                           const Quaternion<T_number> & aTo,
+                           T_number aFactor);
+
+
+/// \brief Batch nlerp, interpolating aCount pairs of quaternions by the same aFactor.
+template <class T_number>
+void nlerp(const Quaternion<T_number> * aFrom,
+           const Quaternion<T_number> * aTo,
+           T_number aFactor,
+           std::size_t aCount,
+           Quaternion<T_number> * aResults);
+
+/// \brief Batch slerp, interpolating aCount pairs of quaternions by the same aFactor.
+///
+/// \note Branch-free, relying on the Precise tier of the batch trigonometry kernels.
+template <class T_number>
+void slerp(const Quaternion<T_number> * aFrom,
+           const Quaternion<T_number> * aTo,
+           T_number aFactor,
+           std::size_t aCount,
+           Quaternion<T_number> * aResults);
+
+
+/***
+ * Implementation
+ ***/
+
+template <class T_number>
+template <class T_unitTag>
+Quaternion<T_number>::Quaternion(const Angle<T_number, T_unitTag> aAngle,
+                                 const UnitVec<3, T_number> aAxis) :
+    base_type{typename base_type::UninitializedTag{}}
+{
+    const Radian<T_number> half = Radian<T_number>{aAngle} / 2;
+    const T_number sine = sin(half);
+    x() = aAxis.x() * sine;
+    y() = aAxis.y() * sine;
+    z() = aAxis.z() * sine;
+    w() = cos(half);
+}
+
+
+template <class T_number>
+Quaternion<T_number>::Quaternion(const Matrix<3, 3, T_number> & aRotation) :
+    base_type{typename base_type::UninitializedTag{}}
+{
+    // Shepperd's method, selecting the largest component to divide by.
+    // Written on the column vector matrix R, which is the transpose of aRotation.
+    auto R = [&aRotation](std::size_t aRow, std::size_t aColumn)
+    {
+        return aRotation.at(aColumn, aRow);
+    };
+
+    const T_number trace = R(0, 0) + R(1, 1) + R(2, 2);
+    if (trace > 0)
+    {
+        const T_number s = std::sqrt(trace + 1) * 2;
+        w() = s / 4;
+        x() = (R(2, 1) - R(1, 2)) / s;
+        y() = (R(0, 2) - R(2, 0)) / s;
+        z() = (R(1, 0) - R(0, 1)) / s;
+    }
+    else if (R(0, 0) > R(1, 1) && R(0, 0) > R(2, 2))
+    {
+        const T_number s = std::sqrt(1 + R(0, 0) - R(1, 1) - R(2, 2)) * 2;
+        w() = (R(2, 1) - R(1, 2)) / s;
+        x() = s / 4;
+        y() = (R(0, 1) + R(1, 0)) / s;
+        z() = (R(0, 2) + R(2, 0)) / s;
+    }
+    else if (R(1, 1) > R(2, 2))
+    {
+        const T_number s = std::sqrt(1 + R(1, 1) - R(0, 0) - R(2, 2)) * 2;
+        w() = (R(0, 2) - R(2, 0)) / s;
+        x() = (R(0, 1) + R(1, 0)) / s;
+        y() = s / 4;
+        z() = (R(1, 2) + R(2, 1)) / s;
+    }
+    else
+    {
+        const T_number s = std::sqrt(1 + R(2, 2) - R(0, 0) - R(1, 1)) * 2;
+        w() = (R(1, 0) - R(0, 1)) / s;
+        x() = (R(0, 2) + R(2, 0)) / s;
+        y() = (R(1, 2) + R(2, 1)) / s;
+        z() = s / 4;
+    }
+}
+
+
+template <class T_number>
+constexpr Quaternion<T_number> Quaternion<T_number>::Identity()
+{
+    return {T_number{0}, T_number{0}, T_number{0}, T_number{1}};
+}
+
+
+template <class T_number>
+constexpr Vec<3, T_number> Quaternion<T_number>::getVector() const
+{
+    return {x(), y(), z()};
+}
+
+
+template <class T_number>
+constexpr Quaternion<T_number> Quaternion<T_number>::conjugate() const
+{
+    return {-x(), -y(), -z(), w()};
+}
+
+
+template <class T_number>
+constexpr Quaternion<T_number> Quaternion<T_number>::inverse() const
+{
+    return conjugate() / this->getNormSquared();
+}
+
+
+template <class T_number>
+constexpr Quaternion<T_number> & Quaternion<T_number>::operator*=(const Quaternion & aRhs)
+{
+    // Hamilton product aRhs.this, so the rotation by *this is applied first
+    const Quaternion & l = aRhs;
+    const Quaternion r = *this;
+    *this = {
+        l.w()*r.x() + l.x()*r.w() + l.y()*r.z() - l.z()*r.y(),
+        l.w()*r.y() - l.x()*r.z() + l.y()*r.w() + l.z()*r.x(),
+        l.w()*r.z() + l.x()*r.y() - l.y()*r.x() + l.z()*r.w(),
+        l.w()*r.w() - l.x()*r.x() - l.y()*r.y() - l.z()*r.z(),
+    };
+    return *this;
+}
+
+
+template <class T_number>
+Vec<3, T_number> Quaternion<T_number>::rotate(Vec<3, T_number> aVector) const
+{
+    // v' = v + w.t + q x t, with t = 2 (q x v)
+    Vec<3, T_number> imaginary = getVector();
+    Vec<3, T_number> t = imaginary.cross(aVector) * T_number{2};
+    return aVector + t * w() + imaginary.cross(t);
+}
+
+
+template <class T_number>
+constexpr Matrix<3, 3, T_number> Quaternion<T_number>::toRotationMatrix() const
+{
+    const T_number xx = x()*x(), yy = y()*y(), zz = z()*z();
+    const T_number xy = x()*y(), xz = x()*z(), yz = y()*z();
+    const T_number xw = x()*w(), yw = y()*w(), zw = z()*w();
+
+    // Transpose of the usual column vector matrix
+    return {
+        1 - 2*(yy + zz),        2*(xy + zw),        2*(xz - yw),
+            2*(xy - zw),    1 - 2*(xx + zz),        2*(yz + xw),
+            2*(xz + yw),        2*(yz - xw),    1 - 2*(xx + yy),
+    };
+}
+
+
+template <class T_number>
+Radian<T_number> Quaternion<T_number>::getAngle() const
+{
+    return Radian<T_number>{2 * std::atan2(getVector().getNorm(), w())};
+}
+
+
+template <class T_number>
+UnitVec<3, T_number> Quaternion<T_number>::getAxis() const
+{
+    const Vec<3, T_number> imaginary = getVector();
+    if (imaginary.getNormSquared() == 0)
+    {
+        return UnitVec<3, T_number>{{T_number{1}, T_number{0}, T_number{0}}};
+    }
+    return UnitVec<3, T_number>{imaginary};
+}
+
+
+template <class T_number>
+Quaternion<T_number> nlerp(const Quaternion<T_number> & aFrom,
+                           const Quaternion<T_number> & aTo,
+                           T_number aFactor)
+{
+    // q and -q are the same rotation, interpolate toward the closest one
+    const T_number sign = (aFrom.dot(aTo) < 0) ? T_number{-1} : T_number{1};
+    Quaternion<T_number> result = aFrom * (1 - aFactor) + aTo * (sign * aFactor);
+    return result.normalize();
+}
+
+
+template <class T_number>
+Quaternion<T_number> slerp(const Quaternion<T_number> & aFrom,
+                           const Quaternion<T_number> & aTo,
+                           T_number aFactor)
+{
+    T_number cosine = aFrom.dot(aTo);
+    const T_number sign = (cosine < 0) ? T_number{-1} : T_number{1};
+    cosine *= sign;
+
+    // Close quaternions make the spherical weights ill-conditioned
+    if (cosine > T_number(0.9995))
+    {
+        return nlerp(aFrom, aTo, aFactor);
+    }
+
+    const T_number angle = std::acos(cosine);
+    const T_number sine = std::sin(angle);
+    return aFrom * (std::sin((1 - aFactor) * angle) / sine)
+           + aTo * (sign * std::sin(aFactor * angle) / sine);
+}
+
+
+template <class T_number>
+void nlerp(const Quaternion<T_number> * aFrom,
+           const Quaternion<T_number> * aTo,
+           T_number aFactor,
+           std::size_t aCount,
+           Quaternion<T_number> * aResults)
+{
+    for (std::size_t index = 0; index != aCount; ++index)
+    {
+        const Quaternion<T_number> & from = aFrom[index];
+        const Quaternion<T_number> & to = aTo[index];
+        const T_number toWeight = detail::select(from.dot(to) < 0, -aFactor, aFactor);
+        const T_number fromWeight = 1 - aFactor;
+
+        T_number normSquared = 0;
+        for (std::size_t component = 0; component != 4; ++component)
+        {
+            const T_number value = from[component] * fromWeight + to[component] * toWeight;
+            aResults[index][component] = value;
+            normSquared += value * value;
+        }
+        aResults[index] /= std::sqrt(normSquared);
+    }
+}
+
+
+template <class T_number>
+void slerp(const Quaternion<T_number> * aFrom,
+           const Quaternion<T_number> * aTo,
+           T_number aFactor,
+           std::size_t aCount,
+           Quaternion<T_number> * aResults)
+{
+    using kernel = detail::TrigonometryKernel<T_number, TrigonometryAccuracy::Precise>;
+
+    for (std::size_t index = 0; index != aCount; ++index)
+    {
+        const Quaternion<T_number> & from = aFrom[index];
+        const Quaternion<T_number> & to = aTo[index];
+
+        const T_number dot = from.dot(to);
+        const T_number cosine = std::abs(dot);
+        // The angle in [0, pi/2], as atan(sine/cosine). A null cosine gives atan(inf).
+        const T_number sine = std::sqrt(std::max(T_number{0}, 1 - cosine * cosine));
+        const T_number angle = kernel::atan(sine / cosine);
+
+        // Falls back to linear weights when the quaternions are close,
+        // the normalization below turning it into nlerp
+        const bool close = cosine > T_number(0.9995);
+        const T_number safeSine = detail::select(close, T_number{1}, sine);
+        const T_number fromWeight =
+            detail::select(close, 1 - aFactor, kernel::sin((1 - aFactor) * angle) / safeSine);
+        const T_number toWeight =
+            detail::select(close, aFactor, kernel::sin(aFactor * angle) / safeSine);
+        const T_number signedToWeight = detail::select(dot < 0, -toWeight, toWeight);
+
+        T_number normSquared = 0;
+        for (std::size_t component = 0; component != 4; ++component)
+        {
+            const T_number value = from[component] * fromWeight + to[component] * signedToWeight;
+            aResults[index][component] = value;
+            normSquared += value * value;
+        }
+        // Only corrects rounding when slerping, normalizes when falling back to lerp
+        aResults[index] /= std::sqrt(normSquared);
+    }
+}
+
+
+}} // namespace ad::math
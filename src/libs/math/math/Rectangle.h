@@ -1,7 +1,13 @@
 #pragma once
 
+#include "Bitmask.h"
 #include "Vector.h"
 
+#include <algorithm>
+
+#include <cstddef>
+#include <cstdint>
+
 namespace ad {
 namespace math {
 
@@ -69,6 +75,13 @@ struct Rectangle
     template <class T_positionValue>
     bool contains(Position<2, T_positionValue> aPosition) const;
 
+    /// \brief Batch contains(), over aCount positions stored as separate X and Y arrays.
+    /// \param aResults Receives one bit per position, in bitmaskWordCount(aCount) words (see Bitmask.h).
+    template <class T_positionValue>
+    void contains(const T_positionValue * aX, const T_positionValue * aY,
+                  std::size_t aCount,
+                  std::uint64_t * aResults) const;
+
     Position<2, T_number> closestPoint(Position<2, T_number> aPosition) const;
 
     Position<2, T_number>  mPosition;
@@ -87,6 +100,31 @@ bool Rectangle<T_number>::contains(Position<2, T_positionValue> aPosition) const
 }
 
 
+template <class T_number>
+template <class T_positionValue>
+void Rectangle<T_number>::contains(const T_positionValue * aX, const T_positionValue * aY,
+                                   std::size_t aCount,
+                                   std::uint64_t * aResults) const
+{
+    // Locals, see detail::packBits()
+    const T_number xLow = xMin(), xHigh = xMax();
+    const T_number yLow = yMin(), yHigh = yMax();
+
+    detail::packBits(aCount, aResults,
+                     [&](std::size_t aBegin, std::size_t aBlockCount, std::uint8_t * aFlags)
+    {
+        const T_positionValue * x = aX + aBegin;
+        const T_positionValue * y = aY + aBegin;
+        for (std::size_t index = 0; index != aBlockCount; ++index)
+        {
+            // Non short-circuiting &, keeping the loop free of branches
+            aFlags[index] = (x[index] >= xLow) & (y[index] >= yLow)
+                            & (x[index] <= xHigh) & (y[index] <= yHigh);
+        }
+    });
+}
+
+
 template <class T_number>
 Position<2, T_number> Rectangle<T_number>::closestPoint(Position<2, T_number> aPosition) const
 {
@@ -96,4 +134,29 @@ Position<2, T_number> Rectangle<T_number>::closestPoint(Position<2, T_number> aP
 }
 
 
+/// \brief Batch Rectangle::contains(), testing aPosition against aCount rectangles.
+/// \param aResults Receives one bit per rectangle, in bitmaskWordCount(aCount) words (see Bitmask.h).
+template <class T_number, class T_positionValue>
+void contains(const Rectangle<T_number> * aRectangles,
+              std::size_t aCount,
+              Position<2, T_positionValue> aPosition,
+              std::uint64_t * aResults)
+{
+    const T_positionValue x = aPosition.x();
+    const T_positionValue y = aPosition.y();
+
+    detail::packBits(aCount, aResults,
+                     [&](std::size_t aBegin, std::size_t aBlockCount, std::uint8_t * aFlags)
+    {
+        const Rectangle<T_number> * rectangles = aRectangles + aBegin;
+        for (std::size_t index = 0; index != aBlockCount; ++index)
+        {
+            const Rectangle<T_number> & rectangle = rectangles[index];
+            aFlags[index] = (x >= rectangle.xMin()) & (y >= rectangle.yMin())
+                            & (x <= rectangle.xMax()) & (y <= rectangle.yMax());
+        }
+    });
+}
+
+
 }} // namespace ad::math
@@ -0,0 +1,290 @@
+#pragma once
+
+
+#include "Rectangle.h"
+#include "commons.h"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <vector>
+
+#include <cassert>
+#include <cstddef>
+
+
+namespace ad {
+namespace math {
+
+
+/// \brief Packs rectangles into bins of fixed size, for example to build texture atlases.
+///
+/// Each bin keeps its skyline: the top edge of the placed rectangles, as a list of horizontal segments
+/// from left to right. A rectangle is placed on the skyline where its top is lowest (then leftmost),
+/// so the cost of an insertion only depends on the number of segments, not on the number of placed rectangles.
+/// The space below the skyline that is left empty is lost.
+///
+/// Bins are opened on demand, when a rectangle does not fit in any of the open bins.
+/// Rectangles are never rotated.
+template <class T_number=int>
+class SkylinePacker
+{
+public:
+    using size_type = Size<2, T_number>;
+
+    static constexpr std::size_t gNoBin = std::numeric_limits<std::size_t>::max();
+
+    struct Placement
+    {
+        /// \brief gNoBin if the rectangle could not be placed.
+        std::size_t bin;
+        Rectangle<T_number> rectangle;
+    };
+
+    /// \param aMaxBinCount Once this many bins are open, rectangles that do not fit are rejected.
+    explicit SkylinePacker(size_type aBinSize,
+                           std::size_t aMaxBinCount = std::numeric_limits<std::size_t>::max());
+
+    /// \brief Places a single rectangle, after the rectangles already inserted.
+    ///
+    /// An empty size takes no space: it is placed at the origin of the last bin without opening a bin,
+    /// and rejected while no bin is open.
+    std::optional<Placement> insert(size_type aSize);
+
+    /// \brief Places aCount rectangles, tallest first, which packs tighter than insertion in arbitrary order.
+    /// \return The placement of each size, in the order of aSizes.
+    std::vector<Placement> insert(const size_type * aSizes, std::size_t aCount);
+
+    size_type getBinSize() const
+    { return mBinSize; }
+
+    std::size_t getBinCount() const
+    { return mBins.size(); }
+
+    /// \brief Fraction of the area of aBin covered by rectangles.
+    real_number getOccupancy(std::size_t aBin) const
+    { return mBins[aBin].usedArea / (static_cast<real_number>(mBinSize.width()) * mBinSize.height()); }
+
+    /// \brief Removes all bins.
+    void clear()
+    { mBins.clear(); }
+
+private:
+    struct Segment
+    {
+        T_number x;
+        T_number y;
+        T_number width;
+    };
+
+    struct Bin
+    {
+        std::vector<Segment> skyline;
+        // Lowest segment of the skyline, to skip the bins where a rectangle cannot fit
+        T_number lowest;
+        real_number usedArea;
+    };
+
+    struct Fit
+    {
+        std::size_t segment;
+        T_number y;
+    };
+
+    Bin makeBin() const;
+
+    /// \brief Lowest position where aSize fits in aBin, if any.
+    std::optional<Fit> findFit(const Bin & aBin, size_type aSize) const;
+
+    void place(Bin & aBin, const Fit & aFit, size_type aSize);
+
+    size_type mBinSize;
+    std::size_t mMaxBinCount;
+    std::vector<Bin> mBins;
+};
+
+
+//
+// Implementation
+//
+template <class T_number>
+SkylinePacker<T_number>::SkylinePacker(size_type aBinSize, std::size_t aMaxBinCount) :
+    mBinSize{aBinSize},
+    mMaxBinCount{aMaxBinCount}
+{
+    assert(aBinSize.width() > T_number{0} && aBinSize.height() > T_number{0});
+}
+
+
+template <class T_number>
+auto SkylinePacker<T_number>::makeBin() const -> Bin
+{
+    return Bin{
+        {Segment{T_number{0}, T_number{0}, mBinSize.width()}},
+        T_number{0},
+        real_number{0},
+    };
+}
+
+
+template <class T_number>
+auto SkylinePacker<T_number>::findFit(const Bin & aBin, size_type aSize) const -> std::optional<Fit>
+{
+    std::optional<Fit> best;
+    T_number bestTop = mBinSize.height() + T_number{1};
+
+    const std::vector<Segment> & skyline = aBin.skyline;
+    for (std::size_t first = 0; first != skyline.size(); ++first)
+    {
+        const T_number x = skyline[first].x;
+        // Segments are sorted by x, the following ones would overflow too
+        if (x + aSize.width() > mBinSize.width())
+        {
+            break;
+        }
+
+        // The rectangle rests on the highest segment it spans
+        T_number y = skyline[first].y;
+        for (std::size_t segment = first + 1;
+             segment != skyline.size() && skyline[segment].x < x + aSize.width();
+             ++segment)
+        {
+            y = std::max(y, skyline[segment].y);
+        }
+
+        const T_number top = y + aSize.height();
+        if (top <= mBinSize.height() && top < bestTop)
+        {
+            best = Fit{first, y};
+            bestTop = top;
+        }
+    }
+    return best;
+}
+
+
+template <class T_number>
+void SkylinePacker<T_number>::place(Bin & aBin, const Fit & aFit, size_type aSize)
+{
+    // Empty rectangles are handled by insert(), they would add zero width segments
+    assert(aSize.width() != T_number{0} && aSize.height() != T_number{0});
+
+    std::vector<Segment> & skyline = aBin.skyline;
+    const T_number x = skyline[aFit.segment].x;
+    const T_number right = x + aSize.width();
+
+    // The segments covered by the rectangle are shortened, or removed when entirely covered
+    std::size_t next = aFit.segment;
+    while (next != skyline.size() && skyline[next].x < right)
+    {
+        const T_number segmentRight = skyline[next].x + skyline[next].width;
+        if (segmentRight <= right)
+        {
+            ++next;
+        }
+        else
+        {
+            skyline[next].width = segmentRight - right;
+            skyline[next].x = right;
+            break;
+        }
+    }
+    skyline.erase(skyline.begin() + aFit.segment, skyline.begin() + next);
+    auto inserted = skyline.insert(skyline.begin() + aFit.segment,
+                                   Segment{x, aFit.y + aSize.height(), aSize.width()});
+
+    // Merges with neighbours at the same height, keeping the skyline short
+    if (std::next(inserted) != skyline.end() && std::next(inserted)->y == inserted->y)
+    {
+        inserted->width += std::next(inserted)->width;
+        inserted = std::prev(skyline.erase(std::next(inserted)));
+    }
+    if (inserted != skyline.begin() && std::prev(inserted)->y == inserted->y)
+    {
+        std::prev(inserted)->width += inserted->width;
+        skyline.erase(inserted);
+    }
+
+    aBin.lowest = std::min_element(skyline.begin(), skyline.end(),
+                                   [](const Segment & aLhs, const Segment & aRhs)
+                                   {
+                                       return aLhs.y < aRhs.y;
+                                   })->y;
+    aBin.usedArea += static_cast<real_number>(aSize.width()) * aSize.height();
+}
+
+
+template <class T_number>
+auto SkylinePacker<T_number>::insert(size_type aSize) -> std::optional<Placement>
+{
+    if (aSize.width() > mBinSize.width() || aSize.height() > mBinSize.height())
+    {
+        return std::nullopt;
+    }
+
+    if (aSize.width() == T_number{0} || aSize.height() == T_number{0})
+    {
+        if (mBins.empty())
+        {
+            return std::nullopt;
+        }
+        return Placement{mBins.size() - 1, {{T_number{0}, T_number{0}}, aSize}};
+    }
+
+    // First bin where the rectangle fits, filling the earlier bins first
+    for (std::size_t bin = 0; bin != mBins.size(); ++bin)
+    {
+        if (mBins[bin].lowest + aSize.height() > mBinSize.height())
+        {
+            continue;
+        }
+        if (std::optional<Fit> fit = findFit(mBins[bin], aSize))
+        {
+            Placement result{bin, {{mBins[bin].skyline[fit->segment].x, fit->y}, aSize}};
+            place(mBins[bin], *fit, aSize);
+            return result;
+        }
+    }
+
+    if (mBins.size() == mMaxBinCount)
+    {
+        return std::nullopt;
+    }
+    // An empty bin fits any rectangle not larger than the bin, at its origin
+    mBins.push_back(makeBin());
+    place(mBins.back(), Fit{0, T_number{0}}, aSize);
+    return Placement{mBins.size() - 1, {{T_number{0}, T_number{0}}, aSize}};
+}
+
+
+template <class T_number>
+auto SkylinePacker<T_number>::insert(const size_type * aSizes, std::size_t aCount) -> std::vector<Placement>
+{
+    std::vector<std::size_t> order(aCount);
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::stable_sort(order.begin(), order.end(), [aSizes](std::size_t aLhs, std::size_t aRhs)
+    {
+        return aSizes[aLhs].height() > aSizes[aRhs].height()
+            || (aSizes[aLhs].height() == aSizes[aRhs].height() && aSizes[aLhs].width() > aSizes[aRhs].width());
+    });
+
+    // Sizes the vector, placements not being default constructible
+    std::vector<Placement> result(aCount, Placement{gNoBin, {{T_number{0}, T_number{0}}, {T_number{0}, T_number{0}}}});
+    for (std::size_t index : order)
+    {
+        if (std::optional<Placement> placement = insert(aSizes[index]))
+        {
+            result[index] = *placement;
+        }
+        else
+        {
+            result[index].rectangle.mDimension = aSizes[index];
+        }
+    }
+    return result;
+}
+
+
+}} // namespace ad::math
@@ -0,0 +1,242 @@
+#pragma once
+
+
+#include "Parallel.h"
+#include "Vector.h"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace ad {
+namespace math {
+
+
+/// \brief Uniform grid of cubic cells over positions, for fixed radius neighbour queries.
+///
+/// The grid is unbounded: cells are mapped to a fixed number of buckets by hashing their integer coordinates.
+/// Each rebuild() counting sorts the positions by bucket, so the points of a bucket are contiguous in memory,
+/// and no storage is allocated per cell.
+///
+/// \note Queries are most efficient when the cell size is close to the query radius.
+template <int N_dimension, class T_number=real_number>
+class SpatialHashGrid
+{
+    static_assert(N_dimension >= 1 && N_dimension <= 3, "The cell hash is defined for up to 3 dimensions.");
+
+public:
+    using position_type = Position<N_dimension, T_number>;
+    using PointIndex = std::uint32_t;
+    using Cell = std::array<std::int32_t, N_dimension>;
+
+    /// \param aBucketCount Rounded up to a power of two. A count close to the number of points is a good default.
+    SpatialHashGrid(T_number aCellSize, std::size_t aBucketCount);
+
+    /// \brief Replaces the indexed points with aPositions, which are copied.
+    void rebuild(const position_type * aPositions, std::size_t aCount);
+
+    std::size_t size() const
+    { return mSortedIndices.size(); }
+
+    T_number getCellSize() const
+    { return mCellSize; }
+
+    Cell getCell(const position_type & aPosition) const;
+
+    /// \brief Spatial hash of Teschner et al. (2003), masked to the bucket count.
+    std::size_t getBucket(const Cell & aCell) const;
+
+    /// \brief Calls `aVisitor(PointIndex, T_number squaredDistance)` for each point within aRadius of aPosition
+    /// (inclusive), including a point at aPosition.
+    ///
+    /// \pre aRadius is not negative. Otherwise, no point is visited.
+    template <class T_visitor>
+    void forEachNeighbour(const position_type & aPosition, T_number aRadius, T_visitor && aVisitor) const;
+
+    /// \brief Calls `aVisitor(PointIndex point, PointIndex neighbour, T_number squaredDistance)` for each point
+    /// and each of its neighbours within aRadius, excluding itself.
+    ///
+    /// Points are processed by bucket order, so consecutive points share the buckets they read.
+    /// \attention aVisitor is invoked concurrently from aThreadCount threads, though all calls
+    /// for a given `point` come from the same thread.
+    /// \pre aRadius is not negative. Otherwise, no pair is visited.
+    template <class T_visitor>
+    void forEachNeighbourPair(T_number aRadius, std::size_t aThreadCount, T_visitor && aVisitor) const;
+
+private:
+    T_number mCellSize;
+    T_number mInverseCellSize;
+    std::size_t mBucketMask;
+    // mBucketStarts[bucket] is the position in sorted order of the first point in bucket,
+    // with a last element one past the last point.
+    std::vector<PointIndex> mBucketStarts;
+    // Bucket of each point, in input order (kept to reuse its storage across rebuilds)
+    std::vector<std::uint32_t> mBuckets;
+    std::vector<PointIndex> mSortedIndices;
+    std::vector<position_type> mSortedPositions;
+};
+
+
+//
+// Implementation
+//
+template <int N_dimension, class T_number>
+SpatialHashGrid<N_dimension, T_number>::SpatialHashGrid(T_number aCellSize, std::size_t aBucketCount) :
+    mCellSize{aCellSize},
+    mInverseCellSize{T_number{1} / aCellSize}
+{
+    assert(aCellSize > T_number{0});
+
+    std::size_t bucketCount = 1;
+    while (bucketCount < aBucketCount)
+    {
+        bucketCount *= 2;
+    }
+    mBucketMask = bucketCount - 1;
+    mBucketStarts.resize(bucketCount + 1);
+}
+
+
+template <int N_dimension, class T_number>
+auto SpatialHashGrid<N_dimension, T_number>::getCell(const position_type & aPosition) const -> Cell
+{
+    Cell result;
+    for (std::size_t axis = 0; axis != N_dimension; ++axis)
+    {
+        result[axis] = static_cast<std::int32_t>(std::floor(aPosition[axis] * mInverseCellSize));
+    }
+    return result;
+}
+
+
+template <int N_dimension, class T_number>
+std::size_t SpatialHashGrid<N_dimension, T_number>::getBucket(const Cell & aCell) const
+{
+    constexpr std::uint32_t primes[] = {73856093u, 19349663u, 83492791u};
+    std::uint32_t hash = 0;
+    for (std::size_t axis = 0; axis != N_dimension; ++axis)
+    {
+        // Unsigned, so the products wrap around
+        hash ^= static_cast<std::uint32_t>(aCell[axis]) * primes[axis];
+    }
+    return hash & mBucketMask;
+}
+
+
+template <int N_dimension, class T_number>
+void SpatialHashGrid<N_dimension, T_number>::rebuild(const position_type * aPositions, std::size_t aCount)
+{
+    // Counting sort by bucket: count, prefix sum, then scatter.
+    // The vectors only reallocate when the point count grows.
+    mBuckets.resize(aCount);
+    std::fill(mBucketStarts.begin(), mBucketStarts.end(), PointIndex{0});
+    for (std::size_t point = 0; point != aCount; ++point)
+    {
+        mBuckets[point] = static_cast<std::uint32_t>(getBucket(getCell(aPositions[point])));
+        ++mBucketStarts[mBuckets[point] + 1];
+    }
+    for (std::size_t bucket = 1; bucket != mBucketStarts.size(); ++bucket)
+    {
+        mBucketStarts[bucket] += mBucketStarts[bucket - 1];
+    }
+
+    mSortedIndices.resize(aCount);
+    // Sizes the vector, positions not being default constructible
+    mSortedPositions.assign(aPositions, aPositions + aCount);
+    // Each bucket start is used as its insertion cursor, leaving it at the start of the next bucket
+    for (std::size_t point = 0; point != aCount; ++point)
+    {
+        const PointIndex position = mBucketStarts[mBuckets[point]]++;
+        mSortedIndices[position] = static_cast<PointIndex>(point);
+        mSortedPositions[position] = aPositions[point];
+    }
+    // Shifts the cursors back to the bucket starts
+    std::copy_backward(mBucketStarts.begin(), mBucketStarts.end() - 1, mBucketStarts.end());
+    mBucketStarts[0] = 0;
+}
+
+
+template <int N_dimension, class T_number>
+template <class T_visitor>
+void SpatialHashGrid<N_dimension, T_number>::forEachNeighbour(const position_type & aPosition,
+                                                             T_number aRadius,
+                                                             T_visitor && aVisitor) const
+{
+    assert(aRadius >= T_number{0});
+    // A negative (or NaN) radius would put minCell past maxCell, which the cell loop would never reach
+    if (!(aRadius >= T_number{0}))
+    {
+        return;
+    }
+
+    const T_number squaredRadius = aRadius * aRadius;
+
+    Cell minCell;
+    Cell maxCell;
+    for (std::size_t axis = 0; axis != N_dimension; ++axis)
+    {
+        minCell[axis] = static_cast<std::int32_t>(std::floor((aPosition[axis] - aRadius) * mInverseCellSize));
+        maxCell[axis] = static_cast<std::int32_t>(std::floor((aPosition[axis] + aRadius) * mInverseCellSize));
+    }
+
+    Cell cell = minCell;
+    for (;;)
+    {
+        const std::size_t bucket = getBucket(cell);
+        for (PointIndex position = mBucketStarts[bucket]; position != mBucketStarts[bucket + 1]; ++position)
+        {
+            const T_number squaredDistance = (mSortedPositions[position] - aPosition).getNormSquared();
+            // Points of other cells sharing the bucket are skipped:
+            // if in range, they are visited with their own cell.
+            if (squaredDistance <= squaredRadius && getCell(mSortedPositions[position]) == cell)
+            {
+                aVisitor(mSortedIndices[position], squaredDistance);
+            }
+        }
+
+        // Next cell of the range, the first axis varying fastest
+        std::size_t axis = 0;
+        for (; axis != N_dimension && cell[axis] == maxCell[axis]; ++axis)
+        {
+            cell[axis] = minCell[axis];
+        }
+        if (axis == N_dimension)
+        {
+            return;
+        }
+        ++cell[axis];
+    }
+}
+
+
+template <int N_dimension, class T_number>
+template <class T_visitor>
+void SpatialHashGrid<N_dimension, T_number>::forEachNeighbourPair(T_number aRadius,
+                                                                 std::size_t aThreadCount,
+                                                                 T_visitor && aVisitor) const
+{
+    parallelFor(mSortedIndices.size(), aThreadCount, [&](std::size_t aBegin, std::size_t aEnd)
+    {
+        for (std::size_t position = aBegin; position != aEnd; ++position)
+        {
+            const PointIndex point = mSortedIndices[position];
+            forEachNeighbour(mSortedPositions[position], aRadius,
+                             [&aVisitor, point](PointIndex aNeighbour, T_number aSquaredDistance)
+                             {
+                                 if (aNeighbour != point)
+                                 {
+                                     aVisitor(point, aNeighbour, aSquaredDistance);
+                                 }
+                             });
+        }
+    });
+}
+
+
+}} // namespace ad::math
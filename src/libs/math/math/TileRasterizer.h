@@ -0,0 +1,612 @@
+#pragma once
+
+
+#include "Barycentric.h"
+#include "Parallel.h"
+#include "Utilities.h"
+#include "Vector.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace ad {
+namespace math {
+
+
+/// \brief Rasterizes triangles into a fixed size target, keeping the closest triangle at each pixel.
+///
+/// For each pixel, the target stores the index of the closest covering triangle, its depth,
+/// and the barycentric coordinates of the pixel center in this triangle.
+/// Pixel (x, y) is sampled at (x + 0.5, y + 0.5), and a sample on an edge is covered.
+///
+/// Triangles are first binned into square screen tiles, then the tiles are rasterized concurrently.
+/// Coverage is rejected or accepted hierarchically: a whole tile when binning a triangle,
+/// then each block of 8x8 pixels, before testing individual pixels.
+/// Triangles within a single tile are only binned, their setup is done by the thread rasterizing the tile.
+///
+/// The target is stored by blocks of 8x8 pixels, so a block is rasterized with a single loop
+/// over contiguous pixels, which vectorizes.
+///
+/// \note Depth and barycentric coordinates are interpolated linearly in screen space,
+/// without perspective correction.
+template <class T_number=float>
+class TileRasterizer
+{
+public:
+    using TriangleIndex = std::uint32_t;
+    using Coordinates = typename Barycentric<T_number>::Coordinates;
+
+    static constexpr TriangleIndex gNoTriangle = std::numeric_limits<TriangleIndex>::max();
+    static constexpr int gBlockSize = 8;
+    static constexpr std::size_t gBlockPixels = gBlockSize * gBlockSize;
+    // Triangles covering at most this many pixels are rasterized pixel by pixel
+    static constexpr int gTinyPixels = 16;
+
+    /// \param aTileSize Side of the tiles in pixels, a multiple of gBlockSize.
+    TileRasterizer(int aWidth, int aHeight, int aTileSize = 64);
+
+    /// \brief Clears the target, then rasterizes aTriangleCount triangles.
+    ///
+    /// \param aVertices 3 vertices per triangle, as Vec<2, T_number> or Position<2, T_number>.
+    /// \param aDepths 3 depths per triangle, the depth of each vertex. Smaller depths are closer.
+    /// When several triangles are at the same depth, the first one is kept.
+    template <class T_vertex>
+    void rasterize(const T_vertex * aVertices,
+                   const T_number * aDepths,
+                   std::size_t aTriangleCount,
+                   std::size_t aThreadCount = defaultThreadCount());
+
+    int getWidth() const
+    { return mWidth; }
+
+    int getHeight() const
+    { return mHeight; }
+
+    /// \brief Index of the closest triangle covering the pixel, or gNoTriangle.
+    TriangleIndex getTriangle(int aX, int aY) const
+    { return mTriangles[pixel(aX, aY)]; }
+
+    /// \brief Depth of the closest triangle covering the pixel, infinity if there is none.
+    T_number getDepth(int aX, int aY) const
+    { return mDepths[pixel(aX, aY)]; }
+
+    /// \attention Only meaningful for covered pixels.
+    Coordinates getCoordinates(int aX, int aY) const
+    {
+        const std::size_t index = pixel(aX, aY);
+        return {1 - mBetas[index] - mGammas[index], mBetas[index], mGammas[index]};
+    }
+
+private:
+    enum class Coverage
+    {
+        Outside,
+        Partial,
+        Inside,
+    };
+
+    /// \brief Pixels whose centers are within the bounds of a triangle, clamped to the target.
+    struct PixelRange
+    {
+        // Pixels in [xMin, xMax) x [yMin, yMax)
+        int xMin, yMin, xMax, yMax;
+
+        bool empty() const
+        { return xMin >= xMax || yMin >= yMax; }
+    };
+
+    struct Setup
+    {
+        Barycentric<T_number> barycentric;
+        std::array<T_number, 3> depths;
+        TriangleIndex triangle;
+        PixelRange range;
+    };
+
+    enum class BinKind : std::uint8_t
+    {
+        // The triangle is within the tile, and is set up when rasterizing it
+        Deferred,
+        Partial,
+        // The whole tile is covered, no pixel needs a coverage test
+        Inside,
+    };
+
+    struct BinEntry
+    {
+        // Index of the triangle for Deferred entries, of its setup otherwise
+        std::uint32_t index;
+        BinKind kind;
+    };
+
+    /// \brief Copy of a Deferred triangle, so tiles read their triangles contiguously.
+    struct DeferredTriangle
+    {
+        std::array<Vec<2, T_number>, 3> vertices{
+            Vec<2, T_number>::Zero(), Vec<2, T_number>::Zero(), Vec<2, T_number>::Zero()};
+        std::array<T_number, 3> depths{};
+    };
+
+    std::size_t pixel(int aX, int aY) const
+    {
+        assert(aX >= 0 && aX < mWidth && aY >= 0 && aY < mHeight);
+        return block(aX / gBlockSize, aY / gBlockSize)
+               + static_cast<std::size_t>(aY % gBlockSize) * gBlockSize + aX % gBlockSize;
+    }
+
+    /// \brief Index of the first pixel of the block.
+    std::size_t block(int aBlockColumn, int aBlockRow) const
+    { return (static_cast<std::size_t>(aBlockRow) * mBlockColumns + aBlockColumn) * gBlockPixels; }
+
+    template <class T_vertex>
+    PixelRange getPixelRange(const T_vertex * aVertices) const;
+
+    /// \return Nothing if the triangle is degenerate.
+    template <class T_vertex>
+    static std::optional<Setup> setupTriangle(const T_vertex * aVertices, const T_number * aDepths,
+                                              TriangleIndex aTriangle, const PixelRange & aRange);
+
+    /// \brief Coverage of the pixels in [aXMin, aXMax) x [aYMin, aYMax) (not empty).
+    static Coverage classify(const Barycentric<T_number> & aBarycentric,
+                             int aXMin, int aYMin, int aXMax, int aYMax);
+
+    void rasterizeTile(std::size_t aTile);
+
+    /// \brief Rasterizes the pixels of aSetup within the tile.
+    void rasterizeSetup(const Setup & aSetup, bool aInside,
+                        int aTileXMin, int aTileYMin, int aTileXMax, int aTileYMax);
+
+    /// \brief Rasterizes the pixels in [aXMin, aXMax) x [aYMin, aYMax) one at a time.
+    void rasterizePixels(const Setup & aSetup, int aXMin, int aYMin, int aXMax, int aYMax);
+
+    /// \brief Rasterizes the pixels in [aXMin, aXMax) x [aYMin, aYMax) of the block starting at aBlockX, aBlockY.
+    void rasterizeBlock(const Setup & aSetup, bool aInside, int aBlockX, int aBlockY,
+                        int aXMin, int aYMin, int aXMax, int aYMax);
+
+    int mWidth;
+    int mHeight;
+    int mTileSize;
+    int mTileColumns;
+    int mTileRows;
+    // The target is padded to whole blocks
+    int mBlockColumns;
+    int mBlockRows;
+
+    std::vector<Setup> mSetups;
+    // Bin entries sorted by tile, mTileStarts[tile] being the first entry of tile
+    // (with a last element one past the last entry)
+    std::vector<std::uint32_t> mTileStarts;
+    std::vector<BinEntry> mBinEntries;
+    // Indexed as mBinEntries, only valid for Deferred entries
+    std::vector<DeferredTriangle> mDeferredTriangles;
+
+    std::vector<TriangleIndex> mTriangles;
+    std::vector<T_number> mDepths;
+    std::vector<T_number> mBetas;
+    std::vector<T_number> mGammas;
+};
+
+
+//
+// Implementation
+//
+template <class T_number>
+TileRasterizer<T_number>::TileRasterizer(int aWidth, int aHeight, int aTileSize) :
+    mWidth{aWidth},
+    mHeight{aHeight},
+    mTileSize{aTileSize},
+    mTileColumns{(aWidth + aTileSize - 1) / aTileSize},
+    mTileRows{(aHeight + aTileSize - 1) / aTileSize},
+    mBlockColumns{(aWidth + gBlockSize - 1) / gBlockSize},
+    mBlockRows{(aHeight + gBlockSize - 1) / gBlockSize},
+    mTileStarts(static_cast<std::size_t>(mTileColumns) * mTileRows + 1),
+    mTriangles(static_cast<std::size_t>(mBlockColumns) * mBlockRows * gBlockPixels, gNoTriangle),
+    mDepths(mTriangles.size(), std::numeric_limits<T_number>::infinity()),
+    mBetas(mTriangles.size()),
+    mGammas(mTriangles.size())
+{
+    assert(aWidth > 0 && aHeight > 0);
+    assert(aTileSize > 0 && aTileSize % gBlockSize == 0);
+}
+
+
+template <class T_number>
+auto TileRasterizer<T_number>::classify(const Barycentric<T_number> & aBarycentric,
+                                        int aXMin, int aYMin, int aXMax, int aYMax) -> Coverage
+{
+    // Coordinates are affine, so their extrema over the samples are at the corner samples
+    const T_number half = T_number{1} / 2;
+    const Coordinates first = aBarycentric.getCoordinates({aXMin + half, aYMin + half});
+    const Coordinates stepX = aBarycentric.getStepX(static_cast<T_number>(aXMax - 1 - aXMin));
+    const Coordinates stepY = aBarycentric.getStepY(static_cast<T_number>(aYMax - 1 - aYMin));
+    const std::array<Coordinates, 4> corners{first, first + stepX, first + stepY, first + stepX + stepY};
+
+    Coordinates min = first;
+    Coordinates max = first;
+    for (const Coordinates & corner : corners)
+    {
+        min = {std::min(min.alpha, corner.alpha), std::min(min.beta, corner.beta), std::min(min.gamma, corner.gamma)};
+        max = {std::max(max.alpha, corner.alpha), std::max(max.beta, corner.beta), std::max(max.gamma, corner.gamma)};
+    }
+
+    if (max.alpha < 0 || max.beta < 0 || max.gamma < 0)
+    {
+        return Coverage::Outside;
+    }
+    else if (min.alpha >= 0 && min.beta >= 0 && min.gamma >= 0)
+    {
+        return Coverage::Inside;
+    }
+    return Coverage::Partial;
+}
+
+
+template <class T_number>
+template <class T_vertex>
+auto TileRasterizer<T_number>::getPixelRange(const T_vertex * aVertices) const -> PixelRange
+{
+    const Vec<2, T_number> a = static_cast<Vec<2, T_number>>(aVertices[0]);
+    const Vec<2, T_number> b = static_cast<Vec<2, T_number>>(aVertices[1]);
+    const Vec<2, T_number> c = static_cast<Vec<2, T_number>>(aVertices[2]);
+
+    const T_number half = T_number{1} / 2;
+    auto firstPixel = [half](T_number aMin, int aLimit)
+    {
+        return static_cast<int>(std::clamp<T_number>(std::ceil(aMin - half), 0, aLimit));
+    };
+    auto endPixel = [half](T_number aMax, int aLimit)
+    {
+        return static_cast<int>(std::clamp<T_number>(std::floor(aMax - half) + 1, 0, aLimit));
+    };
+    return PixelRange{
+        firstPixel(std::min({a.x(), b.x(), c.x()}), mWidth),
+        firstPixel(std::min({a.y(), b.y(), c.y()}), mHeight),
+        endPixel(std::max({a.x(), b.x(), c.x()}), mWidth),
+        endPixel(std::max({a.y(), b.y(), c.y()}), mHeight),
+    };
+}
+
+
+template <class T_number>
+template <class T_vertex>
+auto TileRasterizer<T_number>::setupTriangle(const T_vertex * aVertices,
+                                             const T_number * aDepths,
+                                             TriangleIndex aTriangle,
+                                             const PixelRange & aRange) -> std::optional<Setup>
+{
+    const Vec<2, T_number> a = static_cast<Vec<2, T_number>>(aVertices[0]);
+    const Vec<2, T_number> b = static_cast<Vec<2, T_number>>(aVertices[1]);
+    const Vec<2, T_number> c = static_cast<Vec<2, T_number>>(aVertices[2]);
+
+    // Barycentric is undefined for degenerate triangles, which cover no area anyway
+    const Vec<2, T_number> ab = b - a;
+    const Vec<2, T_number> ac = c - a;
+    if (ab.x() * ac.y() - ab.y() * ac.x() == 0)
+    {
+        return std::nullopt;
+    }
+
+    return Setup{
+        Barycentric<T_number>{a, b, c},
+        {aDepths[0], aDepths[1], aDepths[2]},
+        aTriangle,
+        aRange,
+    };
+}
+
+
+template <class T_number>
+template <class T_vertex>
+void TileRasterizer<T_number>::rasterize(const T_vertex * aVertices,
+                                         const T_number * aDepths,
+                                         std::size_t aTriangleCount,
+                                         std::size_t aThreadCount)
+{
+    assert(aTriangleCount < gNoTriangle);
+
+    // Bins each triangle into the tiles it overlaps, then counting sorts the entries by tile,
+    // keeping the submission order within each tile.
+    // Triangles within a single tile are only binned. The others are set up here,
+    // to reject the tiles they do not cover.
+    struct TileEntry
+    {
+        std::uint32_t tile;
+        BinEntry entry;
+    };
+    std::vector<TileEntry> tileEntries;
+    tileEntries.reserve(aTriangleCount);
+    mSetups.clear();
+    std::fill(mTileStarts.begin(), mTileStarts.end(), std::uint32_t{0});
+    for (std::size_t triangle = 0; triangle != aTriangleCount; ++triangle)
+    {
+        const PixelRange range = getPixelRange(aVertices + 3 * triangle);
+        if (range.empty())
+        {
+            continue;
+        }
+
+        const int firstColumn = range.xMin / mTileSize;
+        const int lastColumn = (range.xMax - 1) / mTileSize;
+        const int firstRow = range.yMin / mTileSize;
+        const int lastRow = (range.yMax - 1) / mTileSize;
+        if (firstColumn == lastColumn && firstRow == lastRow)
+        {
+            const std::uint32_t tile = static_cast<std::uint32_t>(firstRow * mTileColumns + firstColumn);
+            tileEntries.push_back({tile, {static_cast<std::uint32_t>(triangle), BinKind::Deferred}});
+            ++mTileStarts[tile + 1];
+            continue;
+        }
+
+        const std::optional<Setup> setup = setupTriangle(aVertices + 3 * triangle, aDepths + 3 * triangle,
+                                                         static_cast<TriangleIndex>(triangle), range);
+        if (!setup)
+        {
+            continue;
+        }
+        const std::uint32_t setupIndex = static_cast<std::uint32_t>(mSetups.size());
+        mSetups.push_back(*setup);
+
+        for (int row = firstRow; row <= lastRow; ++row)
+        {
+            for (int column = firstColumn; column <= lastColumn; ++column)
+            {
+                const int xMin = std::max(column * mTileSize, range.xMin);
+                const int yMin = std::max(row * mTileSize, range.yMin);
+                const int xMax = std::min((column + 1) * mTileSize, range.xMax);
+                const int yMax = std::min((row + 1) * mTileSize, range.yMax);
+                const Coverage coverage = classify(setup->barycentric, xMin, yMin, xMax, yMax);
+                if (coverage != Coverage::Outside)
+                {
+                    const std::uint32_t tile = static_cast<std::uint32_t>(row * mTileColumns + column);
+                    tileEntries.push_back(
+                        {tile, {setupIndex, coverage == Coverage::Inside ? BinKind::Inside : BinKind::Partial}});
+                    ++mTileStarts[tile + 1];
+                }
+            }
+        }
+    }
+    for (std::size_t tile = 1; tile != mTileStarts.size(); ++tile)
+    {
+        mTileStarts[tile] += mTileStarts[tile - 1];
+    }
+    mBinEntries.resize(tileEntries.size());
+    mDeferredTriangles.resize(tileEntries.size());
+    // Each tile start is used as its insertion cursor, leaving it at the start of the next tile
+    for (const TileEntry & tileEntry : tileEntries)
+    {
+        const std::uint32_t position = mTileStarts[tileEntry.tile]++;
+        mBinEntries[position] = tileEntry.entry;
+        if (tileEntry.entry.kind == BinKind::Deferred)
+        {
+            const std::size_t triangle = tileEntry.entry.index;
+            mDeferredTriangles[position] = DeferredTriangle{
+                {
+                    static_cast<Vec<2, T_number>>(aVertices[3 * triangle]),
+                    static_cast<Vec<2, T_number>>(aVertices[3 * triangle + 1]),
+                    static_cast<Vec<2, T_number>>(aVertices[3 * triangle + 2]),
+                },
+                {aDepths[3 * triangle], aDepths[3 * triangle + 1], aDepths[3 * triangle + 2]},
+            };
+        }
+    }
+    std::copy_backward(mTileStarts.begin(), mTileStarts.end() - 1, mTileStarts.end());
+    mTileStarts[0] = 0;
+
+    // Tiles are handed out dynamically, their cost depending on the triangles they hold.
+    // This is the only parallel section, a single thread rasterizes on the calling thread.
+    const std::size_t tileCount = mTileStarts.size() - 1;
+    const std::size_t threadCount = std::max<std::size_t>(1, std::min(aThreadCount, tileCount));
+    std::atomic<std::size_t> next{0};
+    parallelFor(threadCount, threadCount, [&](std::size_t, std::size_t)
+    {
+        for (std::size_t tile = next++; tile < tileCount; tile = next++)
+        {
+            rasterizeTile(tile);
+        }
+    });
+}
+
+
+template <class T_number>
+void TileRasterizer<T_number>::rasterizeTile(std::size_t aTile)
+{
+    const int tileXMin = static_cast<int>(aTile % mTileColumns) * mTileSize;
+    const int tileYMin = static_cast<int>(aTile / mTileColumns) * mTileSize;
+    const int tileXMax = std::min(tileXMin + mTileSize, mWidth);
+    const int tileYMax = std::min(tileYMin + mTileSize, mHeight);
+
+    // Each tile clears its own blocks, while they are brought in cache.
+    // The blocks of a row of the tile are contiguous.
+    const int blockColumnMin = tileXMin / gBlockSize;
+    const int blockColumnMax = (tileXMax + gBlockSize - 1) / gBlockSize;
+    for (int blockRow = tileYMin / gBlockSize; blockRow != (tileYMax + gBlockSize - 1) / gBlockSize; ++blockRow)
+    {
+        const std::size_t first = block(blockColumnMin, blockRow);
+        const std::size_t count = (blockColumnMax - blockColumnMin) * gBlockPixels;
+        std::fill_n(mTriangles.begin() + first, count, gNoTriangle);
+        std::fill_n(mDepths.begin() + first, count, std::numeric_limits<T_number>::infinity());
+    }
+
+    for (std::uint32_t entry = mTileStarts[aTile]; entry != mTileStarts[aTile + 1]; ++entry)
+    {
+        const BinEntry binEntry = mBinEntries[entry];
+        if (binEntry.kind == BinKind::Deferred)
+        {
+            const DeferredTriangle & deferred = mDeferredTriangles[entry];
+            if (const std::optional<Setup> setup = setupTriangle(deferred.vertices.data(), deferred.depths.data(),
+                                                                 binEntry.index,
+                                                                 getPixelRange(deferred.vertices.data())))
+            {
+                rasterizeSetup(*setup, false, tileXMin, tileYMin, tileXMax, tileYMax);
+            }
+        }
+        else
+        {
+            rasterizeSetup(mSetups[binEntry.index], binEntry.kind == BinKind::Inside,
+                           tileXMin, tileYMin, tileXMax, tileYMax);
+        }
+    }
+}
+
+
+template <class T_number>
+void TileRasterizer<T_number>::rasterizeSetup(const Setup & aSetup, bool aInside,
+                                              int aTileXMin, int aTileYMin, int aTileXMax, int aTileYMax)
+{
+    const int xMin = std::max(aTileXMin, aSetup.range.xMin);
+    const int yMin = std::max(aTileYMin, aSetup.range.yMin);
+    const int xMax = std::min(aTileXMax, aSetup.range.xMax);
+    const int yMax = std::min(aTileYMax, aSetup.range.yMax);
+
+    // Tiny triangles do not pay for processing whole blocks
+    if ((xMax - xMin) * (yMax - yMin) <= gTinyPixels)
+    {
+        rasterizePixels(aSetup, xMin, yMin, xMax, yMax);
+        return;
+    }
+
+    // Blocks are aligned on the tile, so at most the first and last of each row and column are partial
+    const int firstBlockX = xMin - (xMin - aTileXMin) % gBlockSize;
+    const int firstBlockY = yMin - (yMin - aTileYMin) % gBlockSize;
+    // Small triangles are tested per pixel directly, classifying their only block would not save work
+    const bool singleBlock = (xMax - firstBlockX <= gBlockSize) && (yMax - firstBlockY <= gBlockSize);
+    for (int blockY = firstBlockY; blockY < yMax; blockY += gBlockSize)
+    {
+        for (int blockX = firstBlockX; blockX < xMax; blockX += gBlockSize)
+        {
+            const int blockXMin = std::max(blockX, xMin);
+            const int blockYMin = std::max(blockY, yMin);
+            const int blockXMax = std::min(blockX + gBlockSize, xMax);
+            const int blockYMax = std::min(blockY + gBlockSize, yMax);
+
+            Coverage coverage = singleBlock ? Coverage::Partial : Coverage::Inside;
+            if (!aInside && !singleBlock)
+            {
+                coverage = classify(aSetup.barycentric, blockXMin, blockYMin, blockXMax, blockYMax);
+            }
+            if (coverage != Coverage::Outside)
+            {
+                rasterizeBlock(aSetup, coverage == Coverage::Inside, blockX, blockY,
+                               blockXMin, blockYMin, blockXMax, blockYMax);
+            }
+        }
+    }
+}
+
+
+template <class T_number>
+void TileRasterizer<T_number>::rasterizePixels(const Setup & aSetup, int aXMin, int aYMin, int aXMax, int aYMax)
+{
+    const T_number half = T_number{1} / 2;
+    for (int y = aYMin; y != aYMax; ++y)
+    {
+        for (int x = aXMin; x != aXMax; ++x)
+        {
+            const Coordinates coordinates = aSetup.barycentric.getCoordinates({x + half, y + half});
+            if (coordinates.alpha >= 0 && coordinates.beta >= 0 && coordinates.gamma >= 0)
+            {
+                const T_number depth = coordinates.alpha * aSetup.depths[0]
+                                       + coordinates.beta * aSetup.depths[1]
+                                       + coordinates.gamma * aSetup.depths[2];
+                const std::size_t index = pixel(x, y);
+                if (depth < mDepths[index])
+                {
+                    mTriangles[index] = aSetup.triangle;
+                    mDepths[index] = depth;
+                    mBetas[index] = coordinates.beta;
+                    mGammas[index] = coordinates.gamma;
+                }
+            }
+        }
+    }
+}
+
+
+namespace detail {
+
+
+    /// \brief Column (or row) of each pixel of a block stored row by row.
+    template <class T_number, int N_side>
+    constexpr std::array<T_number, N_side * N_side> makeBlockOffsets(bool aRows)
+    {
+        std::array<T_number, N_side * N_side> result{};
+        for (int index = 0; index != N_side * N_side; ++index)
+        {
+            result[index] = static_cast<T_number>(aRows ? index / N_side : index % N_side);
+        }
+        return result;
+    }
+
+
+} // namespace detail
+
+
+template <class T_number>
+void TileRasterizer<T_number>::rasterizeBlock(const Setup & aSetup, bool aInside, int aBlockX, int aBlockY,
+                                              int aXMin, int aYMin, int aXMax, int aYMax)
+{
+    static constexpr std::array<T_number, gBlockPixels> columns =
+        detail::makeBlockOffsets<T_number, gBlockSize>(false);
+    static constexpr std::array<T_number, gBlockPixels> rows =
+        detail::makeBlockOffsets<T_number, gBlockSize>(true);
+
+    const T_number half = T_number{1} / 2;
+    // Each pixel is offset from the block origin, so errors do not accumulate
+    const Coordinates origin = aSetup.barycentric.getCoordinates({aBlockX + half, aBlockY + half});
+    const Coordinates stepX = aSetup.barycentric.getStepX(T_number{1});
+    const Coordinates stepY = aSetup.barycentric.getStepY(T_number{1});
+    const T_number depthA = aSetup.depths[0], depthB = aSetup.depths[1], depthC = aSetup.depths[2];
+    const TriangleIndex triangle = aSetup.triangle;
+    // The whole block is processed, masking the pixels out of the range
+    const T_number columnMin = static_cast<T_number>(aXMin - aBlockX);
+    const T_number columnMax = static_cast<T_number>(aXMax - aBlockX);
+    const T_number rowMin = static_cast<T_number>(aYMin - aBlockY);
+    const T_number rowMax = static_cast<T_number>(aYMax - aBlockY);
+
+    // The block is copied to local arrays: the target arrays of the same type may alias each other,
+    // which would prevent vectorization.
+    const std::size_t first = block(aBlockX / gBlockSize, aBlockY / gBlockSize);
+    TriangleIndex triangles[gBlockPixels];
+    T_number depths[gBlockPixels], betas[gBlockPixels], gammas[gBlockPixels];
+    std::copy_n(mTriangles.begin() + first, gBlockPixels, triangles);
+    std::copy_n(mDepths.begin() + first, gBlockPixels, depths);
+    std::copy_n(mBetas.begin() + first, gBlockPixels, betas);
+    std::copy_n(mGammas.begin() + first, gBlockPixels, gammas);
+
+    for (std::size_t index = 0; index != gBlockPixels; ++index)
+    {
+        const T_number beta = origin.beta + columns[index] * stepX.beta + rows[index] * stepY.beta;
+        const T_number gamma = origin.gamma + columns[index] * stepX.gamma + rows[index] * stepY.gamma;
+        const T_number alpha = 1 - beta - gamma;
+        const T_number depth = alpha * depthA + beta * depthB + gamma * depthC;
+
+        // Without branches: the outcome of the depth test is unpredictable in scenes with overdraw
+        const bool inRange = (columns[index] >= columnMin) & (columns[index] < columnMax)
+                             & (rows[index] >= rowMin) & (rows[index] < rowMax);
+        const bool write = inRange
+                           & (aInside | ((alpha >= 0) & (beta >= 0) & (gamma >= 0)))
+                           & (depth < depths[index]);
+        triangles[index] = write ? triangle : triangles[index];
+        depths[index] = detail::select(write, depth, depths[index]);
+        betas[index] = detail::select(write, beta, betas[index]);
+        gammas[index] = detail::select(write, gamma, gammas[index]);
+    }
+
+    std::copy_n(triangles, gBlockPixels, mTriangles.begin() + first);
+    std::copy_n(depths, gBlockPixels, mDepths.begin() + first);
+    std::copy_n(betas, gBlockPixels, mBetas.begin() + first);
+    std::copy_n(gammas, gBlockPixels, mGammas.begin() + first);
+}
+
+
+}} // namespace ad::math
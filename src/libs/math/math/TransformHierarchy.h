@@ -0,0 +1,306 @@
+#pragma once
+
+
+#include "Affine.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace ad {
+namespace math {
+
+
+/// \brief Hierarchy of transformations, only recomputing world transformations below modified nodes.
+///
+/// Nodes are stored in flat arrays, each parent always preceding its children.
+/// The world transformation of a node is `local * parentWorld`, following the row vector convention.
+///
+/// \tparam T_transform Any type providing a static `Identity()` and a composing `operator*`,
+/// such as Affine<3> or Matrix<4, 4>.
+///
+/// \note World transformations are only valid after a call to update().
+template <class T_transform=Affine<3>>
+class TransformHierarchy
+{
+public:
+    using transform_type = T_transform;
+    using NodeIndex = std::size_t;
+
+    static constexpr NodeIndex gNoParent = std::numeric_limits<NodeIndex>::max();
+
+    /// \brief Adds a node, which is dirty until next update.
+    /// \param aParent Must be an existing node, or gNoParent to add a new root.
+    NodeIndex addNode(const T_transform & aLocal, NodeIndex aParent = gNoParent);
+
+    std::size_t size() const
+    { return mParents.size(); }
+
+    NodeIndex getParent(NodeIndex aNode) const
+    { return mParents[aNode]; }
+
+    const T_transform & getLocal(NodeIndex aNode) const
+    { return mLocals[aNode]; }
+
+    const T_transform & getWorld(NodeIndex aNode) const
+    { return mWorlds[aNode]; }
+
+    /// \brief Replaces the local transformation, marking the node (hence its subtree) dirty.
+    void setLocal(NodeIndex aNode, const T_transform & aLocal);
+
+    /// \brief Recomputes the world transformation of dirty nodes and their descendants.
+    void update();
+
+    /// \brief Same as update(), distributing independent subtrees over aThreadCount threads.
+    ///
+    /// The nodes with the largest subtrees are updated first on the calling thread,
+    /// then the subtrees below them are handed out to threads, balanced by their count of nodes to update.
+    /// \note The partition in subtrees is cached until nodes are added or the thread count changes.
+    void update(std::size_t aThreadCount);
+
+private:
+    /// \brief Recomputes aNode if it is dirty, or if its parent was recomputed during this update.
+    void updateNode(NodeIndex aNode, std::uint32_t aGeneration);
+
+    /// \brief Splits the nodes between the top of the hierarchy, and subtrees of at most
+    /// a fraction of the nodes per thread.
+    void partition(std::size_t aThreadCount);
+
+    std::vector<NodeIndex> mParents;
+    std::vector<T_transform> mLocals;
+    std::vector<T_transform> mWorlds;
+    // Not std::vector<bool>, whose elements cannot be written concurrently
+    std::vector<unsigned char> mDirty;
+    // Generation of the last update recomputing the node,
+    // which lets children detect a recomputed parent without clearing flags.
+    std::vector<std::uint32_t> mGenerations;
+    std::uint32_t mGeneration{0};
+
+    // Partition for the parallel update, valid for mPartitionSize nodes and mPartitionThreadCount threads.
+    // Nodes whose subtree is too large to be a single task, in increasing order
+    std::vector<NodeIndex> mTopNodes;
+    // The nodes of each subtree task, in increasing order, the subtrees following each other
+    std::vector<NodeIndex> mTaskNodes;
+    // Offset of each subtree in mTaskNodes, plus the end offset
+    std::vector<std::size_t> mTaskOffsets;
+    std::size_t mPartitionSize{0};
+    std::size_t mPartitionThreadCount{0};
+    // Lower bound on the index of dirty nodes
+    NodeIndex mFirstDirty{0};
+};
+
+
+//
+// Implementation
+//
+template <class T_transform>
+typename TransformHierarchy<T_transform>::NodeIndex
+TransformHierarchy<T_transform>::addNode(const T_transform & aLocal, NodeIndex aParent)
+{
+    assert(aParent == gNoParent || aParent < size());
+
+    const NodeIndex node = size();
+    mParents.push_back(aParent);
+    mLocals.push_back(aLocal);
+    mWorlds.push_back(T_transform::Identity());
+    mDirty.push_back(true);
+    mGenerations.push_back(mGeneration);
+
+    mFirstDirty = std::min(mFirstDirty, node);
+    return node;
+}
+
+
+template <class T_transform>
+void TransformHierarchy<T_transform>::setLocal(NodeIndex aNode, const T_transform & aLocal)
+{
+    mLocals[aNode] = aLocal;
+    mDirty[aNode] = true;
+    mFirstDirty = std::min(mFirstDirty, aNode);
+}
+
+
+template <class T_transform>
+void TransformHierarchy<T_transform>::updateNode(NodeIndex aNode, std::uint32_t aGeneration)
+{
+    const NodeIndex parent = mParents[aNode];
+    if (parent == gNoParent)
+    {
+        if (mDirty[aNode])
+        {
+            mWorlds[aNode] = mLocals[aNode];
+            mGenerations[aNode] = aGeneration;
+        }
+    }
+    else if (mDirty[aNode] || mGenerations[parent] == aGeneration)
+    {
+        mWorlds[aNode] = mLocals[aNode] * mWorlds[parent];
+        mGenerations[aNode] = aGeneration;
+    }
+    mDirty[aNode] = false;
+}
+
+
+template <class T_transform>
+void TransformHierarchy<T_transform>::update()
+{
+    if (mFirstDirty == size())
+    {
+        return;
+    }
+
+    ++mGeneration;
+    // Parents precede their children, so a single forward pass propagates the changes.
+    // Nodes before the first dirty one cannot be affected.
+    for (NodeIndex node = mFirstDirty; node != size(); ++node)
+    {
+        updateNode(node, mGeneration);
+    }
+    mFirstDirty = size();
+}
+
+
+template <class T_transform>
+void TransformHierarchy<T_transform>::partition(std::size_t aThreadCount)
+{
+    // A few tasks per thread, so that they can be balanced
+    const std::size_t cutoff = std::max<std::size_t>(1, size() / (aThreadCount * 8));
+
+    // Parents precede their children, so a backward pass accumulates the subtree sizes
+    std::vector<std::size_t> subtreeSizes(size(), 1);
+    for (NodeIndex node = size(); node-- != 0;)
+    {
+        if (mParents[node] != gNoParent)
+        {
+            subtreeSizes[mParents[node]] += subtreeSizes[node];
+        }
+    }
+
+    // A node below the top starts a new task, unless its parent is already in one
+    constexpr std::size_t noTask = std::numeric_limits<std::size_t>::max();
+    std::vector<std::size_t> tasks(size(), noTask);
+    std::vector<std::size_t> taskSizes;
+    mTopNodes.clear();
+    for (NodeIndex node = 0; node != size(); ++node)
+    {
+        const NodeIndex parent = mParents[node];
+        if (subtreeSizes[node] > cutoff)
+        {
+            mTopNodes.push_back(node);
+        }
+        else if (parent != gNoParent && tasks[parent] != noTask)
+        {
+            tasks[node] = tasks[parent];
+            ++taskSizes[tasks[node]];
+        }
+        else
+        {
+            tasks[node] = taskSizes.size();
+            taskSizes.push_back(1);
+        }
+    }
+
+    mTaskOffsets.assign(1, 0);
+    for (std::size_t taskSize : taskSizes)
+    {
+        mTaskOffsets.push_back(mTaskOffsets.back() + taskSize);
+    }
+    // Filled in increasing node order, so each subtree is sorted
+    std::vector<std::size_t> positions(mTaskOffsets.begin(), mTaskOffsets.end() - 1);
+    mTaskNodes.resize(mTaskOffsets.back());
+    for (NodeIndex node = 0; node != size(); ++node)
+    {
+        if (tasks[node] != noTask)
+        {
+            mTaskNodes[positions[tasks[node]]++] = node;
+        }
+    }
+
+    mPartitionSize = size();
+    mPartitionThreadCount = aThreadCount;
+}
+
+
+template <class T_transform>
+void TransformHierarchy<T_transform>::update(std::size_t aThreadCount)
+{
+    if (mFirstDirty == size())
+    {
+        return;
+    }
+    if (aThreadCount <= 1)
+    {
+        update();
+        return;
+    }
+
+    if (mPartitionSize != size() || mPartitionThreadCount != aThreadCount)
+    {
+        partition(aThreadCount);
+    }
+
+    const std::uint32_t generation = ++mGeneration;
+    const NodeIndex firstDirty = mFirstDirty;
+
+    // The top nodes are ancestors of the subtrees, so they are updated first
+    for (auto nodeIt = std::lower_bound(mTopNodes.begin(), mTopNodes.end(), firstDirty);
+         nodeIt != mTopNodes.end();
+         ++nodeIt)
+    {
+        updateNode(*nodeIt, generation);
+    }
+
+    // Nodes before the first dirty one cannot be affected, the work of a task is its nodes after it
+    const std::size_t taskCount = mTaskOffsets.size() - 1;
+    std::vector<std::size_t> taskBegins(taskCount);
+    std::size_t totalWork = 0;
+    for (std::size_t task = 0; task != taskCount; ++task)
+    {
+        const auto begin = mTaskNodes.begin() + mTaskOffsets[task];
+        const auto end = mTaskNodes.begin() + mTaskOffsets[task + 1];
+        taskBegins[task] = std::lower_bound(begin, end, firstDirty) - mTaskNodes.begin();
+        totalWork += mTaskOffsets[task + 1] - taskBegins[task];
+    }
+
+    // Contiguous ranges of tasks, cut when the accumulated work reaches each thread share
+    std::vector<std::size_t> threadTasks{0};
+    std::size_t work = 0;
+    for (std::size_t task = 0; task != taskCount; ++task)
+    {
+        work += mTaskOffsets[task + 1] - taskBegins[task];
+        if (work * aThreadCount >= totalWork * threadTasks.size() && threadTasks.size() < aThreadCount)
+        {
+            threadTasks.push_back(task + 1);
+        }
+    }
+    threadTasks.push_back(taskCount);
+
+    if (totalWork == 0)
+    {
+        mFirstDirty = size();
+        return;
+    }
+
+    // Subtrees share no node, so each can be traversed independently
+    parallelFor(threadTasks.size() - 1, aThreadCount,
+                [this, generation, &taskBegins, &threadTasks](std::size_t aBegin, std::size_t aEnd)
+    {
+        for (std::size_t task = threadTasks[aBegin]; task != threadTasks[aEnd]; ++task)
+        {
+            for (std::size_t position = taskBegins[task]; position != mTaskOffsets[task + 1]; ++position)
+            {
+                updateNode(mTaskNodes[position], generation);
+            }
+        }
+    });
+    mFirstDirty = size();
+}
+
+
+}} // namespace ad::math
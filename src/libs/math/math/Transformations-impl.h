@@ -273,4 +273,66 @@ namespace trans3d {
     }
 
 
+    template <class T_number>
+    Matrix<4, 4, T_number> lookAt(const Position<3, T_number> aEye,
+                                  const Position<3, T_number> aTarget,
+                                  const Vec<3, T_number> aUp)
+    {
+        // Camera basis: s(ide), u(p), and f(orward), which is -Z in view space
+        Vec<3, T_number> f = (aTarget - aEye).normalize();
+        Vec<3, T_number> s = f.cross(aUp).normalize();
+        const Vec<3, T_number> u = s.cross(f);
+        const Vec<3, T_number> e = static_cast<Vec<3, T_number>>(aEye);
+
+        return {
+               s.x(),       u.x(),      -f.x(),     T_number{0},
+               s.y(),       u.y(),      -f.y(),     T_number{0},
+               s.z(),       u.z(),      -f.z(),     T_number{0},
+            -s.dot(e),   -u.dot(e),    f.dot(e),    T_number{1},
+        };
+    }
+
+
+    template <class T_number, class T_angleUnitTag>
+    constexpr Matrix<4, 4, T_number> perspective(const Angle<T_number, T_angleUnitTag> aVerticalFieldOfView,
+                                                 const T_number aAspectRatio,
+                                                 const T_number aZNear,
+                                                 const T_number aZFar)
+    {
+        // Some compact aliases for parameters
+        const T_number f = 1 / tan(aVerticalFieldOfView / 2);
+        const T_number & n = aZNear;
+        const T_number & F = aZFar;
+
+        return {
+            f / aAspectRatio,    T_number{0},    T_number{0},                T_number{0},
+            T_number{0},         f,              T_number{0},                T_number{0},
+            T_number{0},         T_number{0},    (F + n) / (n - F),          T_number{-1},
+            T_number{0},         T_number{0},    2 * F * n / (n - F),        T_number{0},
+        };
+    }
+
+
+    template <class T_number>
+    constexpr Matrix<4, 4, T_number> orthographic(const T_number aLeft, const T_number aRight,
+                                                  const T_number aBottom, const T_number aTop,
+                                                  const T_number aZNear, const T_number aZFar)
+    {
+        // Some compact aliases for parameters
+        const T_number & l = aLeft;
+        const T_number & r = aRight;
+        const T_number & b = aBottom;
+        const T_number & t = aTop;
+        const T_number & n = aZNear;
+        const T_number & f = aZFar;
+
+        return {
+            2 / (r - l),            T_number{0},            T_number{0},            T_number{0},
+            T_number{0},            2 / (t - b),            T_number{0},            T_number{0},
+            T_number{0},            T_number{0},            -2 / (f - n),           T_number{0},
+            -(r + l) / (r - l),     -(t + b) / (t - b),     -(f + n) / (f - n),     T_number{1},
+        };
+    }
+
+
 } // namespace trans3d
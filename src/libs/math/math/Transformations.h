@@ -135,6 +135,36 @@ namespace trans3d {
                                              const T_number aWeightXonZ);
 
 
+    /*
+     * Camera transformations
+     *
+     * Homogeneous 4x4 matrices, for right-handed view spaces where the camera looks down -Z.
+     * Projections map the view volume onto OpenGL normalized device coordinates,
+     * each coordinate in [-1, 1] after the perspective division.
+     */
+
+    /// \brief View matrix of a camera at aEye, looking at aTarget.
+    /// \param aUp Must not be colinear to the viewing direction.
+    template <class T_number>
+    Matrix<4, 4, T_number> lookAt(const Position<3, T_number> aEye,
+                                  const Position<3, T_number> aTarget,
+                                  const Vec<3, T_number> aUp);
+
+    /// \brief Perspective projection.
+    /// \param aZNear, aZFar Positive distances from the camera to the clipping planes.
+    template <class T_number, class T_angleUnitTag=void>
+    constexpr Matrix<4, 4, T_number> perspective(const Angle<T_number, T_angleUnitTag> aVerticalFieldOfView,
+                                                 const T_number aAspectRatio,
+                                                 const T_number aZNear,
+                                                 const T_number aZFar);
+
+    /// \brief Orthographic projection of the box [aLeft, aRight] x [aBottom, aTop] x [-aZFar, -aZNear].
+    template <class T_number>
+    constexpr Matrix<4, 4, T_number> orthographic(const T_number aLeft, const T_number aRight,
+                                                  const T_number aBottom, const T_number aTop,
+                                                  const T_number aZNear, const T_number aZFar);
+
+
 } // namespace trans3d
 
 
@@ -0,0 +1,342 @@
+#pragma once
+
+
+#include "Angle.h"
+#include "Constants.h"
+#include "Utilities.h"
+
+#include <array>
+#include <limits>
+
+#include <cmath>
+#include <cstdint>
+
+
+namespace ad {
+namespace math {
+
+
+/// \brief Accuracy tiers offered by the batch trigonometric functions.
+///
+/// Range reduction follows a Cody-Waite scheme, so the error grows with the magnitude
+/// of the arguments. Bounds are given for arguments in [-pi, pi].
+enum class TrigonometryAccuracy
+{
+    /// \brief Within 0.5 ulp in single precision, 2.5 ulp in double precision.
+    /// \note Single precision is evaluated in double precision, at half the SIMD width.
+    Precise,
+    /// \brief Within 3 ulp in single precision, absolute error below 1E-7 up to 8192 radians.
+    /// \note Double precision has no cheaper kernel in this tier, it is the same as Precise.
+    Balanced,
+    /// \brief Absolute error below 2E-6 for sin and cos, relative error below 3E-5 for atan.
+    /// Low degree polynomials and a single constant range reduction.
+    Fast,
+};
+
+
+namespace detail {
+
+
+    template <class T_number>
+    struct trigonometry_integer;
+
+    // Integer holding the octant during range reduction.
+    // 32 bits for both, because there is no packed conversion between 64 bits integers
+    // and double before AVX-512. It limits the domain to |x| < 1.6E9, far beyond the range
+    // where Cody-Waite reduction is accurate anyway.
+    template <> struct trigonometry_integer<float> { using type = std::int32_t; };
+    template <> struct trigonometry_integer<double> { using type = std::int32_t; };
+
+    /// \brief Bound on the magnitude of the arguments to sin and cos, so the octant fits its integer.
+    template <class T_number>
+    constexpr T_number gTrigonometryDomain = T_number(1.6E9);
+
+
+    template <class T_number, std::size_t N_coefficients>
+    constexpr T_number horner(const std::array<T_number, N_coefficients> & aCoefficients,
+                              T_number aVariable)
+    {
+        // Coefficients are given in decreasing degree
+        T_number accumulator = aCoefficients[0];
+        for (std::size_t index = 1; index != N_coefficients; ++index)
+        {
+            accumulator = accumulator * aVariable + aCoefficients[index];
+        }
+        return accumulator;
+    }
+
+
+    /// \brief Coefficients from Cephes' sinf, cosf and atanf.
+    struct SingleCoefficients
+    {
+        using number_type = float;
+
+        static constexpr std::array<float, 3> reduction{
+            0.78515625f, 2.4187564849853515625e-4f, 3.77489497744594108e-8f};
+        static constexpr std::array<float, 3> sin{
+            -1.9515295891E-4f, 8.3321608736E-3f, -1.6666654611E-1f};
+        static constexpr std::array<float, 3> cos{
+            2.443315711809948E-5f, -1.388731625493765E-3f, 4.166664568298827E-2f};
+        static constexpr std::array<float, 4> atan{
+            8.05374449538E-2f, -1.38776856032E-1f, 1.99777106478E-1f, -3.33329491539E-1f};
+
+        static constexpr float atanReduced(float aValue, float aSquared)
+        { return aValue + aValue * aSquared * horner(atan, aSquared); }
+    };
+
+
+    /// \brief Coefficients from Cephes' sin, cos and atan.
+    struct DoubleCoefficients
+    {
+        using number_type = double;
+
+        static constexpr std::array<double, 3> reduction{
+            7.85398125648498535156E-1, 3.77489470793079817668E-8, 2.69515142907905952645E-15};
+        static constexpr std::array<double, 6> sin{
+            1.58962301576546568060E-10, -2.50507477628578072866E-8, 2.75573136213857245213E-6,
+            -1.98412698295895385996E-4, 8.33333333332211858878E-3, -1.66666666666666307295E-1};
+        static constexpr std::array<double, 6> cos{
+            -1.13585365213876817300E-11, 2.08757008419747316778E-9, -2.75573141792967388112E-7,
+            2.48015872888517045348E-5, -1.38888888888730564116E-3, 4.16666666666665929218E-2};
+        static constexpr std::array<double, 5> atanNumerator{
+            -8.750608600031904122785E-1, -1.615753718733365076637E1, -7.500855792314704667340E1,
+            -1.228866684490136173410E2, -6.485021904942025371773E1};
+        static constexpr std::array<double, 6> atanDenominator{
+            1.0, 2.485846490142306297962E1, 1.650270098316988542046E2,
+            4.328810604912902668951E2, 4.853903996359136964868E2, 1.945506571482613964425E2};
+
+        static constexpr double atanReduced(double aValue, double aSquared)
+        {
+            return aValue + aValue * aSquared * horner(atanNumerator, aSquared)
+                                              / horner(atanDenominator, aSquared);
+        }
+    };
+
+
+    /// \brief Minimax coefficients of low degree, fitted on the reduced ranges.
+    template <class T_number>
+    struct FastCoefficients
+    {
+        using number_type = T_number;
+
+        static constexpr std::array<T_number, 1> reduction{pi<T_number>/4};
+        static constexpr std::array<T_number, 2> sin{
+            T_number(8.1632819257e-03), T_number(-1.6663390378e-01)};
+        static constexpr std::array<T_number, 2> cos{
+            T_number(-1.3648714342e-03), T_number(4.1661071306e-02)};
+        static constexpr std::array<T_number, 2> atan{
+            T_number(1.7034177711e-01), T_number(-3.3183377504e-01)};
+
+        static constexpr T_number atanReduced(T_number aValue, T_number aSquared)
+        { return aValue + aValue * aSquared * horner(atan, aSquared); }
+    };
+
+
+    /// \brief Branch-free polynomial approximations, so loops calling them can vectorize.
+    ///
+    /// The argument is reduced to [-pi/4, pi/4] by subtracting the closest even multiple
+    /// of pi/4, the bits of this multiple select the polynomial and the sign.
+    template <class T_coefficients>
+    struct PolynomialTrigonometry
+    {
+        using number_type = typename T_coefficients::number_type;
+        using integer_type = typename trigonometry_integer<number_type>::type;
+
+        /// \attention aAbsolute must be in [0, gTrigonometryDomain), the conversion to integer
+        /// is undefined otherwise.
+        static constexpr number_type reduce(number_type aAbsolute, integer_type & aOctant)
+        {
+            aOctant = static_cast<integer_type>(aAbsolute * (4 / pi<number_type>));
+            aOctant = (aOctant + 1) & ~integer_type{1};
+
+            const number_type octant = static_cast<number_type>(aOctant);
+            number_type reduced = aAbsolute;
+            for (number_type part : T_coefficients::reduction)
+            {
+                reduced -= octant * part;
+            }
+            return reduced;
+        }
+
+        static constexpr number_type sinReduced(number_type aValue, number_type aSquared)
+        { return aValue + aValue * aSquared * horner(T_coefficients::sin, aSquared); }
+
+        static constexpr number_type cosReduced(number_type aSquared)
+        {
+            return number_type{1} - aSquared / 2
+                   + aSquared * aSquared * horner(T_coefficients::cos, aSquared);
+        }
+
+        /// \brief Arguments outside of the domain, infinities and NaN included, are reduced from 0
+        /// so the conversion to integer stays defined. Their result is replaced by NaN.
+        static bool isInDomain(number_type aAbsolute)
+        { return aAbsolute < gTrigonometryDomain<number_type>; }
+
+        static number_type sin(number_type aRadians)
+        {
+            const number_type absolute = std::abs(aRadians);
+            const bool inDomain = isInDomain(absolute);
+
+            integer_type octant{0};
+            const number_type reduced = reduce(select(inDomain, absolute, number_type{0}), octant);
+            const number_type squared = reduced * reduced;
+
+            const number_type result = select((octant & 2) != 0,
+                                              cosReduced(squared),
+                                              sinReduced(reduced, squared));
+            const bool negate = ((octant & 4) != 0) != (aRadians < 0);
+            return select(inDomain,
+                          select(negate, -result, result),
+                          std::numeric_limits<number_type>::quiet_NaN());
+        }
+
+        static number_type cos(number_type aRadians)
+        {
+            const number_type absolute = std::abs(aRadians);
+            const bool inDomain = isInDomain(absolute);
+
+            integer_type octant{0};
+            const number_type reduced = reduce(select(inDomain, absolute, number_type{0}), octant);
+            const number_type squared = reduced * reduced;
+
+            const number_type result = select((octant & 2) != 0,
+                                              sinReduced(reduced, squared),
+                                              cosReduced(squared));
+            return select(inDomain,
+                          select(((octant + 2) & 4) != 0, -result, result),
+                          std::numeric_limits<number_type>::quiet_NaN());
+        }
+
+        static number_type atan(number_type aValue)
+        {
+            // tan(3*pi/8) and tan(pi/8)
+            constexpr number_type highThreshold = number_type(2.414213562373095);
+            constexpr number_type middleThreshold = number_type(0.4142135623730950);
+
+            const number_type absolute = std::abs(aValue);
+            const bool high = absolute > highThreshold;
+            const bool middle = !high & (absolute > middleThreshold);
+
+            // Operands are clamped so that each reduction stays finite, whichever is selected
+            const number_type highReduced = number_type{-1} / select(high, absolute, highThreshold);
+            const number_type middleInput = select(high, highThreshold, absolute);
+            const number_type middleReduced = (middleInput - 1) / (middleInput + 1);
+
+            const number_type reduced =
+                select(high, highReduced, select(middle, middleReduced, absolute));
+            const number_type offset =
+                select(high, pi<number_type>/2, select(middle, pi<number_type>/4, number_type{0}));
+
+            const number_type result =
+                offset + T_coefficients::atanReduced(reduced, reduced * reduced);
+            return select(aValue < 0, -result, result);
+        }
+    };
+
+
+    /// \brief Evaluates the double precision kernel and rounds the result.
+    template <class T_kernel>
+    struct PromotedTrigonometry
+    {
+        static float sin(float aRadians)
+        { return static_cast<float>(T_kernel::sin(aRadians)); }
+
+        static float cos(float aRadians)
+        { return static_cast<float>(T_kernel::cos(aRadians)); }
+
+        static float atan(float aValue)
+        { return static_cast<float>(T_kernel::atan(aValue)); }
+    };
+
+
+    template <class T_number, TrigonometryAccuracy N_accuracy>
+    struct TrigonometryKernel;
+
+    template <>
+    struct TrigonometryKernel<double, TrigonometryAccuracy::Precise>
+        : public PolynomialTrigonometry<DoubleCoefficients>
+    {};
+
+    template <>
+    struct TrigonometryKernel<double, TrigonometryAccuracy::Balanced>
+        : public TrigonometryKernel<double, TrigonometryAccuracy::Precise>
+    {};
+
+    template <>
+    struct TrigonometryKernel<double, TrigonometryAccuracy::Fast>
+        : public PolynomialTrigonometry<FastCoefficients<double>>
+    {};
+
+    template <>
+    struct TrigonometryKernel<float, TrigonometryAccuracy::Precise>
+        : public PromotedTrigonometry<TrigonometryKernel<double, TrigonometryAccuracy::Precise>>
+    {};
+
+    template <>
+    struct TrigonometryKernel<float, TrigonometryAccuracy::Balanced>
+        : public PolynomialTrigonometry<SingleCoefficients>
+    {};
+
+    template <>
+    struct TrigonometryKernel<float, TrigonometryAccuracy::Fast>
+        : public PolynomialTrigonometry<FastCoefficients<float>>
+    {};
+
+
+} // namespace detail
+
+
+/***
+ * Batch functions
+ *
+ * Each function reads aCount angles from aAngles, and writes aCount results to aResults.
+ * The arrays must not overlap.
+ ***/
+
+/// \note The domain is limited to angles below 1.6E9 radians in magnitude,
+/// other angles (infinities and NaN included) give NaN.
+template <TrigonometryAccuracy N_accuracy=TrigonometryAccuracy::Precise,
+          class T_representation, class T_unitTag>
+void sin(const Angle<T_representation, T_unitTag> * aAngles,
+         std::size_t aCount,
+         T_representation * aResults)
+{
+    using kernel = detail::TrigonometryKernel<T_representation, N_accuracy>;
+    for (std::size_t index = 0; index != aCount; ++index)
+    {
+        aResults[index] = kernel::sin(Radian<T_representation>{aAngles[index]}.value());
+    }
+}
+
+
+/// \note Same domain as sin().
+template <TrigonometryAccuracy N_accuracy=TrigonometryAccuracy::Precise,
+          class T_representation, class T_unitTag>
+void cos(const Angle<T_representation, T_unitTag> * aAngles,
+         std::size_t aCount,
+         T_representation * aResults)
+{
+    using kernel = detail::TrigonometryKernel<T_representation, N_accuracy>;
+    for (std::size_t index = 0; index != aCount; ++index)
+    {
+        aResults[index] = kernel::cos(Radian<T_representation>{aAngles[index]}.value());
+    }
+}
+
+
+/// \note Follows the scalar atan(Angle), taking the radian value of each angle as argument.
+template <TrigonometryAccuracy N_accuracy=TrigonometryAccuracy::Precise,
+          class T_representation, class T_unitTag>
+void atan(const Angle<T_representation, T_unitTag> * aAngles,
+          std::size_t aCount,
+          T_representation * aResults)
+{
+    using kernel = detail::TrigonometryKernel<T_representation, N_accuracy>;
+    for (std::size_t index = 0; index != aCount; ++index)
+    {
+        aResults[index] = kernel::atan(Radian<T_representation>{aAngles[index]}.value());
+    }
+}
+
+
+}} // namespace ad::math
@@ -2,6 +2,8 @@
 
 
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 
 
 namespace ad {
@@ -16,4 +18,40 @@ bool sameSign(T_number aLeft, T_number aRight)
 }
 
 
+namespace detail {
+
+
+    template <class T_number>
+    struct bits_integer;
+
+    template <> struct bits_integer<float> { using type = std::uint32_t; };
+    template <> struct bits_integer<double> { using type = std::uint64_t; };
+
+
+    /// \brief Returns aTrue if aCondition holds, aFalse otherwise, by masking the bits.
+    ///
+    /// \note The ternary operator is not enough: the compiler sinks the computation of
+    /// each operand into a branch, then refuses to if-convert it under -ftrapping-math,
+    /// which prevents vectorization.
+    template <class T_number>
+    T_number select(bool aCondition, T_number aTrue, T_number aFalse)
+    {
+        using integer_type = typename bits_integer<T_number>::type;
+
+        integer_type trueBits, falseBits;
+        std::memcpy(&trueBits, &aTrue, sizeof(T_number));
+        std::memcpy(&falseBits, &aFalse, sizeof(T_number));
+
+        const integer_type mask = integer_type{0} - static_cast<integer_type>(aCondition);
+        const integer_type resultBits = (trueBits & mask) | (falseBits & ~mask);
+
+        T_number result;
+        std::memcpy(&result, &resultBits, sizeof(T_number));
+        return result;
+    }
+
+
+} // namespace detail
+
+
 }} // namespace ad::math